@@ -0,0 +1,113 @@
+#!/bin/bash
+set -e
+
+# Usage: bench/run_bench.sh [workload...]
+#
+# Measures the throughput of the simulator on synthetic workloads under a few representative configurations. For every
+# workload and configuration, this script reports the throughput in KIPS (thousands of simulated instructions per host
+# second), the peak resident set size of the simulator, and the share of host time spent simulating each component. It
+# must be run from the root of the artifact, plugins being loaded from the prefetchers/, replacements/ and
+# branch_predictors/ directories.
+
+BENCH_BINARY_DIR=${BENCH_BINARY_DIR:-"bin/1_cores_cascade_lake_800mtps"}
+BENCH_TLP_BINARY_DIR=${BENCH_TLP_BINARY_DIR:-"bin/1_cores_cascade_lake_tlp_800mtps"}
+BENCH_4_CORES_BINARY_DIR=${BENCH_4_CORES_BINARY_DIR:-"bin/4_cores_cascade_lake_800mtps"}
+BENCH_GENERATOR=${BENCH_GENERATOR:-"${BENCH_BINARY_DIR}/bench_trace_generator"}
+BENCH_TRACE_DIR=${BENCH_TRACE_DIR:-"bench/traces"}
+BENCH_OUTPUT_DIR=${BENCH_OUTPUT_DIR:-"bench/results"}
+
+BENCH_WARMUP_INSTRUCTIONS=${BENCH_WARMUP_INSTRUCTIONS:-100000}
+BENCH_SIMULATION_INSTRUCTIONS=${BENCH_SIMULATION_INSTRUCTIONS:-500000}
+BENCH_TRACE_INSTRUCTIONS=${BENCH_TRACE_INSTRUCTIONS:-2000000}
+
+# Setting BENCH_PROFILE to 0 skips the profiled runs providing the per-component breakdown.
+BENCH_PROFILE=${BENCH_PROFILE:-1}
+
+WORKLOADS=("$@")
+
+if ((${#WORKLOADS[@]} == 0)); then
+  WORKLOADS=("streaming" "strided" "pointer_chase" "graph_csr" "branchy")
+fi
+
+# Benchmarked configurations, along with the binary simulating them and their number of cores.
+CONFIG_NAMES=("no_prefetch" "ipcp" "berti" "tlp" "4_cores")
+CONFIGS=(
+  "config/baseline_cascade_lake_no_prefetchers.json"
+  "config/baseline_cascade_lake_ipcp.json"
+  "config/baseline_cascade_lake_berti.json"
+  "config/baseline_cascade_lake_ipcp_tlp_layered_core_l1d_f20_-25.json"
+  "config/baseline_cascade_lake_4_cores_berti.json"
+)
+BINARIES=(
+  "${BENCH_BINARY_DIR}"
+  "${BENCH_BINARY_DIR}"
+  "${BENCH_BINARY_DIR}"
+  "${BENCH_TLP_BINARY_DIR}"
+  "${BENCH_4_CORES_BINARY_DIR}"
+)
+CORES=(1 1 1 1 4)
+
+COMPONENTS=("core" "itlb" "dtlb" "stlb" "l1i" "l1d" "l2c" "sdc" "llc" "dram" "other")
+
+# Generating the traces that are missing.
+mkdir -p ${BENCH_TRACE_DIR} ${BENCH_OUTPUT_DIR}
+
+for workload in ${WORKLOADS[@]}; do
+  trace="${BENCH_TRACE_DIR}/bench_${workload}.xz"
+
+  if [ ! -f ${trace} ]; then
+    ${BENCH_GENERATOR} --workload=${workload} --instructions=${BENCH_TRACE_INSTRUCTIONS} --out_trace=${trace}
+  fi
+done
+
+# The simulator writes memory traces in the directory given by the configurations.
+for config in ${CONFIGS[@]}; do
+  mkdir -p $(grep -o '"memory_trace_directory": *"[^"]*"' ${config} | cut -d '"' -f 4)
+done
+
+# Prints the value following a label in the host statistics of a simulation output.
+host_stat() {
+  grep -m 1 "$1" $2 | sed -e "s/.*$1 \([0-9.]*\).*/\1/"
+}
+
+header="$(printf "%-14s %-12s %10s %10s" "Workload" "Config" "KIPS" "RSS (MB)")"
+
+if ((BENCH_PROFILE)); then
+  for component in ${COMPONENTS[@]}; do
+    header="${header} $(printf "%6s" ${component})"
+  done
+fi
+
+echo "${header}"
+
+for ((i = 0; i < ${#CONFIGS[@]}; i++)); do
+  binary="${BINARIES[$i]}/champsim_simulator"
+
+  if [ ! -x ${binary} ]; then
+    echo "Skipping ${CONFIG_NAMES[$i]}: ${binary} not found." >&2
+    continue
+  fi
+
+  for workload in ${WORKLOADS[@]}; do
+    # Multi-core configurations run one copy of the workload per core.
+    traces=$(for ((j = 0; j < ${CORES[$i]}; j++)); do echo -n "${BENCH_TRACE_DIR}/bench_${workload}.xz "; done)
+    output="${BENCH_OUTPUT_DIR}/${CONFIG_NAMES[$i]}-${workload}.txt"
+    profile="${BENCH_OUTPUT_DIR}/${CONFIG_NAMES[$i]}-${workload}.profile.txt"
+
+    LD_LIBRARY_PATH=${BINARIES[$i]} ${binary} --config=${CONFIGS[$i]} --warmup_instructions=${BENCH_WARMUP_INSTRUCTIONS} --simulation_instructions=${BENCH_SIMULATION_INSTRUCTIONS} --host_stats --traces ${traces} > ${output}
+
+    line="$(printf "%-14s %-12s %10s %10s" ${workload} ${CONFIG_NAMES[$i]} $(host_stat "KIPS:" ${output}) $(host_stat "Peak RSS:" ${output}))"
+
+    # Timing components slows the simulation down, so the breakdown comes from a separate run.
+    if ((BENCH_PROFILE)); then
+      LD_LIBRARY_PATH=${BINARIES[$i]} ${binary} --config=${CONFIGS[$i]} --warmup_instructions=${BENCH_WARMUP_INSTRUCTIONS} --simulation_instructions=${BENCH_SIMULATION_INSTRUCTIONS} --host_profile --traces ${traces} > ${profile}
+
+      for component in ${COMPONENTS[@]}; do
+        share=$(grep -m 1 "Host time ${component}:" ${profile} | sed -e "s/.*(\([0-9.]*\)%)/\1/")
+        line="${line} $(printf "%5s%%" ${share})"
+      done
+    fi
+
+    echo "${line}"
+  done
+done
@@ -0,0 +1,132 @@
+#!/bin/bash
+set -e
+
+# Usage: bench/run_dram_timing.sh
+#
+# Checks the detailed DRAM timing mode against the analytical ceilings of its constraints. Each check runs a synthetic
+# workload on a single channel and rank with one constraint tightened until it is the bottleneck, all the others being
+# zeroed, and compares the measured rate with the range expected from the constraint:
+# - a rank activates at most once per tRRD (tRRD_L within a bank group, tRRD_S across bank groups) and four times per
+#   tFAW, which bounds the row buffer misses of the activate-bound random_access workload,
+# - a rank issues at most one column command per tCCD (tCCD_L within a bank group, tCCD_S across bank groups), which
+#   bounds the bandwidth of the streaming workload,
+# - each sub-channel has a data bus of width/subchannels, which bounds its bandwidth on the bus-bound streaming workload,
+# - a rank is not scheduled for tRFC every tREFI, which costs the bus-bound streaming workload at most tRFC/tREFI of its
+#   bandwidth, the transfers already scheduled being allowed to complete meanwhile.
+# The workloads demand more than these ceilings, so the measured rates are expected to reach at least 90% of them. The
+# first check makes sure that the detailed mode with every constraint zeroed reproduces the default timing model. This
+# script must be run from the root of the artifact, plugins being loaded from the prefetchers/, replacements/ and
+# branch_predictors/ directories.
+
+BENCH_BINARY_DIR=${BENCH_BINARY_DIR:-"bin/1_cores_cascade_lake_800mtps"}
+BENCH_GENERATOR=${BENCH_GENERATOR:-"${BENCH_BINARY_DIR}/bench_trace_generator"}
+BENCH_TRACE_DIR=${BENCH_TRACE_DIR:-"bench/traces"}
+BENCH_OUTPUT_DIR=${BENCH_OUTPUT_DIR:-"bench/results"}
+BENCH_BASE_CONFIG=${BENCH_BASE_CONFIG:-"config/baseline_cascade_lake_no_prefetchers.json"}
+
+BENCH_WARMUP_INSTRUCTIONS=${BENCH_WARMUP_INSTRUCTIONS:-50000}
+BENCH_SIMULATION_INSTRUCTIONS=${BENCH_SIMULATION_INSTRUCTIONS:-200000}
+BENCH_TRACE_INSTRUCTIONS=${BENCH_TRACE_INSTRUCTIONS:-1000000}
+
+# Frequency of the simulated cores in MHz (CPU_FREQ), converting the cycles of the simulation to nanoseconds.
+BENCH_CPU_FREQ=${BENCH_CPU_FREQ:-3800}
+
+# Single channel and rank, refreshes left out unless checked.
+BASE="\"channels\": 1, \"ranks\": 1, \"detailed_timing\": true"
+NO_REFRESH="\"tRFC\": 0, \"tREFI\": 1000000"
+NO_ACT="\"tRRD_S\": 0, \"tRRD_L\": 0, \"tFAW\": 0"
+NO_CCD="\"tCCD_S\": 0, \"tCCD_L\": 0"
+
+# Checks, along with their workload, the keys of the dram section, the measured metric (row buffer misses per
+# microsecond, bandwidth in GB/s of all the channels or of the busiest one) and its expected range.
+CHECK_NAMES=("tRRD_L" "tRRD_S" "tFAW" "tCCD_L" "tCCD_S" "subchannels_2" "subchannels_4" "refresh")
+CHECK_WORKLOADS=("random_access" "random_access" "random_access" "streaming" "streaming" "streaming" "streaming"
+  "streaming")
+CHECK_KEYS=(
+  "${BASE}, ${NO_REFRESH}, ${NO_CCD}, \"bank_groups\": 1, \"tRRD_S\": 0, \"tRRD_L\": 150, \"tFAW\": 0"
+  "${BASE}, ${NO_REFRESH}, ${NO_CCD}, \"bank_groups\": 8, \"tRRD_S\": 150, \"tRRD_L\": 300, \"tFAW\": 0"
+  "${BASE}, ${NO_REFRESH}, ${NO_CCD}, \"bank_groups\": 1, \"tRRD_S\": 0, \"tRRD_L\": 0, \"tFAW\": 600"
+  "${BASE}, ${NO_REFRESH}, ${NO_ACT}, \"io_frequency\": 3200, \"bank_groups\": 1, \"tCCD_S\": 0, \"tCCD_L\": 20"
+  "${BASE}, ${NO_REFRESH}, ${NO_ACT}, \"io_frequency\": 3200, \"bank_groups\": 8, \"tCCD_S\": 20, \"tCCD_L\": 40"
+  "${BASE}, ${NO_REFRESH}, ${NO_ACT}, ${NO_CCD}, \"io_frequency\": 800, \"subchannels\": 2"
+  "${BASE}, ${NO_REFRESH}, ${NO_ACT}, ${NO_CCD}, \"io_frequency\": 800, \"subchannels\": 4"
+  "${BASE}, ${NO_ACT}, ${NO_CCD}, \"io_frequency\": 800, \"tRFC\": 350, \"tREFI\": 7800"
+)
+CHECK_METRICS=("activates_per_us" "activates_per_us" "activates_per_us" "total_GBps" "total_GBps" "channel_GBps"
+  "channel_GBps" "total_GBps")
+# Ceilings: 1 / tRRD, 4 / tFAW, 64B / tCCD, (8B / subchannels) * 800 MT/s and 8B * 800 MT/s.
+CHECK_MAX=("6.667" "6.667" "6.667" "3.200" "3.200" "3.200" "1.600" "6.400")
+# tRRD_S and tCCD_S must beat the ceilings of their _L counterparts, refresh must cost at most tRFC / tREFI.
+CHECK_MIN=("6.000" "3.333" "6.000" "2.880" "1.600" "2.880" "1.440" "6.113")
+
+# Generating the traces that are missing.
+mkdir -p ${BENCH_TRACE_DIR} ${BENCH_OUTPUT_DIR} $(grep -o '"memory_trace_directory": *"[^"]*"' ${BENCH_BASE_CONFIG} | cut -d '"' -f 4)
+
+for workload in random_access streaming; do
+  trace="${BENCH_TRACE_DIR}/bench_${workload}.xz"
+
+  if [ ! -f ${trace} ]; then
+    ${BENCH_GENERATOR} --workload=${workload} --instructions=${BENCH_TRACE_INSTRUCTIONS} --out_trace=${trace}
+  fi
+done
+
+# Runs a workload with extra keys in the dram section of the base configuration.
+simulate() {
+  local name=$1 workload=$2 keys=$3
+
+  sed -e "s|\"dram\": *{|\"dram\": { ${keys},|" ${BENCH_BASE_CONFIG} > ${BENCH_OUTPUT_DIR}/dram-${name}.json
+
+  LD_LIBRARY_PATH=${BENCH_BINARY_DIR} ${BENCH_BINARY_DIR}/champsim_simulator --config=${BENCH_OUTPUT_DIR}/dram-${name}.json --warmup_instructions=${BENCH_WARMUP_INSTRUCTIONS} --simulation_instructions=${BENCH_SIMULATION_INSTRUCTIONS} --traces ${BENCH_TRACE_DIR}/bench_${workload}.xz > ${BENCH_OUTPUT_DIR}/dram-${name}.txt
+}
+
+# Prints a metric of a simulation output: row buffer misses per microsecond, or the bandwidth in GB/s of all the
+# channels or of the busiest one.
+measure() {
+  awk -v metric=$1 -v freq=${BENCH_CPU_FREQ} '
+    /cumulative IPC/ { for (i = 1; i < NF; i++) if ($i == "cycles:") ns = $(i + 1) * 1000 / freq }
+    /^ CHANNEL/ { channel = $2 }
+    /ROW_BUFFER_HIT:/ { requests[channel] += $3 + $5; activates += $5 }
+    END {
+      for (c in requests) { total += requests[c]; if (requests[c] > busiest) busiest = requests[c] }
+      if (metric == "activates_per_us") printf "%.3f", activates * 1000 / ns
+      else if (metric == "total_GBps") printf "%.3f", total * 64 / ns
+      else printf "%.3f", busiest * 64 / ns
+    }' $2
+}
+
+failures=0
+
+# The detailed mode without any constraint must be cycle-exact with the default timing model.
+simulate "default" "streaming" "\"channels\": 1, \"ranks\": 1"
+simulate "zeroed" "streaming" "${BASE}, ${NO_REFRESH}, ${NO_ACT}, ${NO_CCD}"
+
+default_cycles=$(grep -m 1 "cumulative IPC" ${BENCH_OUTPUT_DIR}/dram-default.txt)
+zeroed_cycles=$(grep -m 1 "cumulative IPC" ${BENCH_OUTPUT_DIR}/dram-zeroed.txt)
+
+if [ "${default_cycles}" == "${zeroed_cycles}" ]; then
+  echo "zeroed constraints: same cycles as the default timing model, PASS"
+else
+  echo "zeroed constraints: cycles differ from the default timing model, FAIL"
+  failures=$((failures + 1))
+fi
+
+printf "%-14s %-14s %-18s %20s %10s %6s\n" "Check" "Workload" "Metric" "Expected" "Measured" "Result"
+
+for ((i = 0; i < ${#CHECK_NAMES[@]}; i++)); do
+  simulate ${CHECK_NAMES[$i]} ${CHECK_WORKLOADS[$i]} "${CHECK_KEYS[$i]}"
+
+  measured=$(measure ${CHECK_METRICS[$i]} ${BENCH_OUTPUT_DIR}/dram-${CHECK_NAMES[$i]}.txt)
+
+  # Leaving 1% of slack for the rounding of the timings to cycles.
+  if awk -v m=${measured} -v lo=${CHECK_MIN[$i]} -v hi=${CHECK_MAX[$i]} 'BEGIN { exit !(m >= lo && m <= hi * 1.01) }'; then
+    result="PASS"
+  else
+    result="FAIL"
+    failures=$((failures + 1))
+  fi
+
+  printf "%-14s %-14s %-18s %20s %10s %6s\n" ${CHECK_NAMES[$i]} ${CHECK_WORKLOADS[$i]} ${CHECK_METRICS[$i]} \
+    "[${CHECK_MIN[$i]}, ${CHECK_MAX[$i]}]" ${measured} ${result}
+done
+
+exit $((failures != 0))
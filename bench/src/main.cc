@@ -0,0 +1,86 @@
+#include <cstdio>
+#
+#include <iostream>
+#include <map>
+#include <string>
+#
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <boost/filesystem.hpp>
+#
+#include "trace_writer.hh"
+#include "workloads.hh"
+
+namespace po = boost::program_options;
+using boost::format;
+
+using workload_generator = void (*) (trace_writer&, const workload_params&);
+
+static po::options_description prog_opt;
+static std::string workload, out_trace;
+static workload_params params;
+
+static const std::map<std::string, workload_generator> workloads = {
+	{ "streaming", generate_streaming },
+	{ "strided", generate_strided },
+	{ "pointer_chase", generate_pointer_chase },
+	{ "random_access", generate_random_access },
+	{ "graph_csr", generate_graph_csr },
+	{ "branchy", generate_branchy },
+};
+
+void initialize_program_options (po::options_description& desc) {
+	desc.add_options ()
+		("help", "Produce an help message and quit.")
+		("workload", po::value<std::string> (&workload), "The synthetic workload to generate (streaming, strided, pointer_chase, random_access, graph_csr or branchy).")
+		("out_trace", po::value<std::string> (&out_trace), "The output trace (.xz) to be used by the simulator.")
+		("instructions", po::value<uint64_t> (&params.instructions)->default_value (10000000), "The number of instructions to generate.")
+		("seed", po::value<uint64_t> (&params.seed)->default_value (0), "The seed of the random number generators.")
+		("stride", po::value<uint64_t> (&params.stride)->default_value (256), "The stride (in bytes) of the strided workload.")
+		("graph_scale", po::value<uint32_t> (&params.graph_scale)->default_value (18), "The graph of the graph_csr workload has 2^graph_scale vertices.")
+		("graph_degree", po::value<uint32_t> (&params.graph_degree)->default_value (16), "The average degree of the graph of the graph_csr workload.");
+}
+
+void parse_program_options (const po::options_description& desc, int argc, const char** argv) {
+	po::variables_map vm;
+
+	po::store (po::parse_command_line (argc, argv, desc), vm);
+	po::notify (vm);
+
+	if (vm.count ("help")) {
+		std::cout << desc << std::endl;
+		std::exit (0);
+	}
+
+	if (!vm.count ("workload") || !workloads.count (workload)) {
+		throw std::runtime_error ("[ERROR] No valid workload provided.");
+	}
+
+	if (!vm.count ("out_trace")) {
+		throw std::runtime_error ("[ERROR] No output trace provided.");
+	}
+
+	if (boost::filesystem::path (out_trace).extension () != ".xz") {
+		throw std::runtime_error ("[ERROR] The trace generator only supports .xz trace files.");
+	}
+}
+
+int main (int argc, const char** argv) {
+	// Initializing program opptions descriptor.
+	initialize_program_options (prog_opt);
+
+	try {
+		parse_program_options (prog_opt, argc, argv);
+
+		trace_writer w (out_trace);
+
+		workloads.at (workload) (w, params);
+
+		std::cout << format ("Wrote %1d instructions of the %2s workload to %3s.") % w.written () % workload % out_trace << std::endl;
+	} catch (const std::runtime_error& e) {
+		std::cerr << e.what () << std::endl;
+		std::exit (1);
+	}
+
+	return 0;
+}
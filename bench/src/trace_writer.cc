@@ -0,0 +1,104 @@
+#include <stdexcept>
+#
+#include <boost/format.hpp>
+#
+#include "trace_writer.hh"
+
+using boost::format;
+
+trace_writer::trace_writer (const std::string& trace_path) : _written (0) {
+	std::string cmd = (format ("xz -1 -T0 -c > %1s") % trace_path).str ();
+
+	if ((this->_trace_file = popen (cmd.c_str (), "w")) == NULL) {
+		throw std::runtime_error ("[ERROR] Unexpected error on trace opening.");
+	}
+
+#if !defined(LEGACY_TRACE)
+	// Synthetic traces do not describe any irregular array.
+	std::size_t pairs = 0;
+
+	fwrite (reinterpret_cast<const char*> (&pairs), sizeof (std::size_t), 1, this->_trace_file);
+#endif // !defined(LEGACY_TRACE)
+}
+
+trace_writer::~trace_writer () {
+	pclose (this->_trace_file);
+}
+
+void trace_writer::alu (uint64_t ip, uint8_t dst, uint8_t src_1, uint8_t src_2) {
+	bench_instruction instr {};
+
+	instr.ip = ip;
+	instr.destination_registers[0] = dst;
+	instr.source_registers[0] = src_1;
+	instr.source_registers[1] = src_2;
+
+	this->_write (instr);
+}
+
+void trace_writer::compare (uint64_t ip, uint8_t src_1, uint8_t src_2) {
+	this->alu (ip, REG_FLAGS, src_1, src_2);
+}
+
+void trace_writer::load (uint64_t ip, uint8_t dst, uint8_t addr_reg, uint64_t vaddr) {
+	bench_instruction instr {};
+
+	instr.ip = ip;
+	instr.destination_registers[0] = dst;
+	instr.source_registers[0] = addr_reg;
+	instr.source_memory[0] = vaddr;
+
+#if !defined(LEGACY_TRACE)
+	instr.source_memory_size[0] = 8;
+#endif // !defined(LEGACY_TRACE)
+
+	this->_write (instr);
+}
+
+void trace_writer::store (uint64_t ip, uint8_t data_reg, uint8_t addr_reg, uint64_t vaddr) {
+	bench_instruction instr {};
+
+	instr.ip = ip;
+	instr.source_registers[0] = data_reg;
+	instr.source_registers[1] = addr_reg;
+	instr.destination_memory[0] = vaddr;
+
+#if !defined(LEGACY_TRACE)
+	instr.destination_memory_size[0] = 8;
+#endif // !defined(LEGACY_TRACE)
+
+	this->_write (instr);
+}
+
+/**
+ * @brief Writes a conditional branch, which the simulator recognizes as such
+ * because it reads the flags and the instruction pointer and writes the latter.
+ */
+void trace_writer::branch (uint64_t ip, bool taken) {
+	bench_instruction instr {};
+
+	instr.ip = ip;
+	instr.is_branch = true;
+	instr.branch_taken = taken;
+	instr.destination_registers[0] = REG_INSTRUCTION_POINTER;
+	instr.source_registers[0] = REG_FLAGS;
+	instr.source_registers[1] = REG_INSTRUCTION_POINTER;
+
+	this->_write (instr);
+}
+
+uint64_t trace_writer::written () const {
+	return this->_written;
+}
+
+void trace_writer::_write (bench_instruction& instr) {
+#if !defined(LEGACY_TRACE)
+	instr.instruction_size = 4;
+#endif // !defined(LEGACY_TRACE)
+
+	if (fwrite (reinterpret_cast<const char*> (&instr), sizeof (bench_instruction), 1, this->_trace_file) != 1) {
+		throw std::runtime_error ("[ERROR] An error occured while writing the trace.");
+	}
+
+	this->_written++;
+}
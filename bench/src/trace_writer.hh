@@ -0,0 +1,46 @@
+#ifndef __CHAMPSIM_BENCH_TRACE_WRITER_HH__
+#define __CHAMPSIM_BENCH_TRACE_WRITER_HH__
+
+#include <cstdint>
+#include <cstdio>
+#
+#include <iostream>
+#include <string>
+#
+#include <internals/instruction.h>
+
+#if defined(LEGACY_TRACE)
+using bench_instruction = input_instr;
+#else
+using bench_instruction = champsim::cpu::x86_trace_instruction;
+#endif // defined(LEGACY_TRACE)
+
+/**
+ * @brief Writes synthetic instructions to a compressed trace, in the format
+ * expected by the simulator it is built with (legacy or extended).
+ */
+class trace_writer {
+private:
+	FILE* _trace_file;
+	uint64_t _written;
+
+public:
+	trace_writer (const std::string& trace_path);
+	~trace_writer ();
+
+	trace_writer (const trace_writer&) = delete;
+	trace_writer& operator= (const trace_writer&) = delete;
+
+	void alu (uint64_t ip, uint8_t dst, uint8_t src_1, uint8_t src_2);
+	void compare (uint64_t ip, uint8_t src_1, uint8_t src_2);
+	void load (uint64_t ip, uint8_t dst, uint8_t addr_reg, uint64_t vaddr);
+	void store (uint64_t ip, uint8_t data_reg, uint8_t addr_reg, uint64_t vaddr);
+	void branch (uint64_t ip, bool taken);
+
+	uint64_t written () const;
+
+private:
+	void _write (bench_instruction& instr);
+};
+
+#endif // __CHAMPSIM_BENCH_TRACE_WRITER_HH__
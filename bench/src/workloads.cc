@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+#
+#include <plugins/replacements/llc_topt/benchmark.h>
+#
+#include "workloads.hh"
+
+// Base addresses of the code and of the data structures used by the workloads.
+static constexpr uint64_t code_base = 0x400000ULL;
+static constexpr uint64_t array_a_base = 0x10000000000ULL;
+static constexpr uint64_t array_b_base = 0x20000000000ULL;
+static constexpr uint64_t array_c_base = 0x30000000000ULL;
+static constexpr uint64_t stack_base = 0x7fff00000000ULL;
+
+// Size of the arrays walked by the streaming and strided workloads.
+static constexpr uint64_t array_size = 1ULL << 30;
+
+/**
+ * @brief Program counter of the idx-th instruction of a code region.
+ */
+static uint64_t pc (uint64_t region, uint64_t idx) {
+	return code_base + (region << 16) + idx * 4;
+}
+
+/**
+ * @brief Graph options handed over to the builder of llc_topt, without going
+ * through the command line.
+ */
+class graph_cli : public CLBase {
+public:
+	graph_cli (int scale, int degree) : CLBase ("") {
+		this->scale_ = scale;
+		this->degree_ = degree;
+		this->symmetrize_ = true;
+	}
+};
+
+void generate_streaming (trace_writer& w, const workload_params& p) {
+	for (uint64_t i = 0; w.written () < p.instructions; i++) {
+		uint64_t offset = (i * 8) % array_size;
+
+		w.load (pc (0, 0), 2, 1, array_a_base + offset);
+		w.alu (pc (0, 1), 3, 3, 2);
+		w.store (pc (0, 2), 3, 1, array_b_base + offset);
+		w.alu (pc (0, 3), 1, 1, 0);
+		w.compare (pc (0, 4), 1, 4);
+		w.branch (pc (0, 5), ((i + 1) % 1024) != 0);
+	}
+}
+
+void generate_strided (trace_writer& w, const workload_params& p) {
+	// The second stream crosses a page on every access.
+	uint64_t page_stride = 4096 + 64;
+
+	for (uint64_t i = 0; w.written () < p.instructions; i++) {
+		w.load (pc (1, 0), 2, 1, array_a_base + (i * p.stride) % array_size);
+		w.load (pc (1, 1), 3, 4, array_b_base + (i * page_stride) % array_size);
+		w.alu (pc (1, 2), 5, 2, 3);
+		w.alu (pc (1, 3), 1, 1, 0);
+		w.alu (pc (1, 4), 4, 4, 0);
+		w.compare (pc (1, 5), 1, 7);
+		w.branch (pc (1, 6), ((i + 1) % 256) != 0);
+	}
+}
+
+void generate_pointer_chase (trace_writer& w, const workload_params& p) {
+	// 64-byte nodes linked in a single random cycle over 64MB.
+	const uint64_t nodes = 1ULL << 20, node_size = 64;
+	std::vector<uint32_t> order (nodes), next (nodes);
+	std::mt19937_64 rng (p.seed);
+
+	std::iota (order.begin (), order.end (), 0);
+	std::shuffle (order.begin (), order.end (), rng);
+
+	for (uint64_t i = 0; i < nodes; i++) {
+		next[order[i]] = order[(i + 1) % nodes];
+	}
+
+	for (uint64_t curr = order[0]; w.written () < p.instructions; curr = next[curr]) {
+		uint64_t addr = array_c_base + curr * node_size;
+
+		// The address of the next node depends on the previous load.
+		w.load (pc (2, 0), 2, 1, addr + 8);
+		w.alu (pc (2, 1), 3, 3, 2);
+		w.load (pc (2, 2), 1, 1, addr);
+		w.compare (pc (2, 3), 1, 0);
+		w.branch (pc (2, 4), true);
+	}
+}
+
+void generate_random_access (trace_writer& w, const workload_params& p) {
+	std::mt19937_64 rng (p.seed);
+	std::uniform_int_distribution<uint64_t> pick (0, array_size / 64 - 1);
+
+	for (uint64_t i = 0; w.written () < p.instructions; i++) {
+		// The loads only depend on the loop counter, so that they can all be in flight.
+		w.load (pc (8, 0), 2, 1, array_a_base + pick (rng) * 64);
+		w.alu (pc (8, 1), 3, 3, 2);
+		w.alu (pc (8, 2), 1, 1, 0);
+		w.compare (pc (8, 3), 1, 4);
+		w.branch (pc (8, 4), ((i + 1) % 1024) != 0);
+	}
+}
+
+void generate_graph_csr (trace_writer& w, const workload_params& p) {
+	graph_cli cli (p.graph_scale, p.graph_degree);
+	Builder b (cli);
+	Graph g = b.MakeGraph ();
+	const uint64_t offsets_base = array_a_base,
+		neighbors_base = array_b_base,
+		scores_base = array_c_base,
+		new_scores_base = array_c_base + (1ULL << 32);
+
+	while (w.written () < p.instructions) {
+		for (NodeID u = 0; u < g.num_nodes () && w.written () < p.instructions; u++) {
+			w.load (pc (3, 0), 1, 0, offsets_base + u * 8);
+			w.load (pc (3, 1), 2, 0, offsets_base + (u + 1) * 8);
+
+			for (NodeID* it = g.out_neigh (u).begin (); it != g.out_neigh (u).end (); it++) {
+				uint64_t e = it - g.begin_node ();
+
+				// Loading the neighbor, then its score (the irregular access).
+				w.load (pc (3, 2), 3, 1, neighbors_base + e * sizeof (NodeID));
+				w.load (pc (3, 3), 4, 3, scores_base + *it * 8);
+				w.alu (pc (3, 4), 5, 5, 4);
+				w.alu (pc (3, 5), 1, 1, 0);
+				w.compare (pc (3, 6), 1, 2);
+				w.branch (pc (3, 7), (it + 1) != g.out_neigh (u).end ());
+			}
+
+			w.store (pc (3, 8), 5, 0, new_scores_base + u * 8);
+			w.compare (pc (3, 9), 0, 6);
+			w.branch (pc (3, 10), true);
+		}
+	}
+}
+
+void generate_branchy (trace_writer& w, const workload_params& p) {
+	// 4096 static branches spread over 256KB of code, with various behaviors.
+	const uint64_t branches = 4096, block_size = 16;
+	std::mt19937_64 rng (p.seed);
+	std::uniform_int_distribution<uint64_t> pick (0, branches - 1);
+	std::bernoulli_distribution coin (0.5), biased (0.9);
+	std::vector<uint64_t> executions (branches, 0);
+
+	while (w.written () < p.instructions) {
+		uint64_t br = pick (rng), count = executions[br]++;
+		uint64_t block = code_base + (4ULL << 16) + br * block_size * 4;
+		bool taken;
+
+		// A few ALU operations and a stack access feeding the comparison.
+		w.alu (block, 2, 2, 3);
+		w.alu (block + 4, 3, 2, 4);
+		w.load (block + 8, 4, REG_STACK_POINTER, stack_base + (br % 64) * 8);
+		w.alu (block + 12, 5, 4, 3);
+		w.compare (block + 16, 5, 2);
+
+		switch (br % 4) {
+			case 0: taken = coin (rng); break;
+			case 1: taken = biased (rng); break;
+			case 2: taken = (count % 7) != 0; break;
+			default: taken = ((count / 3) % 2) == 0; break;
+		}
+
+		w.branch (block + 20, taken);
+	}
+}
@@ -0,0 +1,33 @@
+#ifndef __CHAMPSIM_BENCH_WORKLOADS_HH__
+#define __CHAMPSIM_BENCH_WORKLOADS_HH__
+
+#include <cstdint>
+#
+#include <string>
+
+#include "trace_writer.hh"
+
+/**
+ * @brief Knobs shared by the synthetic workloads.
+ */
+struct workload_params {
+	uint64_t instructions;
+	uint64_t seed;
+	uint64_t stride;
+	uint32_t graph_scale, graph_degree;
+};
+
+// Sequential loads and stores over two large arrays.
+void generate_streaming (trace_writer& w, const workload_params& p);
+// Loads at a constant stride from a large array, plus a page-crossing stream.
+void generate_strided (trace_writer& w, const workload_params& p);
+// Serialized loads following a random linked list spanning a large region.
+void generate_pointer_chase (trace_writer& w, const workload_params& p);
+// Independent loads to random blocks of a large array, opening a DRAM row on nearly every access.
+void generate_random_access (trace_writer& w, const workload_params& p);
+// Pull-based PageRank iterations over a synthetic Kronecker graph in CSR form.
+void generate_graph_csr (trace_writer& w, const workload_params& p);
+// Compute-bound code with many hard-to-predict branches and a large code footprint.
+void generate_branchy (trace_writer& w, const workload_params& p);
+
+#endif // __CHAMPSIM_BENCH_WORKLOADS_HH__
@@ -0,0 +1,38 @@
+# Profile-guided optimization of the simulator and its plugins. The build first runs with CHAMPSIM_PGO=GENERATE to get
+# an instrumented simulator, which is then trained on a few traces (see scripts/pgo_build.sh), and finally rebuilt with
+# CHAMPSIM_PGO=USE. With GCC, profiles are matched against object files, so both builds must share the same build tree.
+set(CHAMPSIM_PGO "OFF" CACHE STRING "Profile-guided optimization stage (OFF, GENERATE or USE).")
+set_property(CACHE CHAMPSIM_PGO PROPERTY STRINGS OFF GENERATE USE)
+set(CHAMPSIM_PGO_PROFILE_DIRECTORY "${CMAKE_BINARY_DIR}/pgo_profiles" CACHE PATH "Directory where profiles are written to and read from.")
+
+if (NOT ${CHAMPSIM_PGO} MATCHES "^(OFF|GENERATE|USE)$")
+  message (FATAL_ERROR "The profile-guided optimization stage provided is not valid.")
+endif ()
+
+if (NOT ${CHAMPSIM_PGO} STREQUAL "OFF")
+  if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+    set(CHAMPSIM_PGO_GENERATE_FLAGS "-fprofile-generate=${CHAMPSIM_PGO_PROFILE_DIRECTORY}")
+    set(CHAMPSIM_PGO_USE_FLAGS "-fprofile-use=${CHAMPSIM_PGO_PROFILE_DIRECTORY} -fprofile-correction -Wno-missing-profile")
+  elseif (CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    # Raw profiles have to be merged with llvm-profdata before being used.
+    set(CHAMPSIM_PGO_GENERATE_FLAGS "-fprofile-generate=${CHAMPSIM_PGO_PROFILE_DIRECTORY}")
+    set(CHAMPSIM_PGO_USE_FLAGS "-fprofile-use=${CHAMPSIM_PGO_PROFILE_DIRECTORY}/champsim.profdata -Wno-profile-instr-unprofiled")
+  else ()
+    message (FATAL_ERROR "Profile-guided optimization is not supported with ${CMAKE_CXX_COMPILER_ID}.")
+  endif ()
+
+  if (${CHAMPSIM_PGO} STREQUAL "GENERATE")
+    set(CHAMPSIM_PGO_FLAGS ${CHAMPSIM_PGO_GENERATE_FLAGS})
+  else ()
+    if (NOT EXISTS ${CHAMPSIM_PGO_PROFILE_DIRECTORY})
+      message (FATAL_ERROR "No profile found in ${CHAMPSIM_PGO_PROFILE_DIRECTORY}, the instrumented simulator must be trained first.")
+    endif ()
+
+    set(CHAMPSIM_PGO_FLAGS ${CHAMPSIM_PGO_USE_FLAGS})
+  endif ()
+
+  set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} ${CHAMPSIM_PGO_FLAGS}")
+  set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${CHAMPSIM_PGO_FLAGS}")
+  set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} ${CHAMPSIM_PGO_FLAGS}")
+  set(CMAKE_SHARED_LINKER_FLAGS "${CMAKE_SHARED_LINKER_FLAGS} ${CHAMPSIM_PGO_FLAGS}")
+endif ()
@@ -0,0 +1,100 @@
+#!/bin/bash
+set -e
+
+# Usage: scripts/compare_kips.sh <reference binary directory> <candidate binary directory> <config> <trace>...
+#
+# Runs both simulators on each trace and reports their throughput in KIPS (thousands of simulated instructions per second
+# of host time), taking the median of REPEAT runs. Both simulators must produce the same IPC, any mismatch is
+# reported. Each simulator runs from its own working directory and loads the plugins found next to it, in the
+# prefetchers, replacements and branch_predictors subdirectories of its binary directory (see pgo_build.sh).
+
+if (($# < 4)); then
+  echo "Usage: $0 <reference binary directory> <candidate binary directory> <config> <trace>..." >&2
+  exit 1
+fi
+
+REFERENCE_DIR=$(realpath $1)
+CANDIDATE_DIR=$(realpath $2)
+CONFIG=$(realpath $3)
+shift 3
+
+ROOT_DIR=$(pwd)
+PLUGIN_DIRS="prefetchers replacements branch_predictors"
+
+WARMUP_INSTRUCTIONS=${WARMUP_INSTRUCTIONS:-1000000}
+SIMULATION_INSTRUCTIONS=${SIMULATION_INSTRUCTIONS:-10000000}
+REPEAT=${REPEAT:-3}
+
+OUTPUT_FILE=$(mktemp)
+WORK_DIR=$(mktemp -d)
+trap "rm -rf ${OUTPUT_FILE} ${WORK_DIR}" EXIT
+
+# Preparing a working directory per simulator, pointing at its own plugins.
+for binary_dir in ${REFERENCE_DIR} ${CANDIDATE_DIR}; do
+  run_dir=${WORK_DIR}/$(echo ${binary_dir} | md5sum | cut -c 1-16)
+
+  mkdir -p ${run_dir}
+  ln -sfn ${ROOT_DIR}/config ${run_dir}/config
+
+  for plugin_dir in ${PLUGIN_DIRS}; do
+    if [ ! -d ${binary_dir}/${plugin_dir} ]; then
+      echo "${binary_dir} has no ${plugin_dir} directory, the plugins built with the simulator must be copied there." >&2
+      exit 1
+    fi
+
+    ln -sfn ${binary_dir}/${plugin_dir} ${run_dir}/${plugin_dir}
+  done
+done
+
+# Runs one simulator on one trace and prints its throughput (in KIPS) followed by the IPC of the simulation.
+run_simulator() {
+  binary_dir=$1
+  trace=$(realpath $2)
+  run_dir=${WORK_DIR}/$(echo ${binary_dir} | md5sum | cut -c 1-16)
+  instructions=$((WARMUP_INSTRUCTIONS + SIMULATION_INSTRUCTIONS))
+
+  start=$(date +%s%N)
+  (cd ${run_dir} && LD_LIBRARY_PATH=${binary_dir} ${binary_dir}/champsim_simulator --config=${CONFIG} --warmup_instructions=${WARMUP_INSTRUCTIONS} --simulation_instructions=${SIMULATION_INSTRUCTIONS} --traces=${trace} > ${OUTPUT_FILE} 2> /dev/null)
+  end=$(date +%s%N)
+
+  ipc=$(grep -m 1 "cumulative IPC" ${OUTPUT_FILE} | awk '{ print $5 }')
+  awk -v n=${instructions} -v ns=$((end - start)) -v ipc=${ipc} 'BEGIN { printf "%.2f %s\n", n / (ns / 1e6), ipc }'
+}
+
+# Prints the median of the values read on the standard input.
+median() {
+  sort -g | awk '{ v[NR] = $1 } END { print (NR % 2) ? v[(NR + 1) / 2] : (v[NR / 2] + v[NR / 2 + 1]) / 2 }'
+}
+
+printf "%-40s %12s %12s %9s\n" "Trace" "Ref. KIPS" "Cand. KIPS" "Speedup"
+
+total_reference=0
+total_candidate=0
+
+for trace in "$@"; do
+  reference_runs=()
+  candidate_runs=()
+
+  # Interleaving runs so that both simulators see the same host noise.
+  for ((i = 0; i < REPEAT; i++)); do
+    read reference_kips reference_ipc <<< $(run_simulator ${REFERENCE_DIR} ${trace})
+    read candidate_kips candidate_ipc <<< $(run_simulator ${CANDIDATE_DIR} ${trace})
+
+    reference_runs+=(${reference_kips})
+    candidate_runs+=(${candidate_kips})
+
+    if [ "${reference_ipc}" != "${candidate_ipc}" ]; then
+      echo "Warning: IPC mismatch on $(basename ${trace}) (${reference_ipc} vs. ${candidate_ipc})." >&2
+    fi
+  done
+
+  reference_kips=$(printf "%s\n" ${reference_runs[@]} | median)
+  candidate_kips=$(printf "%s\n" ${candidate_runs[@]} | median)
+
+  total_reference=$(awk -v a=${total_reference} -v b=${reference_kips} 'BEGIN { print a + b }')
+  total_candidate=$(awk -v a=${total_candidate} -v b=${candidate_kips} 'BEGIN { print a + b }')
+
+  awk -v t=$(basename ${trace}) -v r=${reference_kips} -v c=${candidate_kips} 'BEGIN { printf "%-40s %12.2f %12.2f %8.3fx\n", t, r, c, c / r }'
+done
+
+awk -v r=${total_reference} -v c=${total_candidate} -v n=$# 'BEGIN { printf "%-40s %12.2f %12.2f %8.3fx\n", "Average", r / n, c / n, c / r }'
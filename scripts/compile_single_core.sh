@@ -1,38 +1,45 @@
 #!/bin/bash
 set -e
 
-# Compiling the baseline (legacy & extended formats).
-mkdir -p build/1_cores_cascade_lake_800mtps_legacy
-mkdir -p build/1_cores_cascade_lake_800mtps
+# Compiling one version of the simulator in build/<name> and bin/<name>. When training traces are provided, the simulator
+# is then rebuilt with profile-guided optimization (see pgo_build.sh). PGO_TRAINING_TRACES lists traces in the extended
+# format and PGO_LEGACY_TRAINING_TRACES lists traces in the legacy ChampSim format.
+compile_simulator() {
+  name=$1
+  shift
 
-cd build/1_cores_cascade_lake_800mtps_legacy
-cmake -G "Unix Makefiles" ../../ -DCMAKE_BUILD_TYPE=Release -DSIMULATOR_OUTPUT_DIRECTORY="1_cores_cascade_lake_800mtps_legacy" -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=ON -DENABLE_FSP=OFF -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=OFF -DENABLE_SSP=OFF && make
-cd ../1_cores_cascade_lake_800mtps
-cmake -G "Unix Makefiles" ../../ -DCMAKE_BUILD_TYPE=Release -DSIMULATOR_OUTPUT_DIRECTORY="1_cores_cascade_lake_800mtps" -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=OFF -DENABLE_FSP=OFF -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=OFF -DENABLE_SSP=OFF && make
-cd ../../
+  mkdir -p build/${name}
 
-# Compiling Hermes (legacy & extended formats).
-mkdir -p build/1_cores_cascade_lake_hermes_o_800mtps_legacy
-mkdir -p build/1_cores_cascade_lake_hermes_o_800mtps
+  cd build/${name}
+  cmake -G "Unix Makefiles" ../../ -DCMAKE_BUILD_TYPE=Release -DSIMULATOR_OUTPUT_DIRECTORY="${name}" "$@" -DCHAMPSIM_PGO=OFF && make
+  cd ../../
 
-cd build/1_cores_cascade_lake_hermes_o_800mtps_legacy
-cmake -G "Unix Makefiles" ../../ -DCMAKE_BUILD_TYPE=Release -DSIMULATOR_OUTPUT_DIRECTORY="1_cores_cascade_lake_hermes_o_800mtps_legacy" -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=ON -DENABLE_FSP=ON -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=OFF -DENABLE_SSP=OFF && make
-cd ../1_cores_cascade_lake_hermes_o_800mtps
-cmake -G "Unix Makefiles" ../../ -DCMAKE_BUILD_TYPE=Release -DSIMULATOR_OUTPUT_DIRECTORY="1_cores_cascade_lake_hermes_o_800mtps" -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=OFF -DENABLE_FSP=ON -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=OFF -DENABLE_SSP=OFF && make
-cd ../../
+  traces=${PGO_TRAINING_TRACES}
 
-# Compiling TLP (legacy & extended formats).
-mkdir -p build/1_cores_cascade_lake_tlp_800mtps_legacy
-mkdir -p build/1_cores_cascade_lake_tlp_800mtps
+  if [[ " $* " == *" -DLEGACY_TRACE=ON "* ]]; then
+    traces=${PGO_LEGACY_TRAINING_TRACES}
+  fi
 
-cd build/1_cores_cascade_lake_tlp_800mtps_legacy
-cmake -G "Unix Makefiles" ../../ -DCMAKE_BUILD_TYPE=Release -DSIMULATOR_OUTPUT_DIRECTORY="1_cores_cascade_lake_tlp_800mtps_legacy" -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=ON -DENABLE_FSP=ON -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=ON -DENABLE_SSP=ON && make
-cd ../1_cores_cascade_lake_tlp_800mtps
-cmake -G "Unix Makefiles" ../../ -DCMAKE_BUILD_TYPE=Release -DSIMULATOR_OUTPUT_DIRECTORY="1_cores_cascade_lake_tlp_800mtps" -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=OFF -DENABLE_FSP=ON -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=ON -DENABLE_SSP=ON && make
-cd ../../
+  if [ -n "${traces}" ]; then
+    PGO_TRAINING_TRACES="${traces}" scripts/pgo_build.sh ${name} "$@"
+  fi
+}
+
+# Compiling the baseline (legacy & extended formats).
+compile_simulator 1_cores_cascade_lake_800mtps_legacy -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=ON -DENABLE_FSP=OFF -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=OFF -DENABLE_SSP=OFF
+compile_simulator 1_cores_cascade_lake_800mtps -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=OFF -DENABLE_FSP=OFF -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=OFF -DENABLE_SSP=OFF
+
+# Compiling Hermes (legacy & extended formats).
+compile_simulator 1_cores_cascade_lake_hermes_o_800mtps_legacy -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=ON -DENABLE_FSP=ON -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=OFF -DENABLE_SSP=OFF
+compile_simulator 1_cores_cascade_lake_hermes_o_800mtps -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=OFF -DENABLE_FSP=ON -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=OFF -DENABLE_SSP=OFF
+
+# Compiling TLP (legacy & extended formats).
+compile_simulator 1_cores_cascade_lake_tlp_800mtps_legacy -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=ON -DENABLE_FSP=ON -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=ON -DENABLE_SSP=ON
+compile_simulator 1_cores_cascade_lake_tlp_800mtps -DCHAMPSIM_CPU_NUMBER_CORE=1 -DCHAMPSIM_CPU_DRAM_IO_FREQUENCY=800 -DLEGACY_TRACE=OFF -DENABLE_FSP=ON -DENABLE_DELAYED_FSP=OFF -DENABLE_BIMODAL_FSP=ON -DENABLE_SSP=ON
 
-# Copying prefetchers and replacement policies plugins.
+# Copying prefetchers, replacement policies and branch predictors plugins.
 cp bin/prefetchers/* prefetchers/
 cp bin/replacements/* replacements/
+cp bin/branch_predictors/* branch_predictors/
 
 cp prefetchers/libl1d_ipcp.so prefetchers/libl1d_ipcp_iso.so
@@ -0,0 +1,81 @@
+#!/bin/bash
+set -e
+
+# Usage: scripts/pgo_build.sh <simulator output directory> [CMake variables...]
+#
+# Builds bin/<simulator output directory> with profile-guided optimization. The simulator is first built with
+# instrumentation in build/<simulator output directory>, trained on the traces listed in PGO_TRAINING_TRACES, and finally
+# rebuilt in the same build directory using the collected profiles. The binaries found in bin/<simulator output directory>
+# before the instrumented build are kept under bin/<simulator output directory>_reference, so that the gain can be
+# measured with scripts/compare_kips.sh. Both directories get a copy of the plugins they were built with, as the shared
+# plugin directories of bin/ are overwritten by the optimized build.
+
+if (($# < 1)); then
+  echo "Usage: $0 <simulator output directory> [CMake variables...]" >&2
+  exit 1
+fi
+
+if [ -z "${PGO_TRAINING_TRACES}" ]; then
+  echo "PGO_TRAINING_TRACES must list the traces used to train the simulator." >&2
+  exit 1
+fi
+
+NAME=$1
+shift
+
+PGO_TRAINING_CONFIG=${PGO_TRAINING_CONFIG:-"config/baseline_cascade_lake_berti_spp_ppf.json"}
+PGO_WARMUP_INSTRUCTIONS=${PGO_WARMUP_INSTRUCTIONS:-1000000}
+PGO_SIMULATION_INSTRUCTIONS=${PGO_SIMULATION_INSTRUCTIONS:-5000000}
+
+ROOT_DIR=$(pwd)
+BUILD_DIR="${ROOT_DIR}/build/${NAME}"
+PROFILE_DIR="${BUILD_DIR}/pgo_profiles"
+
+# Keeping the regular binaries around as a reference.
+if [ -f bin/${NAME}/champsim_simulator ]; then
+  rm -rf bin/${NAME}_reference
+  cp -r bin/${NAME} bin/${NAME}_reference
+
+  for plugin_dir in prefetchers replacements branch_predictors; do
+    rm -rf bin/${NAME}_reference/${plugin_dir}
+    cp -r bin/${plugin_dir} bin/${NAME}_reference/${plugin_dir}
+  done
+fi
+
+# Building the instrumented simulator.
+mkdir -p ${BUILD_DIR}
+rm -rf ${PROFILE_DIR}
+
+cd ${BUILD_DIR}
+cmake -G "Unix Makefiles" ${ROOT_DIR} -DCMAKE_BUILD_TYPE=Release -DSIMULATOR_OUTPUT_DIRECTORY="${NAME}" "$@" -DCHAMPSIM_PGO=GENERATE -DCHAMPSIM_PGO_PROFILE_DIRECTORY="${PROFILE_DIR}" && make
+cd ${ROOT_DIR}
+
+# Training the simulator, plugins are loaded from the working directory.
+cp bin/prefetchers/* prefetchers/
+cp bin/replacements/* replacements/
+cp bin/branch_predictors/* branch_predictors/
+
+for trace in ${PGO_TRAINING_TRACES}; do
+  echo "Training on ${trace}..."
+  bin/${NAME}/champsim_simulator --config=${PGO_TRAINING_CONFIG} --warmup_instructions=${PGO_WARMUP_INSTRUCTIONS} --simulation_instructions=${PGO_SIMULATION_INSTRUCTIONS} --traces=${trace} > /dev/null
+done
+
+# Clang writes raw profiles that need to be merged first.
+if ls ${PROFILE_DIR}/*.profraw > /dev/null 2>&1; then
+  ${LLVM_PROFDATA:-llvm-profdata} merge -output=${PROFILE_DIR}/champsim.profdata ${PROFILE_DIR}/*.profraw
+fi
+
+# Building the optimized simulator.
+cd ${BUILD_DIR}
+cmake -G "Unix Makefiles" ${ROOT_DIR} -DCHAMPSIM_PGO=USE && make
+cd ${ROOT_DIR}
+
+# Replacing the instrumented plugins used for training, and keeping the optimized ones next to the simulator.
+cp bin/prefetchers/* prefetchers/
+cp bin/replacements/* replacements/
+cp bin/branch_predictors/* branch_predictors/
+
+for plugin_dir in prefetchers replacements branch_predictors; do
+  rm -rf bin/${NAME}/${plugin_dir}
+  cp -r bin/${plugin_dir} bin/${NAME}/${plugin_dir}
+done
@@ -5,7 +5,7 @@
 #define MAX_COUNTER 3
 int bimodal_table[NUM_CPUS][BIMODAL_TABLE_SIZE];
 
-void O3_CPU::initialize_branch_predictor()
+void O3_CPU::builtin_initialize_branch_predictor()
 {
     cout << "CPU " << cpu << " Bimodal branch predictor" << endl;
 
@@ -13,7 +13,7 @@ void O3_CPU::initialize_branch_predictor()
         bimodal_table[cpu][i] = 0;
 }
 
-uint8_t O3_CPU::predict_branch(uint64_t ip)
+uint8_t O3_CPU::builtin_predict_branch(uint64_t ip)
 {
     uint32_t hash = ip % BIMODAL_PRIME;
     uint8_t prediction = (bimodal_table[cpu][hash] >= ((MAX_COUNTER + 1)/2)) ? 1 : 0;
@@ -21,7 +21,7 @@ uint8_t O3_CPU::predict_branch(uint64_t ip)
     return prediction;
 }
 
-void O3_CPU::last_branch_result(uint64_t ip, uint8_t taken)
+void O3_CPU::builtin_last_branch_result(uint64_t ip, uint8_t taken)
 {
     uint32_t hash = ip % BIMODAL_PRIME;
 
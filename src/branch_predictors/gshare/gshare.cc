@@ -8,7 +8,7 @@ int branch_history_vector[NUM_CPUS];
 int gs_history_table[NUM_CPUS][GS_HISTORY_TABLE_SIZE];
 int my_last_prediction[NUM_CPUS];
 
-void O3_CPU::initialize_branch_predictor()
+void O3_CPU::builtin_initialize_branch_predictor()
 {
     cout << "CPU " << cpu << " GSHARE branch predictor" << endl;
 
@@ -29,7 +29,7 @@ unsigned int gs_table_hash(uint64_t ip, int bh_vector)
     return hash;
 }
 
-uint8_t O3_CPU::predict_branch(uint64_t ip)
+uint8_t O3_CPU::builtin_predict_branch(uint64_t ip)
 {
     int prediction = 1;
 
@@ -45,7 +45,7 @@ uint8_t O3_CPU::predict_branch(uint64_t ip)
     return prediction;
 }
 
-void O3_CPU::last_branch_result(uint64_t ip, uint8_t taken)
+void O3_CPU::builtin_last_branch_result(uint64_t ip, uint8_t taken)
 {
     int gs_hash = gs_table_hash(ip, branch_history_vector[cpu]);
 
@@ -105,7 +105,7 @@ int
 // perceptron sum
 	yout[NUM_CPUS];
 
-void O3_CPU::initialize_branch_predictor () {
+void O3_CPU::builtin_initialize_branch_predictor() {
 	// zero out the weights tables
 
 	memset (tables, 0, sizeof (tables));
@@ -119,7 +119,7 @@ void O3_CPU::initialize_branch_predictor () {
 	for (int i=0; i<NUM_CPUS; i++) theta[i] = 10;
 }
 
-uint8_t O3_CPU::predict_branch(uint64_t pc) {
+uint8_t O3_CPU::builtin_predict_branch(uint64_t pc) {
 
 	// initialize perceptron sum
 
@@ -173,7 +173,7 @@ uint8_t O3_CPU::predict_branch(uint64_t pc) {
 	return yout[cpu] >= 1;
 }
 
-void O3_CPU::last_branch_result(uint64_t pc, uint8_t taken) {
+void O3_CPU::builtin_last_branch_result(uint64_t pc, uint8_t taken) {
 
 	// was this prediction correct?
 
@@ -158,7 +158,7 @@ void initialize_perceptron (perceptron *p) {
     for (i=0; i<=PERCEPTRON_HISTORY; i++) p->weights[i] = 0;
 }
 
-void O3_CPU::initialize_branch_predictor()
+void O3_CPU::builtin_initialize_branch_predictor()
 {
     spec_global_history[cpu] = 0;
     global_history[cpu] = 0;
@@ -167,7 +167,7 @@ void O3_CPU::initialize_branch_predictor()
         initialize_perceptron (&perceptrons[cpu][i]);
 }
 
-uint8_t O3_CPU::predict_branch(uint64_t ip)
+uint8_t O3_CPU::builtin_predict_branch(uint64_t ip)
 {
     uint64_t address = ip;
 
@@ -234,7 +234,7 @@ uint8_t O3_CPU::predict_branch(uint64_t ip)
     return u[cpu]->prediction;
 }
 
-void O3_CPU::last_branch_result(uint64_t ip, uint8_t taken)
+void O3_CPU::builtin_last_branch_result(uint64_t ip, uint8_t taken)
 {
     int	
         i,
@@ -1,4 +1,5 @@
 #include <stdexcept>
+#include <utility>
 #
 #include "block.h"
 #
@@ -339,6 +340,38 @@ void PACKET_QUEUE::remove_queue(PACKET *packet) {
     if (head >= SIZE) head = 0;
 }
 
+void PACKET_QUEUE::swap(PACKET_QUEUE &o) noexcept {
+    std::swap(this->NAME, o.NAME);
+    std::swap(this->SIZE, o.SIZE);
+
+    std::swap(this->is_RQ, o.is_RQ);
+    std::swap(this->is_WQ, o.is_WQ);
+    std::swap(this->write_mode, o.write_mode);
+
+    std::swap(this->cpu, o.cpu);
+    std::swap(this->head, o.head);
+    std::swap(this->tail, o.tail);
+    std::swap(this->occupancy, o.occupancy);
+    std::swap(this->num_returned, o.num_returned);
+    std::swap(this->next_fill_index, o.next_fill_index);
+    std::swap(this->next_schedule_index, o.next_schedule_index);
+    std::swap(this->next_process_index, o.next_process_index);
+
+    std::swap(this->next_fill_cycle, o.next_fill_cycle);
+    std::swap(this->next_schedule_cycle, o.next_schedule_cycle);
+    std::swap(this->next_process_cycle, o.next_process_cycle);
+    std::swap(this->ACCESS, o.ACCESS);
+    std::swap(this->FORWARD, o.FORWARD);
+    std::swap(this->MERGED, o.MERGED);
+    std::swap(this->TO_CACHE, o.TO_CACHE);
+    std::swap(this->ROW_BUFFER_HIT, o.ROW_BUFFER_HIT);
+    std::swap(this->ROW_BUFFER_MISS, o.ROW_BUFFER_MISS);
+    std::swap(this->FULL, o.FULL);
+
+    std::swap(this->entry, o.entry);
+    std::swap(this->processed_packet, o.processed_packet);
+}
+
 void PACKET_QUEUE::retire_element(PACKET_QUEUE::iterator it) {
     // First, we fill the packet by copying a clean instance.
     *it = PACKET();
@@ -23,7 +23,7 @@ class perceptron_feature;
 class BLOCK {
    public:
     bool pte_used = false, filled_from_write_allocate = false,
-         went_offchip_pred = false;
+         went_offchip_pred = false, pf_cross_page = false;
 
     uint8_t valid, prefetch, dirty, used;
 
@@ -78,7 +78,7 @@ class PACKET {
         sniffer = false, bypassed_l2c_llc = false, metadata_insertion = false,
         metadata_eviction = false, went_offchip_pred = false,
         l1d_offchip_pred_used = false, pf_went_offchip_pred = false,
-        pf_went_offchip = false;
+        pf_went_offchip = false, pf_cross_page = false;
 
     uint8_t instruction, is_data, is_metadata, fill_l1i, fill_l1d, tlb_access,
         scheduled, translated, fetched, prefetched, drc_tag_read;
@@ -87,6 +87,11 @@ class PACKET {
         depth, signature, confidence;
 
     uint32_t pf_metadata;
+
+    // component of a composite prefetcher that issued the request, zero for
+    // other prefetchers
+    uint32_t pf_component;
+
     uint8_t locmap_data[BLOCK_SIZE];
 
     uint8_t is_producer,
@@ -146,6 +151,7 @@ class PACKET {
         depth = 0;
         signature = 0;
         confidence = 0;
+        pf_component = 0;
 
 #if 0
 		for (uint32_t i=0; i<ROB_SIZE; i++) {
@@ -213,7 +219,7 @@ class PACKET_QUEUE {
     uint64_t next_fill_cycle, next_schedule_cycle, next_process_cycle, ACCESS,
         FORWARD, MERGED, TO_CACHE, ROW_BUFFER_HIT, ROW_BUFFER_MISS, FULL;
 
-    pointer entry, processed_packet[2 * MAX_READ_PER_CYCLE];
+    pointer entry = nullptr, processed_packet[2 * MAX_READ_PER_CYCLE] = {};
 
     // constructor
     PACKET_QUEUE(string v1, uint32_t v2) : NAME(v1), SIZE(v2) {
@@ -246,8 +252,11 @@ class PACKET_QUEUE {
     };
 
     PACKET_QUEUE() {
+        SIZE = 0;
+
         is_RQ = 0;
         is_WQ = 0;
+        write_mode = 0;
 
         cpu = 0;
         head = 0;
@@ -273,9 +282,22 @@ class PACKET_QUEUE {
         // entry = new PACKET[SIZE];
     };
 
+    // The queue owns its entries: it can be moved, e.g. when a vector of
+    // queues grows, but not copied.
+    PACKET_QUEUE(const PACKET_QUEUE &o) = delete;
+    PACKET_QUEUE(PACKET_QUEUE &&o) noexcept : PACKET_QUEUE() { swap(o); }
+
+    PACKET_QUEUE &operator=(const PACKET_QUEUE &o) = delete;
+    PACKET_QUEUE &operator=(PACKET_QUEUE &&o) noexcept {
+        swap(o);
+        return *this;
+    }
+
     // destructor
     ~PACKET_QUEUE() { delete[] entry; };
 
+    void swap(PACKET_QUEUE &o) noexcept;
+
     // functions
     int check_queue(const PACKET *packet);
 
@@ -0,0 +1,121 @@
+#ifndef __CHAMPSIM_INTERNALS_BRANCH_PREDICTORS_IBRANCHPREDICTOR_HH__
+#define __CHAMPSIM_INTERNALS_BRANCH_PREDICTORS_IBRANCHPREDICTOR_HH__
+
+#include <cstdint>
+#include <string>
+#
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+class O3_CPU;
+
+namespace pt = boost::property_tree;
+
+namespace champsim {
+namespace branch_predictors {
+/**
+ * @brief This class is an interface for branch predictors and is supposed to
+ * be inherited in a module.
+ */
+class ibranchpredictor {
+   public:
+    ibranchpredictor() = default;
+
+    /**
+     * @brief Destructor of the class.
+     */
+    virtual ~ibranchpredictor() {}
+
+    /**
+     * @brief Initialization method of the class. This method fetches the
+     * configuration file of the branch predictor.
+     * @param config_file Path to the configuration file of the branch
+     * predictor.
+     * @param cpu_inst The instance of the core to which the branch predictor is
+     * bound.
+     */
+    void init(const std::string& config_file, O3_CPU* cpu_inst) {
+        pt::ptree props;
+
+        pt::read_json(config_file, props);
+
+        // Calling the actual initialization.
+        this->_init(props, cpu_inst);
+    }
+
+    const std::string& name() const { return this->_name; }
+
+    virtual ibranchpredictor* clone() { return nullptr; }
+
+    /**
+     * @brief Resets the state of the branch predictor (tables and histories)
+     * to its initial value.
+     */
+    virtual void initialize() {}
+
+    /**
+     * @brief Predicts the direction of a branch.
+     * @param ip The instruction pointer of the branch.
+     * @return 1 if the branch is predicted taken, 0 otherwise.
+     */
+    virtual uint8_t predict_branch(uint64_t ip) = 0;
+
+    /**
+     * @brief Updates the branch predictor with the actual outcome of the last
+     * predicted branch.
+     * @param ip The instruction pointer of the branch.
+     * @param taken The actual direction of the branch.
+     */
+    virtual void last_branch_result(uint64_t /*ip*/, uint8_t /*taken*/) {}
+
+    /**
+     * @brief Reset the statistics of the branch predictor.
+     */
+    virtual void clear_stats() {}
+
+    /**
+     * @brief This method is used to provide statistics about the branch
+     * predictor.
+     */
+    virtual void dump_stats() {}
+
+   protected:
+    ibranchpredictor(const ibranchpredictor& o)
+        : _cpu_inst(o._cpu_inst), _name(o._name) {}
+
+    ibranchpredictor& operator=(const ibranchpredictor& o) {
+        this->_cpu_inst = o._cpu_inst;
+        this->_name = o._name;
+
+        return *this;
+    }
+
+    /**
+     * @brief The actual implementation of the initialization sequence of the
+     * branch predictor. This method is meant to be overloaded by derived
+     * classes.
+     * @param props The property tree contaning the configuration knobs needed
+     * by the branch predictor.
+     * @param cpu_inst The instance of the core to which the branch predictor is
+     * bound.
+     */
+    virtual void _init(const pt::ptree& props, O3_CPU* cpu_inst) {
+        this->_name = props.get<std::string>("name");
+        this->_cpu_inst = cpu_inst;
+    }
+
+   private:
+    ibranchpredictor(ibranchpredictor&&) = delete;
+
+    ibranchpredictor& operator=(ibranchpredictor&&) = delete;
+
+   protected:
+    O3_CPU* _cpu_inst;
+
+   private:
+    std::string _name;
+};
+}  // namespace branch_predictors
+}  // namespace champsim
+
+#endif  // __CHAMPSIM_INTERNALS_BRANCH_PREDICTORS_IBRANCHPREDICTOR_HH__
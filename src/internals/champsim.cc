@@ -54,7 +54,7 @@ uint64_t rotr64(uint64_t n, unsigned int c) {
 }
 
 uint64_t va_to_pa(uint32_t cpu, uint64_t instr_id, uint64_t va,
-                  uint64_t unique_vpage, uint8_t is_code) {
+                  uint64_t unique_vpage, uint8_t is_code, bool walk_modeled) {
 #ifdef SANITY_CHECK
     if (va == 0) assert(0);
 #endif
@@ -143,9 +143,14 @@ uint64_t va_to_pa(uint32_t cpu, uint64_t instr_id, uint64_t va,
             helper::page_queue.push(vpage);
 
             // invalidate corresponding vpage and ppage from the cache hierarchy
-            curr_cpu->ITLB.invalidate_entry(NRU_vpage);
-            curr_cpu->DTLB.invalidate_entry(NRU_vpage);
-            curr_cpu->STLB.invalidate_entry(NRU_vpage);
+            if (curr_cpu->tlb) {
+                curr_cpu->tlb->invalidate(NRU_vpage);
+            } else {
+                curr_cpu->ITLB->invalidate_entry(NRU_vpage);
+                curr_cpu->DTLB->invalidate_entry(NRU_vpage);
+                curr_cpu->STLB->invalidate_entry(NRU_vpage);
+            }
+
             for (uint32_t i = 0; i < BLOCK_SIZE; i++) {
                 uint64_t cl_addr = (mapped_ppage << 6) | i;
                 // curr_cpu->L1I.invalidate_entry(cl_addr);
@@ -252,7 +257,7 @@ uint64_t va_to_pa(uint32_t cpu, uint64_t instr_id, uint64_t va,
     if (swap)
         curr_cpu->stall_cycle() =
             curr_cpu->current_core_cycle() + helper::SWAP_LATENCY;
-    else
+    else if (!walk_modeled)
         curr_cpu->stall_cycle() =
             curr_cpu->current_core_cycle() + helper::PAGE_TABLE_LATENCY;
 
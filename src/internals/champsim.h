@@ -24,6 +24,7 @@
 // USEFUL MACROS
 //#define DEBUG_PRINT
 #define SANITY_CHECK
+//#define ROB_SANITY_CHECK
 #define LLC_BYPASS
 #define DRC_BYPASS
 #define NO_CRC2_COMPILE
@@ -85,9 +86,12 @@
 using namespace std;
 
 void print_stats();
-uint64_t rotl64(uint64_t n, unsigned int c), rotr64(uint64_t n, unsigned int c),
-    va_to_pa(uint32_t cpu, uint64_t instr_id, uint64_t va,
-             uint64_t unique_vpage, uint8_t is_code);
+uint64_t rotl64(uint64_t n, unsigned int c), rotr64(uint64_t n, unsigned int c);
+// The core is stalled for the page table access unless the caller models the
+// page walk itself (walk_modeled). Page swaps always stall it.
+uint64_t va_to_pa(uint32_t cpu, uint64_t instr_id, uint64_t va,
+                  uint64_t unique_vpage, uint8_t is_code,
+                  bool walk_modeled = false);
 uint32_t folded_xor(uint64_t value, uint32_t num_folds);
 uint64_t jenkins_hash(uint64_t key);
 uint64_t fnv1a64(uint64_t key);
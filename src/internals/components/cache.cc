@@ -29,6 +29,13 @@ static std::map<std::string, cc::cache::fill_levels> fill_level_map = {
     {"fill_dram", cc::cache::fill_dram}, {"fill_sdc", cc::cache::fill_sdc},
 };
 
+static std::map<std::string, cc::cache::cross_page_modes>
+    cross_page_mode_map = {
+        {"off", cc::cache::cross_page_off},
+        {"stlb", cc::cache::cross_page_stlb},
+        {"walk", cc::cache::cross_page_walk},
+};
+
 static std::map<cc::cache::access_types, std::pair<std::string, std::string>>
     access_type_map = {
         {cc::cache::load, {"load", "LOAD"}},
@@ -39,6 +46,18 @@ static std::map<cc::cache::access_types, std::pair<std::string, std::string>>
 
 cc::cache::cache()
     : _cache_type(0x0),
+      _cross_page_mode(cross_page_off),
+      _pf_cross_page_requested(0),
+      _pf_cross_page_stlb_hits(0),
+      _pf_cross_page_probe_hits(0),
+      _pf_cross_page_walk_joins(0),
+      _pf_cross_page_walks(0),
+      _pf_cross_page_dropped(0),
+      _pf_cross_page_unmapped(0),
+      _pf_cross_page_issued(0),
+      _pf_cross_page_fill(0),
+      _pf_cross_page_useful(0),
+      _pf_cross_page_useless(0),
       _stats(CHAMPSIM_CPU_NUMBER_CORE),
       _read_overlap(0),
       _read_received(0),
@@ -70,14 +89,12 @@ void cc::cache::init_cache(const std::string& config_file) {
 }
 
 void cc::cache::init_replacement_policy() {
-    std::string replacement_path = "./replacements/" + _replacement_name,
-                replacement_config_path =
-                    "config/replacements/" + _replacement_name + ".json";
+    std::string replacement_config_path =
+        "config/replacements/" + _replacement_name + ".json";
 
     this->_replacement_policy_callable =
-        dll::import_alias<cr::ireplacementpolicy*()>(
-            replacement_path, "create_replacementpolicy",
-            dll::load_mode::append_decorations);
+        champsim::import_plugin<cr::ireplacementpolicy>(
+            "./replacements/", _replacement_name, "create_replacementpolicy");
 
     this->_replacement_policy = this->_replacement_policy_callable();
     this->_replacement_policy->init(replacement_config_path, this);
@@ -125,40 +142,128 @@ bool cc::cache::prefetch_line(const uint32_t& cpu, const uint8_t& size,
                               const uint64_t& pf_addr,
                               const cc::cache::fill_levels& fill_level,
                               const uint32_t& metadata) {
-    bool cross_page_bounds =
-             ((base_addr >> LOG2_PAGE_SIZE) != (pf_addr >> LOG2_PAGE_SIZE)),
+    return this->prefetch_line(prefetch_descriptor{
+        cpu, size, metadata, ip, base_addr, pf_addr, fill_level});
+}
+
+/**
+ * @brief Issues a prefetch request already described, along with the component
+ * of the composite prefetcher it comes from.
+ *
+ * @return Returns true if the prefetch has been successfully issued.
+ */
+bool cc::cache::prefetch_line(const prefetch_descriptor& pf) {
+    if (this->_pf_collector != nullptr) {
+        return this->_pf_collector->collect(pf);
+    }
+
+    return this->issue_prefetch_line(pf);
+}
+
+/**
+ * @brief Issues a prefetch request, even while a collector is set.
+ *
+ * @return Returns true if the prefetch has been successfully issued.
+ */
+bool cc::cache::issue_prefetch_line(const prefetch_descriptor& pf) {
+    return this->_prefetch_line(
+        champsim::simulator::instance()->modeled_cpu(pf.cpu), pf);
+}
+
+/**
+ * @brief Hands the requests of prefetch_line to a collector, so that a
+ * prefetcher driving other prefetchers can filter them before issuing them.
+ * The outcome the collector returns is the one seen by the caller of
+ * prefetch_line. The requests are issued directly again once the collector is
+ * reset to a null pointer.
+ */
+void cc::cache::collect_prefetches(prefetch_collector* collector) {
+    this->_pf_collector = collector;
+}
+
+bool cc::cache::_prefetch_line(O3_CPU* curr_cpu,
+                               const prefetch_descriptor& pf) {
+    bool cross_page_bounds = ((pf.base_addr >> LOG2_PAGE_SIZE) !=
+                              (pf.pf_addr >> LOG2_PAGE_SIZE)),
          queue_full =
              (this->_prefetch_queue->occupancy == this->_prefetch_queue->SIZE);
     PACKET pf_packet;
-    cc::locmap_prediction_descriptor pred_desc;
-    O3_CPU* curr_cpu = champsim::simulator::instance()->modeled_cpu(cpu);
 
     // Updating stats.
     this->_pf_requested++;
 
+    if (cross_page_bounds && this->_cross_page_mode != cross_page_off) {
+        return this->_prefetch_cross_page(curr_cpu, pf);
+    }
+
     if (cross_page_bounds || queue_full) {
         return false;  // No prefetch issued.
     }
 
+    // The block is already on its way or in the cache, the request is
+    // dropped before building its packet but reported as issued.
+    if (this->_pf_filter.enabled() && this->_filter_prefetch(pf)) {
+        return true;
+    }
+
+    this->_fill_prefetch_packet(pf_packet, pf);
+    pf_packet.event_cycle = curr_cpu->current_core_cycle();
+
+    this->_issue_prefetch(curr_cpu, pf_packet);
+
+    return true;  // Prefetch issued.
+}
+
+/**
+ * @brief Checks a prefetch request against the blocks recently prefetched
+ * and, optionally, against the tag array. Requests going through are recorded
+ * as recent.
+ *
+ * @return Returns true if the request has to be dropped.
+ */
+bool cc::cache::_filter_prefetch(const prefetch_descriptor& pf) {
+    uint64_t block = (pf.pf_addr >> LOG2_BLOCK_SIZE);
+
+    if (this->_pf_filter.contains(block)) {
+        this->_pf_filter.filtered_recent();
+        return true;
+    }
+
+    if (this->_pf_filter.probe_tags() && this->is_block_valid(pf.pf_addr)) {
+        this->_pf_filter.filtered_resident();
+        return true;
+    }
+
+    this->_pf_filter.insert(block);
+
+    return false;
+}
+
+void cc::cache::_fill_prefetch_packet(PACKET& pf_packet,
+                                      const prefetch_descriptor& pf) const {
     // Filling the prefetch packet.
-    pf_packet.fill_level = fill_level;
+    pf_packet.fill_level = pf.fill_level;
 
-    if (fill_level == fill_l1 || fill_level == fill_sdc) {
+    if (pf.fill_level == fill_l1 || pf.fill_level == fill_sdc) {
         pf_packet.fill_l1d = 1;
     }
 
     pf_packet.pf_origin_level = this->_fill_level;
-    pf_packet.pf_metadata = metadata;
-    pf_packet.cpu = cpu;
-    pf_packet.address = (pf_addr >> LOG2_BLOCK_SIZE);
-    pf_packet.full_addr = pf_addr;
-    pf_packet.memory_size = size;
-    pf_packet.ip = ip;
+    pf_packet.pf_metadata = pf.metadata;
+    pf_packet.pf_component = pf.component;
+    pf_packet.cpu = pf.cpu;
+    pf_packet.address = (pf.pf_addr >> LOG2_BLOCK_SIZE);
+    pf_packet.full_addr = pf.pf_addr;
+    pf_packet.memory_size = pf.size;
+    pf_packet.ip = pf.ip;
     pf_packet.type = cc::cache::prefetch;
-    pf_packet.event_cycle = curr_cpu->current_core_cycle();
     pf_packet.went_offchip_pred = static_cast<bool>(
-        metadata);  // WIP: Here the metadata is used to identify demand request
-                    // predicted to be off-chip.
+        pf.metadata);  // WIP: Here the metadata is used to identify demand
+                       // request predicted to be off-chip.
+}
+
+void cc::cache::_issue_prefetch(O3_CPU* curr_cpu, PACKET& pf_packet) {
+    cc::locmap_prediction_descriptor pred_desc;
 
     // WIP: If we are trying to prefetch in the L1D, should the prefetcher be
     // enabled?
@@ -175,8 +280,177 @@ bool cc::cache::prefetch_line(const uint32_t& cpu, const uint8_t& size,
     this->add_prefetch_queue(pf_packet);
 
     this->_pf_issued++;
+}
 
-    return true;  // Prefetch issued.
+/**
+ * @brief Translates a prefetch crossing the page of its base address. Caches
+ * operate on physical addresses, so the target is moved to the virtual page
+ * of the base address and looked up in the STLB of the core. On an STLB miss,
+ * the prefetch is dropped or, in the walk mode, a page walk is queued when a
+ * walker queue entry is free. Translated prefetches wait in the cache until
+ * their translation is available.
+ *
+ * @return Returns true if the prefetch will be issued.
+ */
+bool cc::cache::_prefetch_cross_page(O3_CPU* curr_cpu,
+                                     const prefetch_descriptor& pf) {
+    uint64_t base_page = (pf.base_addr >> LOG2_PAGE_SIZE),
+             pf_page = (pf.pf_addr >> LOG2_PAGE_SIZE),
+             cycle = curr_cpu->current_core_cycle(), ready = 0, vpage;
+    std::map<uint64_t, uint64_t>::const_iterator it;
+    prefetch_descriptor translated = pf;
+    PACKET pf_packet;
+    tlb_hierarchy::prefetch_translations outcome =
+        tlb_hierarchy::prefetch_translation_dropped;
+
+    this->_pf_cross_page_requested++;
+
+    if (this->_pf_translations.size() >= this->_prefetch_queue->SIZE ||
+        (it = helper::inverse_table.find(base_page)) ==
+            helper::inverse_table.end()) {
+        this->_pf_cross_page_dropped++;
+        return false;
+    }
+
+    // Moving to the target virtual page, it keeps the CPU bits of the base
+    // page. Pages that were never touched have no translation to prefetch, a
+    // prefetch does not allocate them.
+    vpage = it->second + (pf_page - base_page);
+
+    if ((it = helper::page_table.find(vpage)) == helper::page_table.end()) {
+        this->_pf_cross_page_unmapped++;
+        return false;
+    }
+
+    if (curr_cpu->tlb) {
+        ready = curr_cpu->tlb->translate_prefetch(
+            (vpage & (UINT64_MAX >> lg2(NUM_CPUS))) << LOG2_PAGE_SIZE,
+            this->_cross_page_mode == cross_page_walk, outcome);
+    } else {
+        // The legacy STLB can only be probed, its misses cannot be walked on
+        // behalf of a prefetch.
+        PACKET probe;
+
+        probe.address = (vpage & (UINT64_MAX >> lg2(NUM_CPUS)));
+
+        if (curr_cpu->STLB->check_hit(&probe) != -1) {
+            ready = cycle + STLB_LATENCY;
+            this->_pf_cross_page_probe_hits++;
+        }
+    }
+
+    if (ready == 0) {
+        this->_pf_cross_page_dropped++;
+        return false;
+    }
+
+    // Only the translations found in the STLB of the TLB model are hits, the
+    // ones obtained from a walk already in flight are counted apart.
+    if (outcome == tlb_hierarchy::prefetch_translation_stlb_hit) {
+        this->_pf_cross_page_stlb_hits++;
+    } else if (outcome == tlb_hierarchy::prefetch_translation_joined_walk) {
+        this->_pf_cross_page_walk_joins++;
+    } else if (outcome == tlb_hierarchy::prefetch_translation_walked) {
+        this->_pf_cross_page_walks++;
+    }
+
+    translated.pf_addr =
+        (it->second << LOG2_PAGE_SIZE) | (pf.pf_addr & (PAGE_SIZE - 1));
+
+    // The block is only known once translated, the translation is still paid
+    // for when the request is filtered.
+    if (this->_pf_filter.enabled() && this->_filter_prefetch(translated)) {
+        return true;
+    }
+
+    this->_fill_prefetch_packet(pf_packet, translated);
+    pf_packet.pf_cross_page = true;
+
+    this->_pf_translations.emplace(ready, pf_packet);
+
+    return true;
+}
+
+/**
+ * @brief Moves the cross-page prefetches whose translation completed to the
+ * prefetch queue, in completion order.
+ */
+void cc::cache::_issue_translated_prefetches() {
+    O3_CPU* curr_cpu = champsim::simulator::instance()->modeled_cpu(
+        this->_pf_translations.begin()->second.cpu);
+    uint64_t cycle = curr_cpu->current_core_cycle();
+
+    while (!this->_pf_translations.empty() &&
+           this->_pf_translations.begin()->first <= cycle &&
+           this->_prefetch_queue->occupancy < this->_prefetch_queue->SIZE) {
+        PACKET& pf_packet = this->_pf_translations.begin()->second;
+
+        pf_packet.event_cycle = cycle;
+
+        this->_issue_prefetch(curr_cpu, pf_packet);
+        this->_pf_cross_page_issued++;
+
+        this->_pf_translations.erase(this->_pf_translations.begin());
+    }
+}
+
+/**
+ * @brief Feeds a fill to the throttling of the prefetcher and, at the end of
+ * an epoch, passes the new aggressiveness on to the prefetcher.
+ */
+void cc::cache::_throttle_on_fill(const PACKET& packet, bool victim_valid,
+                                  uint64_t victim) {
+    bool prefetch = (packet.type == cc::cache::prefetch),
+         demand =
+             (packet.type == cc::cache::load || packet.type == cc::cache::rfo);
+
+    if (!this->_throttler.fill(packet.address, prefetch, demand, victim_valid,
+                               victim))
+        return;
+
+    if (this->_throttler.adapt(champsim::simulator::instance()
+                                   ->modeled_cpu(packet.cpu)
+                                   ->current_core_cycle(),
+                               uncore.DRAM.dbus_busy_cycles,
+                               uncore.DRAM.channels)) {
+        this->_prefetcher->throttle(this->_throttler.scale());
+    }
+}
+
+/**
+ * @brief Hands an access to the prefetcher, or records it for the batch of the
+ * current cycle when the prefetcher is batched.
+ */
+void cc::cache::_prefetcher_operate(
+    const cp::prefetch_request_descriptor& desc) {
+    if (this->_prefetcher->batched()) {
+        this->_pf_accesses.push_back(desc);
+    } else {
+        this->_prefetcher->operate(desc);
+    }
+}
+
+/**
+ * @brief Calls the prefetcher once on the accesses of the cycle, and issues the
+ * prefetch requests it returned in one pass.
+ */
+void cc::cache::_prefetcher_operate_batch() {
+    O3_CPU* curr_cpu = nullptr;
+
+    this->_prefetcher->operate_batch(this->_pf_accesses.data(),
+                                     this->_pf_accesses.size(),
+                                     this->_pf_candidates);
+    this->_pf_accesses.clear();
+
+    for (const prefetch_descriptor& pf : this->_pf_candidates) {
+        if (curr_cpu == nullptr || curr_cpu->cpu != pf.cpu) {
+            curr_cpu = champsim::simulator::instance()->modeled_cpu(pf.cpu);
+        }
+
+        this->_prefetch_line(curr_cpu, pf);
+    }
+
+    this->_pf_candidates.clear();
 }
 
 bool cc::cache::prefetcher_enable(const uint64_t& base_addr) const {
@@ -434,6 +708,15 @@ void cc::cache::merge_mshr_on_read(PACKET& src, cc::cache::mshr_iterator dst) {
 
     // Updating request.
     if (dst->type == cc::cache::prefetch) {
+        // The demand caught up with the prefetch: it is late.
+        this->_throttler.late();
+
+        if (this->_pf_accounting.enabled()) {
+            this->_pf_accounting.late(
+                {dst->ip, dst->pf_origin_level, dst->fill_level,
+                 dst->pf_component});
+        }
+
         cc::cache::fill_levels prior_fill_level =
             static_cast<cc::cache::fill_levels>(dst->fill_level);
         uint8_t prior_returned = dst->returned;
@@ -618,9 +901,25 @@ void cc::cache::reset_stats() {
     this->_pf_useless = 0ULL;
     this->_pf_fill = 0ULL;
 
+    this->_pf_cross_page_requested = 0ULL;
+    this->_pf_cross_page_stlb_hits = 0ULL;
+    this->_pf_cross_page_probe_hits = 0ULL;
+    this->_pf_cross_page_walk_joins = 0ULL;
+    this->_pf_cross_page_walks = 0ULL;
+    this->_pf_cross_page_dropped = 0ULL;
+    this->_pf_cross_page_unmapped = 0ULL;
+    this->_pf_cross_page_issued = 0ULL;
+    this->_pf_cross_page_fill = 0ULL;
+    this->_pf_cross_page_useful = 0ULL;
+    this->_pf_cross_page_useless = 0ULL;
+
     this->_pf_useful_per_loc.clear();
     this->_pf_useless_per_loc.clear();
 
+    this->_throttler.reset_stats();
+    this->_pf_accounting.reset_stats();
+    this->_pf_filter.reset_stats();
+
     // Resetting the internal stats of the prefetcher.
     this->_prefetcher->clear_stats();
 }
@@ -713,6 +1012,35 @@ void cc::cache::report(std::ostream& os, const size_t& cpu) {
        << std::endl
        << std::endl;
 
+    // Coverage and translation traffic of the cross-page prefetches.
+    if (this->_cross_page_mode != cross_page_off ||
+        this->_pf_cross_page_fill != 0) {
+        os << "pf_cross_page_requested: " << this->_pf_cross_page_requested
+           << " stlb_hits: " << this->_pf_cross_page_stlb_hits
+           << " probe_hits: " << this->_pf_cross_page_probe_hits
+           << " walk_joins: " << this->_pf_cross_page_walk_joins
+           << " walks: " << this->_pf_cross_page_walks
+           << " dropped: " << this->_pf_cross_page_dropped
+           << " unmapped: " << this->_pf_cross_page_unmapped
+           << " issued: " << this->_pf_cross_page_issued << std::endl
+           << "pf_cross_page_fill: " << this->_pf_cross_page_fill
+           << " useful: " << this->_pf_cross_page_useful
+           << " useless: " << this->_pf_cross_page_useless << std::endl
+           << std::endl;
+    }
+
+    if (this->_throttler.enabled()) {
+        this->_throttler.dump_stats(os);
+    }
+
+    if (this->_pf_filter.enabled()) {
+        this->_pf_filter.dump_stats(os);
+    }
+
+    if (this->_pf_accounting.enabled()) {
+        this->_pf_accounting.dump_stats(os);
+    }
+
     // WIP: If this is an L1D we print stats prefetching accuracy per location.
     if (this->check_type(cc::is_l1d)) {
         // First, the useful prefetches.
@@ -741,6 +1069,10 @@ void cc::cache::report(std::ostream& os, const size_t& cpu) {
  * resetting counters each cycle.
  */
 void cc::cache::operate() {
+    if (!this->_pf_translations.empty()) {
+        this->_issue_translated_prefetches();
+    }
+
     // Performs all writes.
     this->_writes_avail_cycle = this->_writes_avail;
 
@@ -752,6 +1084,10 @@ void cc::cache::operate() {
 
     this->_handle_read();
 
+    if (!this->_pf_accesses.empty()) {
+        this->_prefetcher_operate_batch();
+    }
+
     if (this->_prefetch_queue->occupancy && this->_reads_avail_cycle > 0) {
         this->_handle_prefetch();
     }
@@ -1175,10 +1511,12 @@ PACKET_QUEUE* cc::cache::processed_queue() const { return this->_processed; }
 void cc::cache::_init_cache_impl(const pt::ptree& props) {
     std::size_t write_queue_size, read_queue_size, prefetch_queue_size,
         mshr_size, processed_queue_size;
-    std::string fill_level, cache_type, prefetcher_name, prefetcher_path,
-        prefetcher_config_path;
+    std::string fill_level, cache_type, prefetcher_name,
+        prefetcher_config_path, cross_page_mode;
     std::map<std::string, cc::cache_type>::iterator cache_type_it;
     std::map<std::string, cc::cache::fill_levels>::iterator fill_level_it;
+    std::map<std::string, cc::cache::cross_page_modes>::iterator
+        cross_page_mode_it;
 
     // Getting this instance's given name.
     this->_name = props.get<std::string>("name");
@@ -1232,18 +1570,49 @@ void cc::cache::_init_cache_impl(const pt::ptree& props) {
         new PACKET_QUEUE(this->_name + "_PROCESS", processed_queue_size);
     this->_mshr = std::vector<PACKET>(mshr_size);
 
+    // Cross-page prefetching is only offered to the L1D and the L2C, whose
+    // prefetches can be translated through the STLB of their core.
+    cross_page_mode = props.get<std::string>("cross_page_prefetch", "off");
+
+    if ((cross_page_mode_it = cross_page_mode_map.find(cross_page_mode)) ==
+        cross_page_mode_map.end()) {
+        throw std::runtime_error("Unknown cross-page prefetching mode: " +
+                                 cross_page_mode + ".");
+    }
+
+    this->_cross_page_mode = cross_page_mode_it->second;
+
+    if (this->_cross_page_mode != cross_page_off &&
+        !this->check_type(cc::is_l1d) && !this->check_type(cc::is_l2c)) {
+        throw std::runtime_error(
+            "Cross-page prefetching is only supported by the L1D and the "
+            "L2C.");
+    }
+
     // Initializing the prefetcher.
     prefetcher_name = props.get<std::string>("prefetcher");
-    prefetcher_path = "./prefetchers/" + prefetcher_name;
     prefetcher_config_path = "config/prefetchers/" + prefetcher_name + ".json";
 
-    this->_prefetcher_callable = dll::import_alias<cp::iprefetcher*()>(
-        prefetcher_path, "create_prefetcher",
-        dll::load_mode::append_decorations);
+    this->_prefetcher_callable = champsim::import_plugin<cp::iprefetcher>(
+        "./prefetchers/", prefetcher_name, "create_prefetcher");
 
     this->_prefetcher = this->_prefetcher_callable();
     this->_prefetcher->init(prefetcher_config_path, this);
 
+    // Attaching the feedback-directed throttling, if any, to the prefetcher.
+    if (auto throttling = props.get_child_optional("throttling")) {
+        this->_throttler.init(*throttling);
+
+        if (this->_throttler.enabled()) {
+            this->_prefetcher->throttle(this->_throttler.scale());
+        }
+    }
+
+    // Filtering the prefetch requests ahead of the prefetch queue, if asked.
+    if (auto filter = props.get_child_optional("prefetch_filter")) {
+        this->_pf_filter.init(*filter);
+    }
+
     // Initializing the replacement policy.
     this->_replacement_name = props.get<std::string>("replacement_policy");
 
@@ -17,12 +17,18 @@
 #include <internals/memory_class.h>
 #
 #include <internals/components/memory_system.hh>
+#include <internals/components/prefetch_accounting.hh>
+#include <internals/components/prefetch_throttler.hh>
+#include <internals/components/recent_prefetch_filter.hh>
 #include <internals/components/routing_engine.hh>
 
 // Forward declarations.
+class O3_CPU;
+
 namespace champsim {
 namespace prefetchers {
 class iprefetcher;
+struct prefetch_request_descriptor;
 }
 
 namespace replacements {
@@ -99,6 +105,15 @@ class cache : public memory_system, public MEMORY {
         fill_sdc = 0,
     };
 
+    // What happens to the prefetches crossing a page: they are dropped, they
+    // are translated through the STLB and dropped on a miss, or an STLB miss
+    // queues a page walk.
+    enum cross_page_modes {
+        cross_page_off = 0,
+        cross_page_stlb = 1,
+        cross_page_walk = 2,
+    };
+
     enum add_queue_codes : int32_t {
         add_queue_success = -1,
         add_queue_failure = -2,
@@ -106,13 +121,26 @@ class cache : public memory_system, public MEMORY {
 
     struct prefetch_descriptor {
        public:
-        uint8_t cpu, size;
+        uint32_t cpu;
+        uint8_t size;
 
         uint32_t metadata;
 
         uint64_t ip, base_addr, pf_addr;
 
         fill_levels fill_level;
+
+        // component of a composite prefetcher, starting at one
+        uint32_t component = 0;
+    };
+
+    // Receives the requests of prefetch_line while it is set on the cache, and
+    // decides whether they are issued.
+    class prefetch_collector {
+       public:
+        virtual ~prefetch_collector() {}
+
+        virtual bool collect(const prefetch_descriptor& pf) = 0;
     };
 
     struct cache_stats {
@@ -233,6 +261,16 @@ class cache : public memory_system, public MEMORY {
     uint64_t _pf_requested, _pf_issued, _pf_useful, _pf_useless, _pf_fill;
     std::map<cc::cache_type, uint64_t> _pf_useful_per_loc, _pf_useless_per_loc;
 
+    // Cross-page prefetching: the prefetches waiting for their translation,
+    // by ready cycle, and their stats.
+    cross_page_modes _cross_page_mode;
+    std::multimap<uint64_t, PACKET> _pf_translations;
+    uint64_t _pf_cross_page_requested, _pf_cross_page_stlb_hits,
+        _pf_cross_page_probe_hits, _pf_cross_page_walk_joins,
+        _pf_cross_page_walks, _pf_cross_page_dropped, _pf_cross_page_unmapped,
+        _pf_cross_page_issued, _pf_cross_page_fill, _pf_cross_page_useful,
+        _pf_cross_page_useless;
+
     uint64_t _read_received, _read_overlap, _write_received, _write_overlap,
         _prefetch_received, _prefetch_overlap;
 
@@ -250,6 +288,19 @@ class cache : public memory_system, public MEMORY {
     cp::iprefetcher* _prefetcher;
     std::function<cp::iprefetcher*()> _prefetcher_callable;
 
+    prefetch_throttler _throttler;
+    prefetch_accounting _pf_accounting;
+    recent_prefetch_filter _pf_filter;
+
+    // Accesses of the current cycle handed at once to a batched prefetcher,
+    // and the prefetch requests it returns. Both are reused across cycles.
+    std::vector<cp::prefetch_request_descriptor> _pf_accesses;
+    std::vector<prefetch_descriptor> _pf_candidates;
+
+    // When set, the requests of prefetch_line are handed to it instead of
+    // being issued directly.
+    prefetch_collector* _pf_collector = nullptr;
+
     cr::ireplacementpolicy* _replacement_policy;
     std::function<cr::ireplacementpolicy*()> _replacement_policy_callable;
 
@@ -277,6 +328,8 @@ class cache : public memory_system, public MEMORY {
     virtual std::size_t sets() const = 0;
     virtual std::size_t associativity() const = 0;
 
+    cross_page_modes cross_page_mode() const { return this->_cross_page_mode; }
+
     const uint64_t& pf_requested() const;
     const uint64_t& pf_issued() const;
     const uint64_t& pf_useful() const;
@@ -312,6 +365,9 @@ class cache : public memory_system, public MEMORY {
                        const uint64_t& ip, const uint64_t& base_addr,
                        const uint64_t& pf_addr, const fill_levels& fill_level,
                        const uint32_t& metadata);
+    bool prefetch_line(const prefetch_descriptor& pf);
+    bool issue_prefetch_line(const prefetch_descriptor& pf);
+    void collect_prefetches(prefetch_collector* collector);
     bool prefetcher_enable(const uint64_t& base_addr) const;
     void set_prefetcher_psel_bits(const uint64_t& size),
         set_prefetcher_threshold(const uint64_t& threshold);
@@ -342,6 +398,7 @@ class cache : public memory_system, public MEMORY {
     virtual void invalidate_line(const uint64_t& full_addr) = 0;
 
     virtual bool is_valid(const uint32_t& set, const uint16_t& way) = 0;
+    virtual bool is_block_valid(const uint64_t& addr) const = 0;
 
     virtual void return_data(PACKET& packet) override = 0;
     virtual void return_data(PACKET& packet,
@@ -386,6 +443,20 @@ class cache : public memory_system, public MEMORY {
                                const uint32_t& set) const = 0;
 
     void _sort_mshr();
+
+    bool _prefetch_line(O3_CPU* curr_cpu, const prefetch_descriptor& pf);
+    bool _filter_prefetch(const prefetch_descriptor& pf);
+    void _fill_prefetch_packet(PACKET& pf_packet,
+                               const prefetch_descriptor& pf) const;
+    void _issue_prefetch(O3_CPU* curr_cpu, PACKET& pf_packet);
+    bool _prefetch_cross_page(O3_CPU* curr_cpu, const prefetch_descriptor& pf);
+    void _issue_translated_prefetches();
+
+    void _throttle_on_fill(const PACKET& packet, bool victim_valid,
+                           uint64_t victim);
+
+    void _prefetcher_operate(const cp::prefetch_request_descriptor& desc);
+    void _prefetcher_operate_batch();
     virtual std::vector<PACKET>::iterator _add_mshr(const PACKET& packet) = 0;
     virtual void _fill_cache(const uint32_t& set, const uint16_t& way,
                              const PACKET& packet) = 0;
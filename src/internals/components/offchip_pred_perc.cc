@@ -8,11 +8,7 @@
 namespace cc = champsim::components;
 
 cc::offchip_predictor_perceptron::offchip_predictor_perceptron()
-    : _cpu(0),
-      _page_buffer_sets(64),
-      _page_buffer_ways(16),
-      _pf_page_buffer_sets(64),
-      _pf_page_buffer_ways(16) {
+    : _cpu(0), _page_buffer(), _pf_page_buffer() {
     // stats
     this->_true_pos = 0;
     this->_false_pos = 0;
@@ -23,12 +19,6 @@ cc::offchip_predictor_perceptron::offchip_predictor_perceptron()
     this->_pred = new cc::perceptron_predictor({5, 8, 9, 11, 16}, -17);
     this->_pf_pred = new cc::perceptron_predictor({5, 8, 9, 11, 16}, -17);
 
-    this->_page_buffer = std::vector<std::deque<cc::page_buffer_entry *>>(
-        this->_page_buffer_sets, std::deque<cc::page_buffer_entry *>(0));
-
-    this->_pf_page_buffer = std::vector<std::deque<cc::page_buffer_entry *>>(
-        this->_pf_page_buffer_sets, std::deque<cc::page_buffer_entry *>(0));
-
     this->_stlb_phist = std::vector<std::vector<uint32_t>>(
         0x40, std::vector<uint32_t>(0x40, 0));
 }
@@ -117,73 +107,74 @@ void cc::offchip_predictor_perceptron::_lookup_address(const uint64_t &vaddr,
                                                        const uint64_t &vpage,
                                                        const uint32_t voffset,
                                                        bool &first_access) {
-    cc::page_buffer_entry *entry = nullptr;
-    uint32_t set = this->_get_set(vpage);
-
-    auto it = std::find_if(
-        this->_page_buffer[set].begin(), this->_page_buffer[set].end(),
-        [vpage](cc::page_buffer_entry *e) -> bool { return e->page == vpage; });
-
-    if (it != this->_page_buffer[set].end()) {
-        entry = *it;
-        first_access = !entry->bmp_access.test(voffset);
-        entry->bmp_access.set(voffset);
-        entry->age = 0;
-        this->_page_buffer[set].erase(it);
-        this->_page_buffer[set].push_back(entry);
-    } else {
-        if (this->_page_buffer[set].size() >= this->_page_buffer_ways) {
-            entry = this->_page_buffer[set].front();
-            this->_page_buffer[set].pop_front();
-            delete entry;
-        }
-
-        entry = new cc::page_buffer_entry;
-        entry->page = vpage;
-        entry->bmp_access.set(voffset);
-        entry->age = 0;
-        this->_page_buffer[set].push_back(entry);
-        first_access = true;
-    }
+    _lookup_page_buffer(this->_page_buffer[this->_get_set(vpage)], vpage,
+                        voffset, first_access);
 }
 
 void cc::offchip_predictor_perceptron::_lookup_address_on_prefetch(
     const uint64_t &vaddr, const uint64_t &vpage, const uint32_t voffset,
     bool &first_access) {
-    cc::page_buffer_entry *entry = nullptr;
-    uint32_t set = this->_get_set(vpage);
+    _lookup_page_buffer(this->_pf_page_buffer[this->_get_set(vpage)], vpage,
+                        voffset, first_access);
+}
 
-    auto it = std::find_if(
-        this->_pf_page_buffer[set].begin(), this->_pf_page_buffer[set].end(),
-        [vpage](cc::page_buffer_entry *e) -> bool { return e->page == vpage; });
+/**
+ * @brief Looks up a page in a set of a page buffer, allocating it on a miss.
+ * Replacement is true LRU: an age of 0 is the most recently used way and an
+ * age of page_buffer_ways - 1 is the least recently used one.
+ *
+ * @param set
+ * @param vpage
+ * @param voffset
+ * @param first_access
+ */
+void cc::offchip_predictor_perceptron::_lookup_page_buffer(
+    page_buffer_set &set, const uint64_t &vpage, const uint32_t voffset,
+    bool &first_access) {
+    cc::page_buffer_entry *entry = nullptr, *victim = nullptr;
+
+    for (cc::page_buffer_entry &e : set) {
+        if (!e.valid) {
+            if (victim == nullptr || victim->valid) victim = &e;
+            continue;
+        }
+
+        if (e.page == vpage) {
+            entry = &e;
+            break;
+        }
 
-    if (it != this->_pf_page_buffer[set].end()) {
-        entry = *it;
+        if (victim == nullptr || (victim->valid && e.age > victim->age))
+            victim = &e;
+    }
+
+    if (entry != nullptr) {
         first_access = !entry->bmp_access.test(voffset);
         entry->bmp_access.set(voffset);
-        entry->age = 0;
-        this->_pf_page_buffer[set].erase(it);
-        this->_pf_page_buffer[set].push_back(entry);
+
+        for (cc::page_buffer_entry &e : set) {
+            if (e.valid && e.age < entry->age) e.age++;
+        }
     } else {
-        if (this->_pf_page_buffer[set].size() >= this->_pf_page_buffer_ways) {
-            entry = this->_pf_page_buffer[set].front();
-            this->_pf_page_buffer[set].pop_front();
-            delete entry;
+        for (cc::page_buffer_entry &e : set) {
+            if (e.valid) e.age++;
         }
 
-        entry = new cc::page_buffer_entry;
+        entry = victim;
+        entry->valid = true;
         entry->page = vpage;
+        entry->bmp_access.reset();
         entry->bmp_access.set(voffset);
-        entry->age = 0;
-        this->_pf_page_buffer[set].push_back(entry);
         first_access = true;
     }
+
+    entry->age = 0;
 }
 
 uint32_t cc::offchip_predictor_perceptron::_get_set(
     const uint64_t &vpage) const {
     uint32_t hash = fnv1a64(vpage);
-    return hash % this->_page_buffer_sets;
+    return hash % page_buffer_sets;
 }
 
 /**
@@ -196,33 +187,17 @@ uint32_t cc::offchip_predictor_perceptron::_get_set(
 void cc::offchip_predictor_perceptron::_get_control_flow_signatures(
     LSQ_ENTRY *lq_entry, uint64_t &last_n_load_pc_sig, uint64_t &last_n_pc_sig,
     uint64_t &last_n_vpn) {
-    uint64_t curr_pc = lq_entry->ip;
+    this->_last_n_load_pc.push(lq_entry->ip);
+    last_n_load_pc_sig = this->_last_n_load_pc.signature();
 
-    // TODO: Here we hardcode the number of load PCs to use but we should
-    // parametrize this.
-    if (this->_last_n_load_pc.size() >= 4) {
-        this->_last_n_load_pc.pop_front();
-    }
-    this->_last_n_load_pc.push_back(curr_pc);
-
-    last_n_load_pc_sig = 0ULL;
-
-    for (const uint64_t &pc : this->_last_n_load_pc) {
-        last_n_load_pc_sig <<= 1;
-        last_n_load_pc_sig ^= pc;
-    }
-
-    // signature from all N instruction PCs.
+    // signature from all N instruction PCs, walking the ROB backward from the
+    // load so that the oldest PC is folded in first.
     int32_t prior = lq_entry->rob_index;
-    std::deque<uint64_t> last_n_pcs;
+    std::array<uint64_t, history_length> last_n_pcs;
+    const O3_CPU *cpu = champsim::simulator::instance()->modeled_cpu(this->_cpu);
 
-    // TODO: Here we hardcode the number of PCs to use but we should parametrize
-    // this.
-    for (std::size_t i = 0; i < 4; i++) {
-        last_n_pcs.push_front(champsim::simulator::instance()
-                                  ->modeled_cpu(this->_cpu)
-                                  ->ROB.entry[prior]
-                                  .ip);
+    for (std::size_t i = history_length; i-- > 0;) {
+        last_n_pcs[i] = cpu->ROB.entry[prior].ip;
 
         prior--;
 
@@ -235,19 +210,8 @@ void cc::offchip_predictor_perceptron::_get_control_flow_signatures(
         last_n_pc_sig ^= pc;
     }
 
-    // TODO: Here we hardcode the number of VPNs to use but we should
-    // parametrize this.
-    if (this->_last_n_vpn.size() >= 4) {
-        this->_last_n_vpn.pop_front();
-    }
-    this->_last_n_vpn.push_back(lq_entry->physical_address >> LOG2_PAGE_SIZE);
-
-    last_n_vpn = 0ULL;
-
-    for (const uint64_t &vpn : this->_last_n_vpn) {
-        last_n_vpn <<= 1;
-        last_n_vpn ^= vpn;
-    }
+    this->_last_n_vpn.push(lq_entry->physical_address >> LOG2_PAGE_SIZE);
+    last_n_vpn = this->_last_n_vpn.signature();
 }
 
 void cc::offchip_predictor_perceptron::dump_stats() const {
@@ -3,7 +3,7 @@
 
 #include <cstdint>
 #
-#include <deque>
+#include <array>
 #include <vector>
 #
 #include <internals/bitmap.h>
@@ -44,12 +44,51 @@ enum perceptron_feature_type {
 
 struct page_buffer_entry {
    public:
+    bool valid;
     uint64_t page;
     Bitmap bmp_access;
     uint32_t age;
 
    public:
-    page_buffer_entry() = default;
+    page_buffer_entry() : valid(false), page(0), age(0) {}
+};
+
+/**
+ * @brief Fixed-capacity history of the last N values, oldest first. Pushing
+ * into a full history overwrites the oldest value.
+ */
+template <typename T, std::size_t N>
+struct history_ring {
+   public:
+    std::array<T, N> values;
+    std::size_t head, size;
+
+   public:
+    history_ring() : values(), head(0), size(0) {}
+
+    void push(const T &v) {
+        values[(head + size) % N] = v;
+
+        if (size < N)
+            size++;
+        else
+            head = (head + 1) % N;
+    }
+
+    /**
+     * @brief Folds the history, oldest value first, into a signature by
+     * shifting and xoring each value in.
+     */
+    uint64_t signature() const {
+        uint64_t sig = 0ULL;
+
+        for (std::size_t i = 0; i < size; i++) {
+            sig <<= 1;
+            sig ^= values[(head + i) % N];
+        }
+
+        return sig;
+    }
 };
 
 struct perceptron_feature {
@@ -464,14 +503,22 @@ class perceptron_predictor {
 };
 
 class offchip_predictor_perceptron {
+   public:
+    // The geometry of the page buffers and the length of the histories are
+    // the ones of the original predictor, fixed so that they can be laid out
+    // as flat arrays.
+    static constexpr std::size_t page_buffer_sets = 64, page_buffer_ways = 16,
+                                 history_length = 4;
+
+    using page_buffer_set = std::array<page_buffer_entry, page_buffer_ways>;
+    using page_buffer = std::array<page_buffer_set, page_buffer_sets>;
+
    private:
     uint64_t _cpu;
     uint64_t _true_pos, _false_pos, _true_neg, _false_neg, _true_pos_pf,
         _false_pos_pf, _true_neg_pf, _false_neg_pf, _miss_hit_l1d, _miss_hit_l2c;
-    std::size_t _page_buffer_sets, _page_buffer_ways, _pf_page_buffer_sets,
-        _pf_page_buffer_ways;
-    std::deque<uint64_t> _last_n_load_pc, _last_n_vpn;
-    std::vector<std::deque<page_buffer_entry *>> _page_buffer, _pf_page_buffer;
+    history_ring<uint64_t, history_length> _last_n_load_pc, _last_n_vpn;
+    page_buffer _page_buffer, _pf_page_buffer;
     perceptron_predictor *_pred, *_pf_pred;
 
     float _tau_1, _tau_2;
@@ -489,6 +536,10 @@ class offchip_predictor_perceptron {
                                      const uint64_t &vpage,
                                      const uint32_t voffset,
                                      bool &first_access);
+    static void _lookup_page_buffer(page_buffer_set &set,
+                                    const uint64_t &vpage,
+                                    const uint32_t voffset,
+                                    bool &first_access);
     uint32_t _get_set(const uint64_t &vpage) const;
     void _get_control_flow_signatures(LSQ_ENTRY *lq_entry,
                                       uint64_t &last_n_load_pc_sig,
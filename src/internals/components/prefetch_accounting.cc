@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <ios>
+#include <iterator>
+#include <stdexcept>
+#
+#include <internals/components/cache.hh>
+#include <internals/components/prefetch_accounting.hh>
+
+namespace cc = champsim::components;
+
+static const char* level_name(int32_t level) {
+    switch (level) {
+        case cc::cache::fill_l1:
+            return "L1";
+        case cc::cache::fill_l2:
+            return "L2C";
+        case cc::cache::fill_llc:
+            return "LLC";
+        case cc::cache::fill_drc:
+            return "DRC";
+        case cc::cache::fill_dram:
+            return "DRAM";
+        default:
+            return "OTHER";
+    }
+}
+
+void cc::prefetch_accounting::init(const pt::ptree& props,
+                                   std::size_t blocks) {
+    this->_desc.enabled = props.get<bool>("enabled", this->_desc.enabled);
+    this->_desc.entries =
+        props.get<std::size_t>("entries", this->_desc.entries);
+    this->_desc.eviction_filter_bits = props.get<uint32_t>(
+        "eviction_filter_bits", this->_desc.eviction_filter_bits);
+
+    if (this->_desc.entries == 0)
+        throw std::runtime_error("The prefetch accounting table is empty.");
+
+    if (this->_desc.eviction_filter_bits > 24)
+        throw std::runtime_error("The prefetch eviction filter is too large.");
+
+    if (!this->_desc.enabled) return;
+
+    this->_table.assign(this->_desc.entries, entry());
+    this->_blocks.assign(blocks, block_tag());
+    this->_evictions.assign(1ULL << this->_desc.eviction_filter_bits,
+                            eviction());
+}
+
+cc::prefetch_accounting::entry* cc::prefetch_accounting::_find(
+    const origin& key) {
+    for (entry& e : this->_table) {
+        if (e.valid && e.key == key) return &e;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Returns the entry of an origin, taking over the lightest entry when
+ * the table is full. The newcomer inherits its weight, so that an origin
+ * issuing often enough always ends up in the table.
+ */
+cc::prefetch_accounting::entry& cc::prefetch_accounting::_insert(
+    const origin& key) {
+    entry* e = this->_find(key);
+
+    if (e != nullptr) return *e;
+
+    e = &*std::min_element(this->_table.begin(), this->_table.end(),
+                           [](const entry& a, const entry& b) {
+                               return (a.valid ? a.weight + 1 : 0) <
+                                      (b.valid ? b.weight + 1 : 0);
+                           });
+
+    uint64_t weight = e->valid ? e->weight : 0;
+
+    *e = entry();
+    e->key = key;
+    e->valid = true;
+    e->weight = weight;
+
+    return *e;
+}
+
+cc::prefetch_accounting::eviction& cc::prefetch_accounting::_eviction(
+    uint64_t block) {
+    uint64_t hash = block ^ (block >> this->_desc.eviction_filter_bits);
+
+    return this->_evictions[hash & (this->_evictions.size() - 1)];
+}
+
+void cc::prefetch_accounting::fill(std::size_t index, uint64_t block,
+                                   bool prefetch, bool demand,
+                                   const origin& key, uint64_t cycle,
+                                   bool victim_valid, uint64_t victim) {
+    block_tag& tag = this->_blocks[index];
+
+    if (victim_valid) {
+        if (tag.prefetch) {
+            // Evicted before any demand, it was useless or too early.
+            if (entry* e = this->_find(tag.key)) e->useless++;
+
+            this->_eviction(victim) = {true, true, victim, tag.key};
+        } else if (prefetch) {
+            this->_eviction(victim) = {true, false, victim, key};
+        }
+    }
+
+    if (demand) {
+        eviction& ev = this->_eviction(block);
+
+        if (ev.valid && ev.block == block) {
+            if (entry* e = this->_find(ev.key)) {
+                if (ev.early)
+                    e->early++;
+                else
+                    e->pollution++;
+            }
+
+            ev.valid = false;
+        }
+    }
+
+    tag.prefetch = prefetch;
+
+    if (prefetch) {
+        entry& e = this->_insert(key);
+
+        e.weight++;
+        e.fills++;
+
+        tag.key = key;
+        tag.fill_cycle = cycle;
+    }
+}
+
+void cc::prefetch_accounting::hit(std::size_t index, uint64_t cycle) {
+    block_tag& tag = this->_blocks[index];
+
+    if (!tag.prefetch) return;
+
+    if (entry* e = this->_find(tag.key)) {
+        e->on_time++;
+        e->lead_cycles += cycle - tag.fill_cycle;
+    }
+
+    tag.prefetch = false;
+}
+
+void cc::prefetch_accounting::late(const origin& key) {
+    entry& e = this->_insert(key);
+
+    e.weight++;
+    e.late++;
+}
+
+void cc::prefetch_accounting::reset_stats() {
+    std::fill(this->_table.begin(), this->_table.end(), entry());
+}
+
+void cc::prefetch_accounting::dump_stats(std::ostream& os) const {
+    std::vector<entry> entries;
+
+    std::copy_if(this->_table.begin(), this->_table.end(),
+                 std::back_inserter(entries),
+                 [](const entry& e) { return e.valid; });
+    std::sort(entries.begin(), entries.end(),
+              [](const entry& a, const entry& b) {
+                  return a.weight > b.weight;
+              });
+
+    os << "pf_accounting origins: " << entries.size() << std::endl;
+
+    for (const entry& e : entries) {
+        os << "pf_accounting origin: " << level_name(e.key.origin_level)
+           << " component: " << e.key.component
+           << " fill_level: " << level_name(e.key.fill_level) << " ip: 0x"
+           << std::hex << e.key.ip << std::dec << " fills: " << e.fills
+           << " on_time: " << e.on_time << " late: " << e.late
+           << " early: " << e.early << " useless: " << e.useless
+           << " pollution: " << e.pollution << " avg_lead: "
+           << ((e.on_time == 0)
+                   ? 0.0
+                   : static_cast<double>(e.lead_cycles) / e.on_time)
+           << std::endl;
+    }
+
+    os << std::endl;
+}
@@ -0,0 +1,105 @@
+#ifndef __CHAMPSIM_INTERNALS_COMPONENTS_PREFETCH_ACCOUNTING_HH__
+#define __CHAMPSIM_INTERNALS_COMPONENTS_PREFETCH_ACCOUNTING_HH__
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#
+#include <boost/property_tree/ptree.hpp>
+
+namespace pt = boost::property_tree;
+
+namespace champsim {
+namespace components {
+/**
+ * @brief Accounting of the prefetches filled in a cache, broken down by the
+ * prefetcher that issued them (its fill level, and its component when it runs
+ * in a composite prefetcher), the PC that triggered them and the level they
+ * were meant to fill.
+ *
+ * A prefetch is on time when a demand hits its block, late when a demand miss
+ * merges with it in the MSHR and early when its block is evicted unused and
+ * then missed by a demand. A demand miss to a block evicted by a prefetch fill
+ * is charged as pollution to that prefetch. Evictions are remembered in a
+ * direct-mapped filter. Only the heaviest origins are kept, in a table of
+ * bounded size maintained with the space-saving algorithm.
+ */
+class prefetch_accounting {
+   public:
+    struct descriptor {
+        bool enabled = false;
+
+        // entries of the top-K table
+        std::size_t entries = 16;
+
+        // log2 of the number of evictions remembered
+        uint32_t eviction_filter_bits = 10;
+    };
+
+    struct origin {
+        uint64_t ip = 0;
+        int32_t origin_level = 0, fill_level = 0;
+        uint32_t component = 0;
+
+        bool operator==(const origin& o) const {
+            return this->ip == o.ip && this->origin_level == o.origin_level &&
+                   this->fill_level == o.fill_level &&
+                   this->component == o.component;
+        }
+    };
+
+    struct entry {
+        origin key;
+        bool valid = false;
+
+        // prefetches seen by the space-saving algorithm, overestimated by the
+        // weight of the entry it replaced
+        uint64_t weight = 0;
+
+        uint64_t fills = 0, on_time = 0, late = 0, early = 0, useless = 0,
+                 pollution = 0, lead_cycles = 0;
+    };
+
+   private:
+    // prefetch tag of a block of the cache
+    struct block_tag {
+        bool prefetch = false;
+        origin key;
+        uint64_t fill_cycle = 0;
+    };
+
+    // block evicted by or in spite of a prefetch
+    struct eviction {
+        bool valid = false, early = false;
+        uint64_t block = 0;
+        origin key;
+    };
+
+    descriptor _desc;
+
+    std::vector<entry> _table;
+    std::vector<block_tag> _blocks;
+    std::vector<eviction> _evictions;
+
+    entry* _find(const origin& key);
+    entry& _insert(const origin& key);
+    eviction& _eviction(uint64_t block);
+
+   public:
+    void init(const pt::ptree& props, std::size_t blocks);
+
+    bool enabled() const { return this->_desc.enabled; }
+
+    void fill(std::size_t index, uint64_t block, bool prefetch, bool demand,
+              const origin& key, uint64_t cycle, bool victim_valid,
+              uint64_t victim);
+    void hit(std::size_t index, uint64_t cycle);
+    void late(const origin& key);
+
+    void reset_stats();
+    void dump_stats(std::ostream& os) const;
+};
+}  // namespace components
+}  // namespace champsim
+
+#endif  // __CHAMPSIM_INTERNALS_COMPONENTS_PREFETCH_ACCOUNTING_HH__
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#
+#include <internals/components/prefetch_throttler.hh>
+
+namespace cc = champsim::components;
+
+cc::prefetch_throttler::prefetch_throttler()
+    : _level(0),
+      _fills(0),
+      _pf_fills(0),
+      _pf_useful(0),
+      _pf_late(0),
+      _demand_misses(0),
+      _pollution_misses(0),
+      _epoch_cycle(0),
+      _epoch_dram_busy(0),
+      _epochs(0),
+      _increments(0),
+      _decrements(0),
+      _bandwidth_bound(0) {}
+
+void cc::prefetch_throttler::init(const pt::ptree& props) {
+    this->_desc.enabled = props.get<bool>("enabled", this->_desc.enabled);
+    this->_desc.epoch = props.get<uint64_t>("epoch", this->_desc.epoch);
+    this->_desc.accuracy_high =
+        props.get<float>("accuracy.high", this->_desc.accuracy_high);
+    this->_desc.accuracy_low =
+        props.get<float>("accuracy.low", this->_desc.accuracy_low);
+    this->_desc.lateness = props.get<float>("lateness", this->_desc.lateness);
+    this->_desc.pollution =
+        props.get<float>("pollution", this->_desc.pollution);
+    this->_desc.bandwidth =
+        props.get<float>("bandwidth", this->_desc.bandwidth);
+    this->_desc.pollution_filter_bits = props.get<uint32_t>(
+        "pollution_filter_bits", this->_desc.pollution_filter_bits);
+
+    if (auto scales = props.get_child_optional("scales")) {
+        this->_desc.scales.clear();
+
+        for (const auto& e : *scales)
+            this->_desc.scales.push_back(e.second.get_value<float>());
+    }
+
+    if (this->_desc.epoch == 0)
+        throw std::runtime_error("The throttling epoch cannot be empty.");
+
+    if (this->_desc.scales.empty() ||
+        !std::is_sorted(this->_desc.scales.begin(), this->_desc.scales.end()))
+        throw std::runtime_error(
+            "The throttling scales must be given in increasing order.");
+
+    if (this->_desc.pollution_filter_bits > 24)
+        throw std::runtime_error("The pollution filter is too large.");
+
+    // starting on the step the closest to the configured aggressiveness
+    this->_level =
+        std::min_element(this->_desc.scales.begin(), this->_desc.scales.end(),
+                         [](float a, float b) {
+                             return std::fabs(a - 1.0f) < std::fabs(b - 1.0f);
+                         }) -
+        this->_desc.scales.begin();
+
+    this->_pollution_filter.assign(1ULL << this->_desc.pollution_filter_bits,
+                                   false);
+    this->_epochs_per_level.assign(this->_desc.scales.size(), 0);
+}
+
+std::size_t cc::prefetch_throttler::_filter_index(uint64_t block) const {
+    return (block ^ (block >> this->_desc.pollution_filter_bits)) &
+           (this->_pollution_filter.size() - 1);
+}
+
+bool cc::prefetch_throttler::fill(uint64_t block, bool prefetch, bool demand,
+                                  bool victim_valid, uint64_t victim) {
+    if (prefetch) {
+        this->_pf_fills++;
+
+        // the block is back in the cache, only its victim can now be missed
+        this->_pollution_filter[this->_filter_index(block)] = false;
+
+        if (victim_valid)
+            this->_pollution_filter[this->_filter_index(victim)] = true;
+    } else if (demand) {
+        std::vector<bool>::reference evicted_by_prefetch =
+            this->_pollution_filter[this->_filter_index(block)];
+
+        this->_demand_misses++;
+
+        if (evicted_by_prefetch) this->_pollution_misses++;
+
+        evicted_by_prefetch = false;
+    }
+
+    return (++this->_fills == this->_desc.epoch);
+}
+
+/**
+ * @brief Classifies the prefetches of the epoch and steps the aggressiveness
+ * as in feedback-directed prefetching. Accurate prefetches are pushed further
+ * when late and held back when polluting, inaccurate ones are only held back.
+ * Beyond the bandwidth threshold, prefetches that are not accurate cannot get
+ * more aggressive.
+ */
+bool cc::prefetch_throttler::adapt(uint64_t cycle, uint64_t dram_busy,
+                                   uint32_t dram_channels) {
+    float accuracy = (this->_pf_fills == 0)
+                         ? 1.0f
+                         : std::min(1.0f, static_cast<float>(this->_pf_useful) /
+                                              this->_pf_fills),
+          lateness = (this->_pf_useful + this->_pf_late == 0)
+                         ? 0.0f
+                         : static_cast<float>(this->_pf_late) /
+                               (this->_pf_useful + this->_pf_late),
+          pollution = (this->_demand_misses == 0)
+                          ? 0.0f
+                          : static_cast<float>(this->_pollution_misses) /
+                                this->_demand_misses,
+          bandwidth = (cycle <= this->_epoch_cycle || dram_channels == 0)
+                          ? 0.0f
+                          : static_cast<float>(dram_busy -
+                                               this->_epoch_dram_busy) /
+                                ((cycle - this->_epoch_cycle) * dram_channels);
+    bool late = (lateness > this->_desc.lateness),
+         polluting = (pollution > this->_desc.pollution);
+    int step = 0;
+    std::size_t level = this->_level;
+
+    if (accuracy >= this->_desc.accuracy_high) {
+        step = late ? 1 : (polluting ? -1 : 0);
+    } else if (accuracy >= this->_desc.accuracy_low) {
+        step = polluting ? -1 : (late ? 1 : 0);
+    } else {
+        step = (late || polluting) ? -1 : 0;
+    }
+
+    if (bandwidth > this->_desc.bandwidth &&
+        accuracy < this->_desc.accuracy_high && step >= 0) {
+        step = -1;
+        this->_bandwidth_bound++;
+    }
+
+    if (step > 0 && level + 1 < this->_desc.scales.size()) {
+        level++;
+        this->_increments++;
+    } else if (step < 0 && level > 0) {
+        level--;
+        this->_decrements++;
+    }
+
+    this->_epochs++;
+    this->_epochs_per_level[level]++;
+
+    // starting a new epoch
+    this->_fills = 0;
+    this->_pf_fills = 0;
+    this->_pf_useful = 0;
+    this->_pf_late = 0;
+    this->_demand_misses = 0;
+    this->_pollution_misses = 0;
+    this->_epoch_cycle = cycle;
+    this->_epoch_dram_busy = dram_busy;
+
+    std::swap(level, this->_level);
+
+    return (level != this->_level);
+}
+
+void cc::prefetch_throttler::reset_stats() {
+    this->_epochs = 0;
+    this->_increments = 0;
+    this->_decrements = 0;
+    this->_bandwidth_bound = 0;
+
+    std::fill(this->_epochs_per_level.begin(), this->_epochs_per_level.end(),
+              0);
+}
+
+void cc::prefetch_throttler::dump_stats(std::ostream& os) const {
+    os << "pf_throttling epochs: " << this->_epochs
+       << " increments: " << this->_increments
+       << " decrements: " << this->_decrements
+       << " bandwidth_bound: " << this->_bandwidth_bound
+       << " scale: " << this->scale() << std::endl
+       << "pf_throttling epochs per scale:";
+
+    for (std::size_t i = 0; i < this->_desc.scales.size(); i++)
+        os << " " << this->_desc.scales[i] << ": " << this->_epochs_per_level[i];
+
+    os << std::endl << std::endl;
+}
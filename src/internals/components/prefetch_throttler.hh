@@ -0,0 +1,86 @@
+#ifndef __CHAMPSIM_INTERNALS_COMPONENTS_PREFETCH_THROTTLER_HH__
+#define __CHAMPSIM_INTERNALS_COMPONENTS_PREFETCH_THROTTLER_HH__
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#
+#include <boost/property_tree/ptree.hpp>
+
+namespace pt = boost::property_tree;
+
+namespace champsim {
+namespace components {
+/**
+ * @brief Feedback-directed throttling of the prefetcher of a cache. At the end
+ * of each epoch, the accuracy, lateness and pollution of the prefetches, along
+ * with the DRAM bandwidth utilization, move the prefetcher one step up or down
+ * a ladder of aggressiveness scales. The prefetcher applies the scale to its
+ * degree or distance.
+ *
+ * A prefetch is late when a demand miss merges with it in the MSHR, and a
+ * demand miss is caused by pollution when its block was evicted by a prefetch
+ * fill, as recorded in a small bit-vector filter.
+ */
+class prefetch_throttler {
+   public:
+    struct descriptor {
+        bool enabled = false;
+
+        // cache fills per epoch
+        uint64_t epoch = 8192;
+
+        // accuracy above which prefetches are accurate and below which they
+        // are inaccurate, ratios of late and polluting prefetches above which
+        // prefetches are late or polluting, and DRAM bandwidth utilization
+        // above which inaccurate prefetches are held back
+        float accuracy_high = 0.75f, accuracy_low = 0.40f, lateness = 0.01f,
+              pollution = 0.005f, bandwidth = 0.75f;
+
+        // aggressiveness ladder, the prefetcher starts on the step scaled by 1
+        std::vector<float> scales{0.25f, 0.5f, 1.0f, 1.5f, 2.0f};
+
+        // log2 of the size of the pollution filter
+        uint32_t pollution_filter_bits = 12;
+    };
+
+   private:
+    descriptor _desc;
+    std::size_t _level;
+
+    // counters of the current epoch
+    uint64_t _fills, _pf_fills, _pf_useful, _pf_late, _demand_misses,
+        _pollution_misses;
+    uint64_t _epoch_cycle, _epoch_dram_busy;
+
+    std::vector<bool> _pollution_filter;
+
+    uint64_t _epochs, _increments, _decrements, _bandwidth_bound;
+    std::vector<uint64_t> _epochs_per_level;
+
+    std::size_t _filter_index(uint64_t block) const;
+
+   public:
+    prefetch_throttler();
+
+    void init(const pt::ptree& props);
+
+    bool enabled() const { return this->_desc.enabled; }
+    float scale() const { return this->_desc.scales[this->_level]; }
+
+    // Returns true when the fill ends the epoch.
+    bool fill(uint64_t block, bool prefetch, bool demand, bool victim_valid,
+              uint64_t victim);
+    void useful() { this->_pf_useful++; }
+    void late() { this->_pf_late++; }
+
+    // Ends the epoch, returns true when the aggressiveness changed.
+    bool adapt(uint64_t cycle, uint64_t dram_busy, uint32_t dram_channels);
+
+    void reset_stats();
+    void dump_stats(std::ostream& os) const;
+};
+}  // namespace components
+}  // namespace champsim
+
+#endif  // __CHAMPSIM_INTERNALS_COMPONENTS_PREFETCH_THROTTLER_HH__
@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#
+#include <internals/champsim.h>
+#include <internals/components/recent_prefetch_filter.hh>
+
+namespace cc = champsim::components;
+
+static std::map<std::string, cc::recent_prefetch_filter::filter_types>
+    filter_type_map = {
+        {"off", cc::recent_prefetch_filter::off},
+        {"bloom", cc::recent_prefetch_filter::bloom},
+        {"quotient", cc::recent_prefetch_filter::quotient},
+};
+
+cc::recent_prefetch_filter::recent_prefetch_filter()
+    : _insertions(0), _filtered_recent(0), _filtered_resident(0) {}
+
+void cc::recent_prefetch_filter::init(const pt::ptree& props) {
+    std::string type = props.get<std::string>("type", "off");
+    std::map<std::string, filter_types>::iterator type_it;
+
+    if ((type_it = filter_type_map.find(type)) == filter_type_map.end()) {
+        throw std::runtime_error("Unknown prefetch filter type \"" + type +
+                                 "\".");
+    }
+
+    this->_desc.type = type_it->second;
+    this->_desc.bits = props.get<uint32_t>("bits", this->_desc.bits);
+    this->_desc.hashes = props.get<uint32_t>("hashes", this->_desc.hashes);
+    this->_desc.window = props.get<uint64_t>("window", this->_desc.window);
+    this->_desc.remainder_bits =
+        props.get<uint32_t>("remainder_bits", this->_desc.remainder_bits);
+    this->_desc.probe_tags =
+        props.get<bool>("probe_tags", this->_desc.probe_tags);
+
+    if (this->_desc.bits == 0 || this->_desc.bits > 24)
+        throw std::runtime_error("The prefetch filter size is out of range.");
+
+    if (this->_desc.type == bloom &&
+        (this->_desc.hashes == 0 || this->_desc.window == 0))
+        throw std::runtime_error(
+            "The Bloom prefetch filter needs hashes and a window.");
+
+    if (this->_desc.type == quotient &&
+        (this->_desc.remainder_bits == 0 || this->_desc.remainder_bits > 15))
+        throw std::runtime_error(
+            "The quotient prefetch filter remainders are out of range.");
+
+    this->_current.clear();
+    this->_previous.clear();
+    this->_slots.clear();
+
+    if (this->_desc.type == bloom) {
+        this->_current.assign(1ULL << this->_desc.bits, false);
+        this->_previous.assign(1ULL << this->_desc.bits, false);
+    } else if (this->_desc.type == quotient) {
+        this->_slots.assign(1ULL << this->_desc.bits, 0);
+    }
+}
+
+/**
+ * @brief Double hashing, the i-th bit of a block is (h1 + i * h2) modulo the
+ * size of a generation.
+ */
+void cc::recent_prefetch_filter::_bloom_indices(uint64_t block, uint64_t& h1,
+                                                uint64_t& h2) const {
+    uint64_t h = jenkins_hash(block);
+
+    h1 = h;
+    h2 = (h >> 32) | 1ULL;
+}
+
+void cc::recent_prefetch_filter::_quotient_slot(uint64_t block,
+                                                std::size_t& slot,
+                                                uint16_t& remainder) const {
+    uint64_t h = jenkins_hash(block);
+
+    slot = h & (this->_slots.size() - 1);
+    remainder = ((h >> this->_desc.bits) &
+                 ((1ULL << this->_desc.remainder_bits) - 1ULL)) +
+                1;
+}
+
+bool cc::recent_prefetch_filter::contains(uint64_t block) const {
+    if (this->_desc.type == bloom) {
+        uint64_t h1, h2, mask = this->_current.size() - 1;
+        bool current = true, previous = true;
+
+        this->_bloom_indices(block, h1, h2);
+
+        for (uint32_t i = 0; i < this->_desc.hashes && (current || previous);
+             i++) {
+            std::size_t idx = (h1 + i * h2) & mask;
+
+            current = current && this->_current[idx];
+            previous = previous && this->_previous[idx];
+        }
+
+        return current || previous;
+    } else if (this->_desc.type == quotient) {
+        std::size_t slot;
+        uint16_t remainder;
+
+        this->_quotient_slot(block, slot, remainder);
+
+        return (this->_slots[slot] == remainder);
+    }
+
+    return false;
+}
+
+void cc::recent_prefetch_filter::insert(uint64_t block) {
+    if (this->_desc.type == bloom) {
+        uint64_t h1, h2, mask = this->_current.size() - 1;
+
+        // Retiring the older generation.
+        if (this->_insertions++ == this->_desc.window) {
+            this->_current.swap(this->_previous);
+            std::fill(this->_current.begin(), this->_current.end(), false);
+            this->_insertions = 1;
+        }
+
+        this->_bloom_indices(block, h1, h2);
+
+        for (uint32_t i = 0; i < this->_desc.hashes; i++)
+            this->_current[(h1 + i * h2) & mask] = true;
+    } else if (this->_desc.type == quotient) {
+        std::size_t slot;
+        uint16_t remainder;
+
+        this->_quotient_slot(block, slot, remainder);
+
+        this->_slots[slot] = remainder;
+    }
+}
+
+void cc::recent_prefetch_filter::reset_stats() {
+    this->_filtered_recent = 0;
+    this->_filtered_resident = 0;
+}
+
+void cc::recent_prefetch_filter::dump_stats(std::ostream& os) const {
+    os << "pf_filtered recent: " << this->_filtered_recent
+       << " resident: " << this->_filtered_resident << std::endl
+       << std::endl;
+}
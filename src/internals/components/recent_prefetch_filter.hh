@@ -0,0 +1,84 @@
+#ifndef __CHAMPSIM_INTERNALS_COMPONENTS_RECENT_PREFETCH_FILTER_HH__
+#define __CHAMPSIM_INTERNALS_COMPONENTS_RECENT_PREFETCH_FILTER_HH__
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#
+#include <boost/property_tree/ptree.hpp>
+
+namespace pt = boost::property_tree;
+
+namespace champsim {
+namespace components {
+/**
+ * @brief Remembers the blocks prefetched recently by a cache, so that
+ * duplicate requests are dropped before a prefetch packet is built and pushed
+ * to the prefetch queue.
+ *
+ * The Bloom flavour sets hashes bits per block in the current of two
+ * generations of bits, both of which are looked up, and retires the older one
+ * every window insertions. The quotient flavour stores the remainder of the
+ * hash of each block in the slot indexed by its quotient, a newer block
+ * evicting the older one. Either may report false positives, never false
+ * negatives for the blocks it still holds.
+ */
+class recent_prefetch_filter {
+   public:
+    enum filter_types { off, bloom, quotient };
+
+    struct descriptor {
+        filter_types type = off;
+
+        // log2 of the number of bits (bloom) or slots (quotient)
+        uint32_t bits = 12;
+
+        // bloom: hash functions and insertions per generation
+        uint32_t hashes = 2;
+        uint64_t window = 1024;
+
+        // quotient: bits of the remainders
+        uint32_t remainder_bits = 12;
+
+        // whether the tag array is probed for the block as well
+        bool probe_tags = false;
+    };
+
+   private:
+    descriptor _desc;
+
+    std::vector<bool> _current, _previous;
+    uint64_t _insertions;
+
+    // remainders, offset by one so that zero stands for an empty slot
+    std::vector<uint16_t> _slots;
+
+    uint64_t _filtered_recent, _filtered_resident;
+
+    void _bloom_indices(uint64_t block, uint64_t& h1, uint64_t& h2) const;
+    void _quotient_slot(uint64_t block, std::size_t& slot,
+                        uint16_t& remainder) const;
+
+   public:
+    recent_prefetch_filter();
+
+    void init(const pt::ptree& props);
+
+    bool enabled() const {
+        return this->_desc.type != off || this->_desc.probe_tags;
+    }
+    bool probe_tags() const { return this->_desc.probe_tags; }
+
+    bool contains(uint64_t block) const;
+    void insert(uint64_t block);
+
+    void filtered_recent() { this->_filtered_recent++; }
+    void filtered_resident() { this->_filtered_resident++; }
+
+    void reset_stats();
+    void dump_stats(std::ostream& os) const;
+};
+}  // namespace components
+}  // namespace champsim
+
+#endif  // __CHAMPSIM_INTERNALS_COMPONENTS_RECENT_PREFETCH_FILTER_HH__
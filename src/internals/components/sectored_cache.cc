@@ -229,6 +229,23 @@ bool cc::sectored_cache::is_valid(const uint32_t& set, const uint16_t& way) {
     return this->_is_sector_valid(set, way);
 }
 
+/**
+ * @brief Tells if the block holding an address is valid, whatever the state of
+ * the other blocks of its sector.
+ */
+bool cc::sectored_cache::is_block_valid(const uint64_t& addr) const {
+    uint32_t set = this->get_set(addr), block = this->get_block(addr);
+    tag_type tag = this->_get_tag(addr);
+
+    for (std::size_t i = 0; i < this->_associativity_degree; i++) {
+        if (this->_tags[set][i] == tag && this->_valid_bits[set][i][block]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void cc::sectored_cache::invalidate_line(const uint64_t& full_addr) {
     uint32_t set = this->get_set(full_addr);
     uint16_t way = this->get_way(full_addr, set);
@@ -277,6 +294,14 @@ void cc::sectored_cache::_init_cache_impl(const pt::ptree& props) {
         data_set_array(this->_associativity_degree * this->_sectoring_degree,
                        BLOCK()));
 
+    // The prefetch accounting, if any, tags every block of the data array.
+    if (auto accounting = props.get_child_optional("pf_accounting")) {
+        this->_pf_accounting.init(*accounting,
+                                  this->_set_degree *
+                                      this->_associativity_degree *
+                                      this->_sectoring_degree);
+    }
+
     // The tag array is made up of one tag per sector.
     this->_tags = tag_array(this->_set_degree,
                             tag_set_array(this->_associativity_degree, 0x0));
@@ -394,6 +419,14 @@ bool cc::sectored_cache::_is_sector_valid(const uint32_t& set,
             this->_valid_bits[set][way].size());
 }
 
+/**
+ * @brief Flattens the position of a block of the data array.
+ */
+std::size_t cc::sectored_cache::_block_index(const uint32_t& set,
+                                             const std::size_t& block) const {
+    return set * this->_associativity_degree * this->_sectoring_degree + block;
+}
+
 /**
  * @brief Tells if any blocks in the sector pointed by this packet are valid.
  * @param packet A packet that corresponds to a memory request.
@@ -535,6 +568,33 @@ void cc::sectored_cache::_fill_cache(const uint32_t& set, const uint16_t& way,
         throw std::logic_error("Cannot fill a TLB entry with an empty packet.");
     }
 
+    if (this->_throttler.enabled()) {
+        this->_throttle_on_fill(
+            packet, this->_is_sector_valid(set, way),
+            this->_blocks[set][this->_sectoring_degree * way].address);
+    }
+
+    // Every block of the sector is tagged, as hits are accounted on the block
+    // they touch.
+    if (this->_pf_accounting.enabled()) {
+        bool victim_valid = this->_is_sector_valid(set, way);
+
+        for (std::size_t i = 0; i < this->_sectoring_degree; i++) {
+            this->_pf_accounting.fill(
+                this->_block_index(set, this->_sectoring_degree * way + i),
+                packet.address, packet.type == cc::cache::prefetch,
+                (packet.type == cc::cache::load ||
+                 packet.type == cc::cache::rfo),
+                {packet.ip, packet.pf_origin_level, packet.fill_level,
+                 packet.pf_component},
+                champsim::simulator::instance()
+                    ->modeled_cpu(packet.cpu)
+                    ->current_core_cycle(),
+                victim_valid,
+                this->_blocks[set][this->_sectoring_degree * way + i].address);
+        }
+    }
+
     // Working with the usage footprints. We only care about these when it comes
     // from the SDC and the sector is valid.
     if (this->check_type(cc::is_sdc) && this->_is_sector_valid(set, way)) {
@@ -549,6 +609,11 @@ void cc::sectored_cache::_fill_cache(const uint32_t& set, const uint16_t& way,
             this->_pf_useless_per_loc
                 [this->_blocks[set][this->_sectoring_degree * way + i]
                      .served_from]++;
+
+            if (this->_blocks[set][this->_sectoring_degree * way + i]
+                    .pf_cross_page) {
+                this->_pf_cross_page_useless++;
+            }
         }
 
         this->_blocks[set][this->_sectoring_degree * way + i].prefetch =
@@ -557,10 +622,19 @@ void cc::sectored_cache::_fill_cache(const uint32_t& set, const uint16_t& way,
                  : false);
         this->_blocks[set][this->_sectoring_degree * way + i].used = false;
 
+        this->_blocks[set][this->_sectoring_degree * way + i].pf_cross_page =
+            (this->_blocks[set][this->_sectoring_degree * way + i].prefetch &&
+             packet.pf_cross_page);
+
         if (this->_blocks[set][this->_sectoring_degree * way + i].prefetch) {
             this->_pf_fill++;
         }
 
+        if (this->_blocks[set][this->_sectoring_degree * way + i]
+                .pf_cross_page) {
+            this->_pf_cross_page_fill++;
+        }
+
         this->_blocks[set][this->_sectoring_degree * way + i].delta =
             packet.delta;
         this->_blocks[set][this->_sectoring_degree * way + i].signature =
@@ -1070,7 +1144,7 @@ void cc::sectored_cache::_handle_read() {
                             << this->log2_block_size();
                         p_desc.ip = curr_packet.ip;
 
-                        this->_prefetcher->operate(p_desc);
+                        this->_prefetcher_operate(p_desc);
                         break;
 
                     case cc::is_sdc:
@@ -1088,7 +1162,7 @@ void cc::sectored_cache::_handle_read() {
                             ~this->_offset_mask;
                         p_desc.ip = curr_packet.ip;
 
-                        this->_prefetcher->operate(p_desc);
+                        this->_prefetcher_operate(p_desc);
                         break;
 
                     case cc::is_l2c:
@@ -1111,7 +1185,7 @@ void cc::sectored_cache::_handle_read() {
                         // curr_packet.memory_size, true,
                         // static_cast<cc::cache::access_types>
                         // (curr_packet.type));
-                        this->_prefetcher->operate(p_desc);
+                        this->_prefetcher_operate(p_desc);
                         break;
 
                     case cc::is_llc:
@@ -1178,6 +1252,24 @@ void cc::sectored_cache::_handle_read() {
                 // WIP: Here we take notes of the location from which the
                 // prefetch was served (L2C, LLC, DRAM?).
                 this->_pf_useful_per_loc[this->_blocks[set][way].served_from]++;
+                this->_throttler.useful();
+
+                if (this->_pf_accounting.enabled()) {
+                    this->_pf_accounting.hit(
+                        this->_block_index(
+                            set, this->_sectoring_degree * way +
+                                     ((curr_packet.full_addr &
+                                       (this->_sector_size - 1ULL)) >>
+                                      this->log2_block_size())),
+                        champsim::simulator::instance()
+                            ->modeled_cpu(curr_packet.cpu)
+                            ->current_core_cycle());
+                }
+
+                if (this->_blocks[set][way].pf_cross_page) {
+                    this->_pf_cross_page_useful++;
+                    this->_blocks[set][way].pf_cross_page = false;
+                }
 
                 this->_blocks[set][way].prefetch = 0;
             }
@@ -1351,7 +1443,7 @@ void cc::sectored_cache::_handle_read() {
                                           << this->log2_block_size();
                             p_desc.ip = curr_packet.ip;
 
-                            this->_prefetcher->operate(p_desc);
+                            this->_prefetcher_operate(p_desc);
                             break;
                         case cc::is_sdc:
                             p_desc.hit = false;
@@ -1366,7 +1458,7 @@ void cc::sectored_cache::_handle_read() {
                                 curr_packet.full_addr & ~this->_offset_mask;
                             p_desc.ip = curr_packet.ip;
 
-                            this->_prefetcher->operate(p_desc);
+                            this->_prefetcher_operate(p_desc);
                             break;
                         case cc::is_l2c:
                             p_desc.hit = false;
@@ -1385,7 +1477,7 @@ void cc::sectored_cache::_handle_read() {
                             // curr_packet.ip, curr_packet.memory_size, false,
                             // static_cast<cc::cache::access_types>
                             // (curr_packet.type));
-                            this->_prefetcher->operate(p_desc);
+                            this->_prefetcher_operate(p_desc);
                             break;
                         case cc::is_llc:
                             // this->_llc_prefetcher_operate (read_cpu,
@@ -78,6 +78,7 @@ namespace champsim {
 			virtual void invalidate_line (const uint64_t& full_addr) final;
 
 			virtual bool is_valid (const uint32_t& set, const uint16_t& way) override;
+			virtual bool is_block_valid (const uint64_t& addr) const override;
 
 			virtual uint32_t block_size () const final;
 
@@ -102,6 +103,8 @@ namespace champsim {
 			bool _is_sector_valid (const uint32_t& set, const uint16_t& way) const;
 			bool _is_sector_valid (const PACKET& packet) const;
 
+			std::size_t _block_index (const uint32_t& set, const std::size_t& block) const;
+
 			bool _is_sector_dirty (const uint32_t& set, const uint16_t& way) const;
 			bool _is_sector_dirty (const PACKET& packet) const;
 
@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+#
+#include <internals/champsim.h>
+#include <internals/simulator.hh>
+#
+#include <internals/ooo_cpu.h>
+#
+#include <internals/components/tlb.hh>
+
+namespace cc = champsim::components;
+
+cc::tlb_hierarchy::tlb::tlb()
+    : _sets(0), _ways(0), _stamp(0), latency(0), accesses(0), misses(0) {}
+
+cc::tlb_hierarchy::tlb::tlb(uint32_t sets, uint32_t ways, uint32_t latency)
+    : _sets(sets),
+      _ways(ways),
+      _tags(sets * ways, 0),
+      _lru(sets * ways, 0),
+      _stamp(0),
+      latency(latency),
+      accesses(0),
+      misses(0) {
+    if (sets == 0 || ways == 0)
+        throw std::runtime_error("A TLB must have at least one set and way.");
+}
+
+/**
+ * @brief Looks up a tag and promotes it to MRU on a hit. A null LRU stamp
+ * marks an invalid entry.
+ */
+bool cc::tlb_hierarchy::tlb::lookup(uint64_t tag) {
+    uint32_t base = ((tag >> 1) % this->_sets) * this->_ways;
+
+    for (uint32_t i = base; i < base + this->_ways; i++) {
+        if (this->_lru[i] != 0 && this->_tags[i] == tag) {
+            this->_lru[i] = ++this->_stamp;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool cc::tlb_hierarchy::tlb::contains(uint64_t tag) const {
+    uint32_t base = ((tag >> 1) % this->_sets) * this->_ways;
+
+    for (uint32_t i = base; i < base + this->_ways; i++) {
+        if (this->_lru[i] != 0 && this->_tags[i] == tag) return true;
+    }
+
+    return false;
+}
+
+void cc::tlb_hierarchy::tlb::fill(uint64_t tag) {
+    uint32_t base = ((tag >> 1) % this->_sets) * this->_ways, victim = base;
+
+    for (uint32_t i = base; i < base + this->_ways; i++) {
+        if (this->_lru[i] != 0 && this->_tags[i] == tag) {
+            victim = i;
+            break;
+        }
+
+        if (this->_lru[i] < this->_lru[victim]) victim = i;
+    }
+
+    this->_tags[victim] = tag;
+    this->_lru[victim] = ++this->_stamp;
+}
+
+void cc::tlb_hierarchy::tlb::invalidate(uint64_t tag) {
+    uint32_t base = ((tag >> 1) % this->_sets) * this->_ways;
+
+    for (uint32_t i = base; i < base + this->_ways; i++) {
+        if (this->_tags[i] == tag) this->_lru[i] = 0;
+    }
+}
+
+void cc::tlb_hierarchy::tlb::reset_stats() {
+    this->accesses = 0;
+    this->misses = 0;
+}
+
+cc::tlb_hierarchy::tlb_hierarchy(const descriptor& desc, uint32_t cpu)
+    : _desc(desc),
+      _cpu(cpu),
+      _itlb(desc.itlb.sets, desc.itlb.ways, desc.itlb.latency),
+      _dtlb(desc.dtlb.sets, desc.dtlb.ways, desc.dtlb.latency),
+      _stlb(desc.stlb.sets, desc.stlb.ways, desc.stlb.latency),
+      _walker_available(desc.walkers, 0),
+      _pending_instructions(0),
+      _pending_data(0),
+      _walks(0),
+      _walk_accesses(0),
+      _walk_cycles(0) {
+    if (desc.log2_page_size != LOG2_PAGE_SIZE && desc.log2_page_size != 21)
+        throw std::runtime_error("Only 4KB and 2MB pages are supported.");
+
+    if (desc.walkers == 0)
+        throw std::runtime_error("At least one page table walker is needed.");
+
+    // one page-walk cache per non-leaf level: PML4, PDPT and PD for 4KB
+    // pages, PML4 and PDPT for 2MB pages
+    uint32_t levels = (desc.log2_page_size == LOG2_PAGE_SIZE) ? 4 : 3;
+
+    for (uint32_t i = 0; i < levels - 1; i++)
+        this->_pwc.emplace_back(1, desc.pwc_entries, 0);
+}
+
+uint64_t cc::tlb_hierarchy::page_tag(uint64_t va) const {
+    return ((va >> this->_desc.log2_page_size) << 1) |
+           (this->_desc.log2_page_size != LOG2_PAGE_SIZE);
+}
+
+/**
+ * @brief Models a page walk requested at a given cycle and returns the cycle
+ * at which it completes. The walk starts from the deepest level found in the
+ * page-walk caches, once a walker is available.
+ */
+uint64_t cc::tlb_hierarchy::walk(uint64_t va, uint64_t cycle) {
+    uint64_t now = champsim::simulator::instance()
+                       ->modeled_cpu(this->_cpu)
+                       ->current_core_cycle();
+    uint32_t levels = this->_pwc.size() + 1, accesses = levels;
+
+    for (int32_t level = levels - 2; level >= 0; level--) {
+        uint64_t prefix = (va >> (39 - 9 * level)) << 1;
+
+        this->_pwc[level].accesses++;
+
+        if (this->_pwc[level].lookup(prefix)) {
+            accesses = levels - 1 - level;
+            break;
+        }
+
+        this->_pwc[level].misses++;
+    }
+
+    for (uint32_t level = 0; level < levels - 1; level++)
+        this->_pwc[level].fill((va >> (39 - 9 * level)) << 1);
+
+    auto walker = std::min_element(this->_walker_available.begin(),
+                                   this->_walker_available.end());
+    uint64_t start = std::max(cycle, *walker),
+             end = start + accesses * this->_desc.walk_level_latency;
+
+    if (start > now) this->_waiting_walks.push_back(start);
+
+    *walker = end;
+
+    this->_walks++;
+    this->_walk_accesses += accesses;
+    this->_walk_cycles += end - cycle;
+
+    return end;
+}
+
+/**
+ * @brief Resolves the physical page of a request through the simulated page
+ * table, only the first time a page is seen. The latency of the page table
+ * access is the one of the walk modeled here, the core is not stalled for it.
+ */
+uint64_t cc::tlb_hierarchy::translate(const PACKET& packet) {
+    auto it = this->_translations.find(packet.address);
+
+    if (it == this->_translations.end()) {
+        uint64_t pa =
+            va_to_pa(this->_cpu, packet.instr_id, packet.full_addr,
+                     packet.address, packet.instruction, true);
+
+        it = this->_translations.emplace(packet.address, pa >> LOG2_PAGE_SIZE)
+                 .first;
+    }
+
+    return it->second;
+}
+
+int cc::tlb_hierarchy::add_rq(PACKET* packet, bool instruction) {
+    tlb& l1 = instruction ? this->_itlb : this->_dtlb;
+    uint32_t& pending =
+        instruction ? this->_pending_instructions : this->_pending_data;
+    uint64_t tag = page_tag(packet->full_addr),
+             cycle = champsim::simulator::instance()
+                         ->modeled_cpu(this->_cpu)
+                         ->current_core_cycle(),
+             ready = cycle + l1.latency;
+    auto inflight = this->_inflight.find(tag);
+
+    if (pending >= (instruction ? this->_desc.itlb.queue_size
+                                : this->_desc.dtlb.queue_size))
+        return -2;
+
+    // a new walk is needed but there is no room left to queue it, the request
+    // will be replayed
+    if (inflight == this->_inflight.end() && !l1.contains(tag) &&
+        !this->_stlb.contains(tag) &&
+        this->_waiting_walks.size() >= this->_desc.walk_queue_size)
+        return -2;
+
+    l1.accesses++;
+
+    if (!l1.lookup(tag)) {
+        l1.misses++;
+        ready += this->_stlb.latency;
+        this->_stlb.accesses++;
+
+        if (!this->_stlb.lookup(tag)) {
+            this->_stlb.misses++;
+
+            if (inflight == this->_inflight.end()) {
+                inflight =
+                    this->_inflight.emplace(tag, walk(packet->full_addr, ready))
+                        .first;
+            }
+
+            this->_stlb.fill(tag);
+        }
+
+        l1.fill(tag);
+    }
+
+    // entries are filled when the walk starts, requests hitting them wait for
+    // its completion
+    if (inflight != this->_inflight.end())
+        ready = std::max(ready, inflight->second);
+
+    this->_pending.emplace(
+        ready, translation_request{packet->ip, packet->instr_id,
+                                   translate(*packet), packet->rob_index,
+                                   packet->lq_index, packet->sq_index,
+                                   packet->type, instruction});
+    pending++;
+
+    return -1;
+}
+
+int cc::tlb_hierarchy::add_instruction_rq(PACKET* packet) {
+    return add_rq(packet, true);
+}
+
+int cc::tlb_hierarchy::add_data_rq(PACKET* packet) {
+    return add_rq(packet, false);
+}
+
+/**
+ * @brief Looks up the translation of a prefetch crossing a page in the STLB,
+ * without touching its replacement state or its stats. On a miss, a page walk
+ * is started only if allowed and if there is room left to queue it.
+ */
+uint64_t cc::tlb_hierarchy::translate_prefetch(
+    uint64_t va, bool walk, prefetch_translations& outcome) {
+    uint64_t tag = page_tag(va),
+             ready = champsim::simulator::instance()
+                         ->modeled_cpu(this->_cpu)
+                         ->current_core_cycle() +
+                     this->_stlb.latency;
+    auto inflight = this->_inflight.find(tag);
+
+    if (inflight != this->_inflight.end()) {
+        outcome = prefetch_translation_joined_walk;
+        return std::max(ready, inflight->second);
+    }
+
+    if (this->_stlb.contains(tag)) {
+        outcome = prefetch_translation_stlb_hit;
+        return ready;
+    }
+
+    if (!walk || this->_waiting_walks.size() >= this->_desc.walk_queue_size) {
+        outcome = prefetch_translation_dropped;
+        return 0;
+    }
+
+    outcome = prefetch_translation_walked;
+    ready = this->_inflight.emplace(tag, this->walk(va, ready)).first->second;
+
+    this->_stlb.fill(tag);
+
+    return ready;
+}
+
+void cc::tlb_hierarchy::operate() {
+    uint64_t cycle = champsim::simulator::instance()
+                         ->modeled_cpu(this->_cpu)
+                         ->current_core_cycle();
+
+    // walks that obtained a walker
+    this->_waiting_walks.erase(
+        std::remove_if(this->_waiting_walks.begin(),
+                       this->_waiting_walks.end(),
+                       [cycle](uint64_t start) { return start <= cycle; }),
+        this->_waiting_walks.end());
+
+    for (auto it = this->_inflight.begin(); it != this->_inflight.end();) {
+        if (it->second <= cycle)
+            it = this->_inflight.erase(it);
+        else
+            it++;
+    }
+
+    // returning the completed translations to the core, in completion order
+    while (!this->_pending.empty() && this->_pending.begin()->first <= cycle) {
+        const translation_request& request = this->_pending.begin()->second;
+        PACKET_QUEUE& processed = request.instruction ? this->ITLB_PROCESSED
+                                                      : this->DTLB_PROCESSED;
+        PACKET packet;
+
+        if (processed.occupancy == processed.SIZE) break;
+
+        packet.cpu = this->_cpu;
+        packet.instruction = request.instruction;
+        packet.type = request.type;
+        packet.ip = request.ip;
+        packet.instr_id = request.instr_id;
+        packet.rob_index = request.rob_index;
+        packet.lq_index = request.lq_index;
+        packet.sq_index = request.sq_index;
+        packet.event_cycle = this->_pending.begin()->first;
+
+        if (request.instruction)
+            packet.instruction_pa = request.page;
+        else
+            packet.data_pa = request.page;
+
+        processed.add_queue(&packet);
+
+        if (request.instruction)
+            this->_pending_instructions--;
+        else
+            this->_pending_data--;
+
+        this->_pending.erase(this->_pending.begin());
+    }
+}
+
+/**
+ * @brief Drops a page evicted from the simulated page table. The page number
+ * is tagged with the CPU in its upper bits.
+ */
+void cc::tlb_hierarchy::invalidate(uint64_t vpage) {
+    uint64_t page = vpage & (UINT64_MAX >> lg2(NUM_CPUS)),
+             tag = page_tag(page << LOG2_PAGE_SIZE);
+
+    this->_translations.erase(page);
+
+    this->_itlb.invalidate(tag);
+    this->_dtlb.invalidate(tag);
+    this->_stlb.invalidate(tag);
+}
+
+void cc::tlb_hierarchy::reset_stats() {
+    this->_itlb.reset_stats();
+    this->_dtlb.reset_stats();
+    this->_stlb.reset_stats();
+
+    for (tlb& pwc : this->_pwc) pwc.reset_stats();
+
+    this->_walks = 0;
+    this->_walk_accesses = 0;
+    this->_walk_cycles = 0;
+}
+
+void cc::tlb_hierarchy::dump_stats(std::ostream& os) const {
+    const std::pair<const char*, const tlb*> levels[] = {
+        {"ITLB", &this->_itlb}, {"DTLB", &this->_dtlb}, {"STLB", &this->_stlb}};
+
+    for (const auto& e : levels) {
+        os << e.first << " TOTAL     ACCESS: " << std::setw(10)
+           << e.second->accesses << "  HIT: " << std::setw(10)
+           << (e.second->accesses - e.second->misses)
+           << "  MISS: " << std::setw(10) << e.second->misses << std::endl;
+    }
+
+    for (std::size_t i = 0; i < this->_pwc.size(); i++) {
+        os << "PWC L" << (4 - i) << "   ACCESS: "
+           << std::setw(10) << this->_pwc[i].accesses << "  HIT: "
+           << std::setw(10) << (this->_pwc[i].accesses - this->_pwc[i].misses)
+           << "  MISS: " << std::setw(10) << this->_pwc[i].misses << std::endl;
+    }
+
+    os << "PTW WALKS: " << std::setw(10) << this->_walks
+       << "  AVERAGE ACCESSES: "
+       << (this->_walks ? (1.0 * this->_walk_accesses) / this->_walks : 0.0)
+       << "  AVERAGE LATENCY: "
+       << (this->_walks ? (1.0 * this->_walk_cycles) / this->_walks : 0.0)
+       << " cycles" << std::endl;
+}
@@ -0,0 +1,144 @@
+#ifndef __CHAMPSIM_INTERNALS_COMPONENTS_TLB_HH__
+#define __CHAMPSIM_INTERNALS_COMPONENTS_TLB_HH__
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#
+#include <internals/block.h>
+#include <internals/cache.h>
+
+namespace champsim {
+namespace components {
+/**
+ * @brief Timing model of the address translation of a core: an ITLB and a
+ * DTLB backed by a unified STLB, a page-walk cache and a bounded pool of page
+ * table walkers. TLB entries only hold tags, the translations themselves come
+ * from the simulated page table (va_to_pa) and are memoized per 4KB page.
+ *
+ * It replaces the ITLB, DTLB and STLB instances of the CACHE class when the
+ * "tlb.model" key of a core is set to "lightweight".
+ */
+class tlb_hierarchy {
+   public:
+    // How the translation of a prefetch was obtained.
+    enum prefetch_translations {
+        prefetch_translation_dropped = 0,
+        prefetch_translation_stlb_hit = 1,
+        prefetch_translation_joined_walk = 2,
+        prefetch_translation_walked = 3,
+    };
+
+    struct level_descriptor {
+        uint32_t sets, ways, latency, queue_size;
+    };
+
+    struct descriptor {
+        level_descriptor itlb{ITLB_SET, ITLB_WAY, ITLB_LATENCY, ITLB_RQ_SIZE},
+            dtlb{DTLB_SET, DTLB_WAY, DTLB_LATENCY, DTLB_RQ_SIZE},
+            stlb{STLB_SET, STLB_WAY, STLB_LATENCY, STLB_RQ_SIZE};
+
+        // 4KB or 2MB pages
+        uint32_t log2_page_size = LOG2_PAGE_SIZE;
+
+        // page-walk cache entries for each non-leaf level of the page table
+        uint32_t pwc_entries = 16;
+
+        // concurrent page walks, walks waiting for a walker and latency of
+        // each memory access of a walk
+        uint32_t walkers = 2, walk_queue_size = 8, walk_level_latency = 30;
+    };
+
+    /**
+     * @brief A set-associative array of tags with LRU replacement. Tags
+     * encode the page size so that 4KB and 2MB entries can share a level.
+     */
+    class tlb {
+       private:
+        uint32_t _sets, _ways;
+        std::vector<uint64_t> _tags, _lru;
+        uint64_t _stamp;
+
+       public:
+        uint32_t latency;
+        uint64_t accesses, misses;
+
+        tlb();
+        tlb(uint32_t sets, uint32_t ways, uint32_t latency);
+
+        bool lookup(uint64_t tag), contains(uint64_t tag) const;
+        void fill(uint64_t tag), invalidate(uint64_t tag);
+
+        void reset_stats();
+    };
+
+   private:
+    // what the core reads back from a completed translation, its packet is
+    // only rebuilt once the translation leaves the hierarchy
+    struct translation_request {
+        uint64_t ip, instr_id, page;
+        int rob_index;
+        uint32_t lq_index, sq_index;
+        uint8_t type;
+        bool instruction;
+    };
+
+    descriptor _desc;
+    uint32_t _cpu;
+
+    tlb _itlb, _dtlb, _stlb;
+
+    // page-walk caches, from the root of the page table
+    std::vector<tlb> _pwc;
+
+    // cycle at which each walker becomes available, and start cycles of the
+    // walks waiting for one
+    std::vector<uint64_t> _walker_available;
+    std::deque<uint64_t> _waiting_walks;
+
+    // translations in flight, by page tag, and the requests waiting for them
+    std::unordered_map<uint64_t, uint64_t> _inflight;
+    std::multimap<uint64_t, translation_request> _pending;
+    uint32_t _pending_instructions, _pending_data;
+
+    // virtual to physical 4KB page numbers already resolved
+    std::unordered_map<uint64_t, uint64_t> _translations;
+
+    uint64_t _walks, _walk_accesses, _walk_cycles;
+
+    uint64_t page_tag(uint64_t va) const;
+    uint64_t walk(uint64_t va, uint64_t cycle);
+    uint64_t translate(const PACKET& packet);
+
+    int add_rq(PACKET* packet, bool instruction);
+
+   public:
+    PACKET_QUEUE ITLB_PROCESSED{"ITLB_PROCESSED", ROB_SIZE},
+        DTLB_PROCESSED{"DTLB_PROCESSED", ROB_SIZE};
+
+    tlb_hierarchy(const descriptor& desc, uint32_t cpu);
+
+    const descriptor& desc() const { return this->_desc; }
+
+    // Returns -2 when the request cannot be accepted this cycle.
+    int add_instruction_rq(PACKET* packet), add_data_rq(PACKET* packet);
+
+    // Returns the cycle at which the translation of a prefetch is available,
+    // or 0 when the prefetch must be dropped.
+    uint64_t translate_prefetch(uint64_t va, bool walk,
+                                prefetch_translations& outcome);
+
+    void operate();
+    void invalidate(uint64_t vpage);
+
+    void reset_stats();
+    void dump_stats(std::ostream& os) const;
+};
+}  // namespace components
+}  // namespace champsim
+
+#endif  // __CHAMPSIM_INTERNALS_COMPONENTS_TLB_HH__
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#
 #include <boost/filesystem.hpp>
 #
 #include "dram_controller.h"
@@ -10,14 +14,137 @@
 #
 #include <internals/components/cache.hh>
 
-#define CHAMPSIM_RECORD_DRAM_ACCESSES
-#undef CHAMPSIM_RECORD_DRAM_ACCESSES
-
 using namespace boost::filesystem;
 
-// initialized in main.cc
+// initialized by MEMORY_CONTROLLER::configure
 uint32_t DRAM_MTPS, DRAM_DBUS_RETURN_TIME, tRP, tRCD, tCAS;
 
+static uint32_t dram_log2(uint32_t value, const char *what) {
+    if (value == 0 || (value & (value - 1)))
+        throw std::runtime_error(std::string("The number of DRAM ") + what +
+                                 " must be a power of two.");
+
+    uint32_t log2 = 0;
+    while ((1u << log2) < value) log2++;
+
+    return log2;
+}
+
+void MEMORY_CONTROLLER::configure(const dram_descriptor &desc) {
+    this->desc = desc;
+
+    if (desc.rq_size == 0 || desc.wq_size == 0)
+        throw std::runtime_error("The DRAM queues cannot be empty.");
+
+    // sub-channels are scheduled as independent channels with a narrower
+    // data bus
+    uint32_t subchannels = desc.detailed_timing ? desc.subchannels : 1;
+
+    channels = desc.channels * subchannels;
+    channel_width = DRAM_CHANNEL_WIDTH / subchannels;
+
+    if (channel_width == 0)
+        throw std::runtime_error("Too many DRAM sub-channels.");
+
+    // address mapping
+    uint32_t log2_channels = dram_log2(channels, "channels"),
+             log2_ranks = dram_log2(desc.ranks, "ranks"),
+             log2_banks = dram_log2(desc.banks, "banks"),
+             log2_rows = dram_log2(desc.rows, "rows"),
+             log2_columns = dram_log2(desc.columns, "columns");
+
+    channel_mask = channels - 1;
+    bank_shift = log2_channels;
+    bank_mask = desc.banks - 1;
+    column_shift = bank_shift + log2_banks;
+    column_mask = desc.columns - 1;
+    rank_shift = column_shift + log2_columns;
+    rank_mask = desc.ranks - 1;
+    row_shift = rank_shift + log2_ranks;
+    row_mask = (uint32_t)((1ull << log2_rows) - 1);
+
+    // timing, in CPU cycles
+    if (helper::knob_low_bandwidth)
+        DRAM_MTPS = desc.io_frequency / 4;
+    else
+        DRAM_MTPS = desc.io_frequency;
+
+    tRP = (uint32_t)((1.0 * desc.tRP * CPU_FREQ) / 1000);
+    tRCD = (uint32_t)((1.0 * desc.tRCD * CPU_FREQ) / 1000);
+    tCAS = (uint32_t)((1.0 * desc.tCAS * CPU_FREQ) / 1000);
+    dbus_turn_around_time =
+        (uint32_t)((1.0 * desc.dbus_turn_around * CPU_FREQ) / 1000);
+
+    // default: 16 = (64 / 8) * (3200 / 1600)
+    // it takes 16 CPU cycles to tranfser 64B cache block on a 8B (64-bit) bus
+    // note that dram burst length = BLOCK_SIZE/DRAM_CHANNEL_WIDTH
+    DRAM_DBUS_RETURN_TIME =
+        (uint32_t)std::ceil((float)(BLOCK_SIZE / channel_width) *
+                            ((float)CPU_FREQ / (float)DRAM_MTPS));
+
+    // detailed timing mode, banks are interleaved across the bank groups
+    if (desc.detailed_timing) {
+        if (dram_log2(desc.bank_groups, "bank groups") > log2_banks)
+            throw std::runtime_error(
+                "The number of DRAM bank groups cannot exceed the number of "
+                "banks.");
+
+        bank_group_mask = desc.bank_groups - 1;
+    } else {
+        bank_group_mask = 0;
+    }
+
+    tRRD_S = (uint32_t)((1.0 * desc.tRRD_S * CPU_FREQ) / 1000);
+    tRRD_L = (uint32_t)((1.0 * desc.tRRD_L * CPU_FREQ) / 1000);
+    tFAW = (uint32_t)((1.0 * desc.tFAW * CPU_FREQ) / 1000);
+    tCCD_S = (uint32_t)((1.0 * desc.tCCD_S * CPU_FREQ) / 1000);
+    tCCD_L = (uint32_t)((1.0 * desc.tCCD_L * CPU_FREQ) / 1000);
+    tRFC = (uint32_t)((1.0 * desc.tRFC * CPU_FREQ) / 1000);
+    tREFI = (uint32_t)((1.0 * desc.tREFI * CPU_FREQ) / 1000);
+
+    write_high_wm = (uint32_t)(desc.wq_size * desc.write_high_watermark);
+    write_low_wm = (uint32_t)(desc.wq_size * desc.write_low_watermark);
+
+    // channel state
+    dbus_cycle_available.assign(channels, 0);
+    dbus_cycle_congested.assign(channels, 0);
+    write_mode.assign(channels, 0);
+    scheduled_reads.assign(channels, 0);
+    scheduled_writes.assign(channels, 0);
+    refreshes.assign(channels, 0);
+
+    rank_timing.assign(channels, std::vector<RANK_TIMING>(desc.ranks));
+
+    // staggering the refreshes of the ranks
+    for (uint32_t i = 0; i < channels; i++) {
+        for (uint32_t r = 0; r < desc.ranks; r++) {
+            rank_timing[i][r].next_refresh =
+                tREFI + (uint64_t)tREFI * r / desc.ranks;
+            rank_timing[i][r].precharged.assign(desc.banks, false);
+        }
+    }
+
+    bank_request.assign(
+        channels,
+        std::vector<std::vector<BANK_REQUEST>>(
+            desc.ranks, std::vector<BANK_REQUEST>(desc.banks)));
+
+    WQ.clear();
+    RQ.clear();
+    WQ_banks.assign(channels, BANK_QUEUES());
+    RQ_banks.assign(channels, BANK_QUEUES());
+
+    for (uint32_t i = 0; i < channels; i++) {
+        WQ.emplace_back("DRAM_WQ" + to_string(i), desc.wq_size);
+        WQ[i].is_WQ = 1;
+        WQ_banks[i].resize(desc.ranks, desc.banks, desc.wq_size);
+
+        RQ.emplace_back("DRAM_RQ" + to_string(i), desc.rq_size);
+        RQ[i].is_RQ = 1;
+        RQ_banks[i].resize(desc.ranks, desc.banks, desc.rq_size);
+    }
+}
+
 void MEMORY_CONTROLLER::initialize() {
 #if defined(CHAMPSIM_RECORD_DRAM_ACCESSES)
     path trace_name = path(champsim::simulator::instance()->traces()[0])
@@ -31,10 +158,40 @@ void MEMORY_CONTROLLER::initialize() {
     trace_path += ".memorytrace";
 
     this->_memory_trace.open(trace_path.string(),
-                             std::ios::out | std::ios::trunc);
+                             this->desc.memory_trace_compression);
 #endif  // CHAMPSIM_RECORD_DRAM_ACCESSES
 }
 
+#if defined(CHAMPSIM_RECORD_DRAM_ACCESSES)
+void MEMORY_CONTROLLER::record_access(PACKET *packet, bool write) {
+    champsim::dram_trace_record rec;
+
+    rec.address = packet->full_addr;
+    rec.cycle = champsim::simulator::instance()
+                    ->modeled_cpu(packet->cpu)
+                    ->current_core_cycle();
+    rec.type = packet->type;
+    rec.cpu = packet->cpu;
+    rec.fill_level = packet->fill_level;
+    rec.flags = (write ? champsim::dram_trace_record::write : 0) |
+                (packet->went_offchip_pred
+                     ? champsim::dram_trace_record::went_offchip_pred
+                     : 0) |
+                (packet->l1d_offchip_pred_used
+                     ? champsim::dram_trace_record::l1d_offchip_pred_used
+                     : 0) |
+                (packet->pf_went_offchip_pred
+                     ? champsim::dram_trace_record::pf_went_offchip_pred
+                     : 0) |
+                (packet->pf_went_offchip
+                     ? champsim::dram_trace_record::pf_went_offchip
+                     : 0);
+    rec.reserved = 0;
+
+    this->_memory_trace.record(rec);
+}
+#endif  // CHAMPSIM_RECORD_DRAM_ACCESSES
+
 void MEMORY_CONTROLLER::reset_remain_requests(PACKET_QUEUE *queue,
                                               uint32_t channel) {
     O3_CPU *curr_cpu = nullptr;
@@ -78,6 +235,7 @@ void MEMORY_CONTROLLER::reset_remain_requests(PACKET_QUEUE *queue,
 
             queue->entry[i].scheduled = 0;
             queue->entry[i].event_cycle = curr_cpu->current_core_cycle();
+            bank_enqueue(queue, i, false);
 
             DP(if (warmup_complete[op_cpu]) {
                 cout << queue->NAME << " instr_id: " << queue->entry[i].instr_id
@@ -101,12 +259,33 @@ void MEMORY_CONTROLLER::reset_remain_requests(PACKET_QUEUE *queue,
 #endif
 }
 
+/**
+ * The controller has no clock of its own. All the cores are clocked together,
+ * so the cycle of the first one drives the refreshes and the bank timing.
+ */
+uint64_t MEMORY_CONTROLLER::current_cycle() {
+    return champsim::simulator::instance()->modeled_cpu(0)->current_core_cycle();
+}
+
 void MEMORY_CONTROLLER::operate() {
-    for (uint32_t i = 0; i < DRAM_CHANNELS; i++) {
-        // if ((write_mode[i] == 0) && (WQ[i].occupancy >= DRAM_WRITE_HIGH_WM))
+    uint64_t cycle = current_cycle();
+
+    for (uint32_t i = 0; i < channels; i++) {
+        channel_operates++;
+
+        if (desc.detailed_timing) refresh(i, cycle);
+
+        // idle channel, nothing can happen until a request arrives
+        if ((write_mode[i] == 0) && (RQ[i].occupancy == 0) &&
+            (WQ[i].occupancy == 0)) {
+            skipped_channel_operates++;
+            continue;
+        }
+
+        // if ((write_mode[i] == 0) && (WQ[i].occupancy >= write_high_wm))
         // {
         if ((write_mode[i] == 0) &&
-            ((WQ[i].occupancy >= DRAM_WRITE_HIGH_WM) ||
+            ((WQ[i].occupancy >= write_high_wm) ||
              ((RQ[i].occupancy == 0) &&
               (WQ[i].occupancy > 0)))) {  // use idle cycles to perform writes
             write_mode[i] = 1;
@@ -114,21 +293,30 @@ void MEMORY_CONTROLLER::operate() {
             // reset scheduled RQ requests
             reset_remain_requests(&RQ[i], i);
             // add data bus turn-around time
-            dbus_cycle_available[i] += DRAM_DBUS_TURN_AROUND_TIME;
+            dbus_cycle_available[i] += dbus_turn_around_time;
         } else if (write_mode[i]) {
             if (WQ[i].occupancy == 0)
                 write_mode[i] = 0;
-            else if (RQ[i].occupancy && (WQ[i].occupancy < DRAM_WRITE_LOW_WM))
+            else if (RQ[i].occupancy && (WQ[i].occupancy < write_low_wm))
                 write_mode[i] = 0;
 
             if (write_mode[i] == 0) {
                 // reset scheduled WQ requests
                 reset_remain_requests(&WQ[i], i);
                 // add data bus turnaround time
-                dbus_cycle_available[i] += DRAM_DBUS_TURN_AROUND_TIME;
+                dbus_cycle_available[i] += dbus_turn_around_time;
             }
         }
 
+        // no request of the active queue is ready to be scheduled or processed
+        PACKET_QUEUE &active = write_mode[i] ? WQ[i] : RQ[i];
+
+        if ((active.next_schedule_cycle > cycle) &&
+            (active.next_process_cycle > cycle)) {
+            skipped_channel_operates++;
+            continue;
+        }
+
         // handle write
         // schedule new entry
         if (write_mode[i] && (WQ[i].next_schedule_index < WQ[i].SIZE)) {
@@ -165,119 +353,146 @@ void MEMORY_CONTROLLER::operate() {
     }
 }
 
-void MEMORY_CONTROLLER::schedule(PACKET_QUEUE *queue) {
-    uint64_t read_addr;
-    uint32_t read_channel, read_rank, read_bank, read_row;
-    uint8_t row_buffer_hit = 0;
+uint64_t MEMORY_CONTROLLER::detailed_latency(uint32_t channel, uint32_t rank,
+                                             uint32_t bank,
+                                             uint8_t row_buffer_hit,
+                                             uint64_t cycle) {
+    RANK_TIMING &timing = rank_timing[channel][rank];
+    uint32_t group = bank & bank_group_mask;
+    uint64_t column = cycle;
+
+    // Commands are issued in scheduling order: a row buffer miss precharges
+    // the bank, unless a refresh already did, then activates the row no sooner
+    // than tRRD after the previous activate of the rank and tFAW after the
+    // fourth previous one.
+    if (!row_buffer_hit) {
+        uint64_t act = cycle + (timing.precharged[bank] ? 0 : tRP);
+
+        act = std::max(act, timing.last_act + (group == timing.last_act_group
+                                                   ? tRRD_L
+                                                   : tRRD_S));
+        act = std::max(act, timing.act_window[timing.act_head] + tFAW);
+
+        timing.act_window[timing.act_head] = act;
+        timing.act_head = (timing.act_head + 1) % 4;
+        timing.last_act = act;
+        timing.last_act_group = group;
+
+        column = act + tRCD;
+    }
 
-    int oldest_index = -1;
-    uint64_t oldest_cycle = UINT64_MAX;
+    timing.precharged[bank] = false;
 
-    // first, search for the oldest open row hit
-    for (uint32_t i = 0; i < queue->SIZE; i++) {
-        // already scheduled
-        if (queue->entry[i].scheduled) continue;
-
-        // empty entry
-        read_addr = queue->entry[i].address;
-        if (read_addr == 0) continue;
-
-        read_channel = dram_get_channel(read_addr);
-        read_rank = dram_get_rank(read_addr);
-        read_bank = dram_get_bank(read_addr);
-
-        // bank is busy
-        if (bank_request[read_channel][read_rank][read_bank]
-                .working) {  // should we check this or not? how do we know if
-                             // bank is busy or not for all requests in the
-                             // queue?
-
-            // DP ( if (warmup_complete[0]) {
-            // cout << queue->NAME << " " << __func__ << " instr_id: " <<
-            // queue->entry[i].instr_id << " bank is busy"; cout << " swrites: "
-            // << scheduled_writes[channel] << " sreads: " <<
-            // scheduled_reads[channel]; cout << " write: " <<
-            // +bank_request[read_channel][read_rank][read_bank].is_write << "
-            // read: " <<
-            // +bank_request[read_channel][read_rank][read_bank].is_read << hex;
-            // cout << " address: " << queue->entry[i].address << dec << "
-            // channel: " << read_channel << " rank: " << read_rank << " bank: "
-            // << read_bank << endl; });
+    // column commands of a rank are spaced by tCCD from all the others, a
+    // row buffer hit may still be issued between the columns of earlier misses
+    for (bool moved = true; moved;) {
+        moved = false;
 
-            continue;
+        for (const auto &[other, other_group] : timing.columns) {
+            uint32_t tCCD = (group == other_group) ? tCCD_L : tCCD_S;
+
+            if ((column + tCCD > other) && (other + tCCD > column)) {
+                column = other + tCCD;
+                moved = true;
+            }
         }
+    }
 
-        read_row = dram_get_row(read_addr);
-        // read_column = dram_get_column(read_addr);
-
-        // check open row
-        if (bank_request[read_channel][read_rank][read_bank].open_row !=
-            read_row) {
-            /*
-            DP ( if (warmup_complete[0]) {
-            cout << queue->NAME << " " << __func__ << " instr_id: " <<
-            queue->entry[i].instr_id << " row is inactive"; cout << " swrites: "
-            << scheduled_writes[channel] << " sreads: " <<
-            scheduled_reads[channel]; cout << " write: " <<
-            +bank_request[read_channel][read_rank][read_bank].is_write << "
-            read: " << +bank_request[read_channel][read_rank][read_bank].is_read
-            << hex; cout << " address: " << queue->entry[i].address << dec << "
-            channel: " << read_channel << " rank: " << read_rank << " bank: " <<
-            read_bank << endl; });
-            */
+    // commands older than tCCD cannot delay the next ones, which are issued
+    // from the current cycle on
+    std::erase_if(timing.columns, [&](const std::pair<uint64_t, uint32_t> &c) {
+        return c.first + std::max(tCCD_S, tCCD_L) <= cycle;
+    });
 
-            continue;
-        }
+    timing.columns.emplace_back(column, group);
+
+    return column + tCAS - cycle;
+}
+
+void MEMORY_CONTROLLER::refresh(uint32_t channel, uint64_t cycle) {
+    for (uint32_t rank = 0; rank < desc.ranks; rank++) {
+        RANK_TIMING &timing = rank_timing[channel][rank];
 
-        // select the oldest entry
-        if (queue->entry[i].event_cycle < oldest_cycle) {
-            oldest_cycle = queue->entry[i].event_cycle;
-            oldest_index = i;
-            row_buffer_hit = 1;
+        if (timing.next_refresh > cycle) continue;
+
+        // the refresh starts once the requests already scheduled on the rank
+        // are done and closes all of its rows, leaving the banks precharged
+        uint64_t start = cycle;
+
+        for (uint32_t bank = 0; bank < desc.banks; bank++) {
+            BANK_REQUEST &request = bank_request[channel][rank][bank];
+
+            if (request.working)
+                start = std::max(start, request.cycle_available);
+
+            request.open_row = UINT32_MAX;
+            timing.precharged[bank] = true;
         }
+
+        timing.refresh_until = start + tRFC;
+        timing.next_refresh += tREFI;
+        refreshes[channel]++;
     }
+}
 
-    if (oldest_index == -1) {  // no matching open_row (row buffer miss)
+void MEMORY_CONTROLLER::schedule(PACKET_QUEUE *queue) {
+    BANK_QUEUES &banks = bank_queues(queue);
+    uint32_t channel = queue->is_WQ ? queue - WQ.data() : queue - RQ.data();
+    uint8_t row_buffer_hit = 0;
+
+    int oldest_index = -1, oldest_hit_index = -1;
+    uint64_t oldest_cycle = UINT64_MAX, oldest_hit_cycle = UINT64_MAX;
+
+    uint64_t cycle = current_cycle();
 
-        oldest_cycle = UINT64_MAX;
-        for (uint32_t i = 0; i < queue->SIZE; i++) {
-            // already scheduled
-            if (queue->entry[i].scheduled) continue;
+    // search the banks that are not busy for the oldest open row hit and the
+    // oldest request, ties going to the lowest queue slot
+    for (uint32_t rank = 0; rank < desc.ranks; rank++) {
+        // rank is refreshing
+        if (rank_timing[channel][rank].refresh_until > cycle) continue;
 
-            // empty entry
-            read_addr = queue->entry[i].address;
-            if (read_addr == 0) continue;
+        for (uint32_t bank = 0; bank < desc.banks; bank++) {
+            BANK_REQUEST &request = bank_request[channel][rank][bank];
 
             // bank is busy
-            read_channel = dram_get_channel(read_addr);
-            read_rank = dram_get_rank(read_addr);
-            read_bank = dram_get_bank(read_addr);
-            if (bank_request[read_channel][read_rank][read_bank].working)
-                continue;
-
-            // read_row = dram_get_row(read_addr);
-            // read_column = dram_get_column(read_addr);
-
-            // select the oldest entry
-            if (queue->entry[i].event_cycle < oldest_cycle) {
-                oldest_cycle = queue->entry[i].event_cycle;
-                oldest_index = i;
+            if (request.working) continue;
+
+            for (uint32_t i : banks.bank_pending(rank, bank)) {
+                uint64_t event_cycle = queue->entry[i].event_cycle;
+
+                if ((event_cycle < oldest_cycle) ||
+                    ((event_cycle == oldest_cycle) && (oldest_index != -1) &&
+                     ((int)i < oldest_index))) {
+                    oldest_cycle = event_cycle;
+                    oldest_index = i;
+                }
+
+                // check open row
+                if (banks.row[i] != request.open_row) continue;
+
+                if ((event_cycle < oldest_hit_cycle) ||
+                    ((event_cycle == oldest_hit_cycle) &&
+                     (oldest_hit_index != -1) && ((int)i < oldest_hit_index))) {
+                    oldest_hit_cycle = event_cycle;
+                    oldest_hit_index = i;
+                }
             }
         }
     }
 
+    // prefer the oldest open row hit, otherwise take the oldest request (row
+    // buffer miss)
+    if (oldest_hit_index != -1) {
+        oldest_index = oldest_hit_index;
+        row_buffer_hit = 1;
+    }
+
     // at this point, the scheduler knows which bank to access and if the
     // request is a row buffer hit or miss
     if (oldest_index !=
         -1) {  // scheduler might not find anything if all requests are already
                // scheduled or all banks are busy
 
-        uint64_t LATENCY = 0;
-        if (row_buffer_hit)
-            LATENCY = tCAS;
-        else
-            LATENCY = tRP + tRCD + tCAS;
-
         uint64_t op_addr = queue->entry[oldest_index].address;
         uint32_t op_cpu = queue->entry[oldest_index].cpu,
                  op_channel = dram_get_channel(op_addr),
@@ -288,14 +503,21 @@ void MEMORY_CONTROLLER::schedule(PACKET_QUEUE *queue) {
         uint32_t op_column = dram_get_column(op_addr);
 #endif
 
-        O3_CPU *curr_cpu = champsim::simulator::instance()->modeled_cpu(op_cpu);
+        uint64_t LATENCY = 0;
+        if (desc.detailed_timing)
+            LATENCY = detailed_latency(op_channel, op_rank, op_bank,
+                                       row_buffer_hit, cycle);
+        else if (row_buffer_hit)
+            LATENCY = tCAS;
+        else
+            LATENCY = tRP + tRCD + tCAS;
 
         // this bank is now busy
         bank_request[op_channel][op_rank][op_bank].working = 1;
         bank_request[op_channel][op_rank][op_bank].working_type =
             queue->entry[oldest_index].type;
         bank_request[op_channel][op_rank][op_bank].cycle_available =
-            curr_cpu->current_core_cycle() + LATENCY;
+            cycle + LATENCY;
 
         bank_request[op_channel][op_rank][op_bank].request_index = oldest_index;
         bank_request[op_channel][op_rank][op_bank].row_buffer_hit =
@@ -314,8 +536,8 @@ void MEMORY_CONTROLLER::schedule(PACKET_QUEUE *queue) {
         bank_request[op_channel][op_rank][op_bank].open_row = op_row;
 
         queue->entry[oldest_index].scheduled = 1;
-        queue->entry[oldest_index].event_cycle =
-            curr_cpu->current_core_cycle() + LATENCY;
+        queue->entry[oldest_index].event_cycle = cycle + LATENCY;
+        bank_dequeue(queue, oldest_index);
 
         update_schedule_cycle(queue);
         update_process_cycle(queue);
@@ -360,7 +582,7 @@ void MEMORY_CONTROLLER::process(PACKET_QUEUE *queue) {
                 (float)(champsim::simulator::instance()
                             ->modeled_cpu(queue->entry[request_index].cpu)
                             ->sdc->block_size()) /
-                (float)(DRAM_CHANNEL_WIDTH)) *
+                (float)(channel_width)) *
             (uint32_t)std::ceil(((float)CPU_FREQ / (float)DRAM_MTPS));
     } else {
         dbus_return_time = DRAM_DBUS_RETURN_TIME;
@@ -495,6 +717,8 @@ void MEMORY_CONTROLLER::process(PACKET_QUEUE *queue) {
                 scheduled_reads[op_channel]--;
             }
 
+            dbus_busy_cycles += dbus_return_time;
+
             // remove the oldest entry
             queue->remove_queue(&queue->entry[request_index]);
             update_process_cycle(queue);
@@ -720,10 +944,11 @@ int MEMORY_CONTROLLER::add_rq(PACKET *packet) {
     }
 
     // search for the empty index
-    for (index = 0; index < DRAM_RQ_SIZE; index++) {
+    for (index = 0; index < (int)RQ[channel].SIZE; index++) {
         if (RQ[channel].entry[index].address == 0) {
             RQ[channel].entry[index] = *packet;
             RQ[channel].occupancy++;
+            bank_enqueue(&RQ[channel], index, true);
 
 #ifdef DEBUG_PRINT
             uint32_t channel = dram_get_channel(packet->address),
@@ -764,8 +989,7 @@ int MEMORY_CONTROLLER::add_rq(PACKET *packet) {
 #if defined(CHAMPSIM_RECORD_DRAM_ACCESSES)
     // Filling the memory trace with the read packet.
     if (champsim::simulator::instance()->all_warmup_complete()) {
-        this->_memory_trace << std::hex << std::showbase << packet->full_addr
-                            << " R" << std::noshowbase << std::dec << std::endl;
+        record_access(packet, false);
     }
 #endif  // CHAMPSIM_RECORD_DRAM_ACCESSES
 
@@ -791,10 +1015,11 @@ int MEMORY_CONTROLLER::add_wq(PACKET *packet) {
     }
 
     // search for the empty index
-    for (index = 0; index < DRAM_WQ_SIZE; index++) {
+    for (index = 0; index < (int)WQ[channel].SIZE; index++) {
         if (WQ[channel].entry[index].address == 0) {
             WQ[channel].entry[index] = *packet;
             WQ[channel].occupancy++;
+            bank_enqueue(&WQ[channel], index, true);
 
 #ifdef DEBUG_PRINT
             uint32_t channel = dram_get_channel(packet->address),
@@ -826,8 +1051,7 @@ int MEMORY_CONTROLLER::add_wq(PACKET *packet) {
 #if defined(CHAMPSIM_RECORD_DRAM_ACCESSES)
     // Filling the memory trace with the write packet.
     if (champsim::simulator::instance()->all_warmup_complete()) {
-        this->_memory_trace << std::hex << std::showbase << packet->full_addr
-                            << " W" << std::noshowbase << std::dec << std::endl;
+        record_access(packet, true);
     }
 #endif  // CHAMPSIM_RECORD_DRAM_ACCESSES
 
@@ -863,24 +1087,21 @@ void MEMORY_CONTROLLER::update_fill_path(PACKET &packet) {
 void MEMORY_CONTROLLER::return_data(PACKET *packet) {}
 
 void MEMORY_CONTROLLER::update_schedule_cycle(PACKET_QUEUE *queue) {
-    // update next_schedule_cycle
+    // update next_schedule_cycle, only unscheduled requests sit in the bank
+    // queues
+    BANK_QUEUES &banks = bank_queues(queue);
     uint64_t min_cycle = UINT64_MAX;
     uint32_t min_index = queue->SIZE;
-    for (uint32_t i = 0; i < queue->SIZE; i++) {
-        /*
-        DP (if (warmup_complete[queue->entry[min_index].cpu]) {
-        cout << "[" << queue->NAME << "] " <<  __func__ << " instr_id: " <<
-        queue->entry[i].instr_id; cout << " index: " << i << " address: " << hex
-        << queue->entry[i].address << dec << " scheduled: " <<
-        +queue->entry[i].scheduled; cout << " event: " <<
-        queue->entry[i].event_cycle << " min_cycle: " << min_cycle << endl;
-        });
-        */
-
-        if (queue->entry[i].address && (queue->entry[i].scheduled == 0) &&
-            (queue->entry[i].event_cycle < min_cycle)) {
-            min_cycle = queue->entry[i].event_cycle;
-            min_index = i;
+    for (uint32_t rank = 0; rank < desc.ranks; rank++) {
+        for (uint32_t bank = 0; bank < desc.banks; bank++) {
+            for (uint32_t i : banks.bank_pending(rank, bank)) {
+                if ((queue->entry[i].event_cycle < min_cycle) ||
+                    ((queue->entry[i].event_cycle == min_cycle) &&
+                     (min_index < queue->SIZE) && (i < min_index))) {
+                    min_cycle = queue->entry[i].event_cycle;
+                    min_index = i;
+                }
+            }
         }
     }
 
@@ -966,45 +1187,54 @@ int MEMORY_CONTROLLER::check_dram_queue(PACKET_QUEUE *queue, PACKET *packet) {
     return -1;
 }
 
-uint32_t MEMORY_CONTROLLER::dram_get_channel(uint64_t address) {
-    if (LOG2_DRAM_CHANNELS == 0) return 0;
-
-    int shift = 0;
+BANK_QUEUES &MEMORY_CONTROLLER::bank_queues(PACKET_QUEUE *queue) {
+    if (queue->is_WQ) return WQ_banks[queue - WQ.data()];
 
-    return (uint32_t)(address >> shift) & (DRAM_CHANNELS - 1);
+    return RQ_banks[queue - RQ.data()];
 }
 
-uint32_t MEMORY_CONTROLLER::dram_get_bank(uint64_t address) {
-    if (LOG2_DRAM_BANKS == 0) return 0;
+void MEMORY_CONTROLLER::bank_enqueue(PACKET_QUEUE *queue, uint32_t index,
+                                     bool arrival) {
+    BANK_QUEUES &banks = bank_queues(queue);
+    uint64_t address = queue->entry[index].address;
+    uint32_t rank = dram_get_rank(address), bank = dram_get_bank(address);
+    std::vector<uint32_t> &pending = banks.bank_pending(rank, bank);
 
-    int shift = LOG2_DRAM_CHANNELS;
+    if (arrival) banks.depth(rank, bank, pending.size())++;
 
-    return (uint32_t)(address >> shift) & (DRAM_BANKS - 1);
+    banks.row[index] = dram_get_row(address);
+    pending.push_back(index);
 }
 
-uint32_t MEMORY_CONTROLLER::dram_get_column(uint64_t address) {
-    if (LOG2_DRAM_COLUMNS == 0) return 0;
+void MEMORY_CONTROLLER::bank_dequeue(PACKET_QUEUE *queue, uint32_t index) {
+    BANK_QUEUES &banks = bank_queues(queue);
+    uint64_t address = queue->entry[index].address;
+    std::vector<uint32_t> &pending =
+        banks.bank_pending(dram_get_rank(address), dram_get_bank(address));
 
-    int shift = LOG2_DRAM_BANKS + LOG2_DRAM_CHANNELS;
+    auto it = std::find(pending.begin(), pending.end(), index);
+    assert(it != pending.end());
+    pending.erase(it);
+}
 
-    return (uint32_t)(address >> shift) & (DRAM_COLUMNS - 1);
+uint32_t MEMORY_CONTROLLER::dram_get_channel(uint64_t address) {
+    return (uint32_t)address & channel_mask;
 }
 
-uint32_t MEMORY_CONTROLLER::dram_get_rank(uint64_t address) {
-    if (LOG2_DRAM_RANKS == 0) return 0;
+uint32_t MEMORY_CONTROLLER::dram_get_bank(uint64_t address) {
+    return (uint32_t)(address >> bank_shift) & bank_mask;
+}
 
-    int shift = LOG2_DRAM_COLUMNS + LOG2_DRAM_BANKS + LOG2_DRAM_CHANNELS;
+uint32_t MEMORY_CONTROLLER::dram_get_column(uint64_t address) {
+    return (uint32_t)(address >> column_shift) & column_mask;
+}
 
-    return (uint32_t)(address >> shift) & (DRAM_RANKS - 1);
+uint32_t MEMORY_CONTROLLER::dram_get_rank(uint64_t address) {
+    return (uint32_t)(address >> rank_shift) & rank_mask;
 }
 
 uint32_t MEMORY_CONTROLLER::dram_get_row(uint64_t address) {
-    if (LOG2_DRAM_ROWS == 0) return 0;
-
-    int shift = LOG2_DRAM_RANKS + LOG2_DRAM_COLUMNS + LOG2_DRAM_BANKS +
-                LOG2_DRAM_CHANNELS;
-
-    return (uint32_t)(address >> shift) & (DRAM_ROWS - 1);
+    return (uint32_t)(address >> row_shift) & row_mask;
 }
 
 uint32_t MEMORY_CONTROLLER::get_occupancy(uint8_t queue_type,
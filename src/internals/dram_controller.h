@@ -1,15 +1,17 @@
 #ifndef DRAM_H
 #define DRAM_H
 
-#include <fstream>
+#include <utility>
+#include <vector>
 #
 #include <boost/filesystem.hpp>
 #
 #include "memory_class.h"
 #
+#include <internals/dram_trace.hh>
 #include <internals/components/memory_system.hh>
 
-// DRAM configuration
+// DRAM configuration, defaults for the "dram" section of the configuration
 #define DRAM_CHANNEL_WIDTH 8 // 8B
 #define DRAM_WQ_SIZE 64
 #define DRAM_RQ_SIZE 64
@@ -19,39 +21,196 @@
 #define tCAS_DRAM_NANOSECONDS 12.5
 
 // the data bus must wait this amount of time when switching between reads and writes, and vice versa
-#define DRAM_DBUS_TURN_AROUND_TIME ((15*CPU_FREQ)/2000) // 7.5 ns
+#define DRAM_DBUS_TURN_AROUND_NANOSECONDS 7.5
 extern uint32_t DRAM_MTPS, DRAM_DBUS_RETURN_TIME;
 
 // these values control when to send out a burst of writes
-#define DRAM_WRITE_HIGH_WM    ((DRAM_WQ_SIZE*7)>>3) // 7/8th
-#define DRAM_WRITE_LOW_WM     ((DRAM_WQ_SIZE*3)>>2) // 6/8th
-#define MIN_DRAM_WRITES_PER_SWITCH (DRAM_WQ_SIZE*1/4)
+#define DRAM_WRITE_HIGH_WM_FRACTION 0.875 // 7/8th
+#define DRAM_WRITE_LOW_WM_FRACTION  0.75  // 6/8th
+
+// detailed timing mode (DDR4-like), only used when the "detailed_timing" key is set
+#define DRAM_BANK_GROUPS 4
+#define DRAM_SUBCHANNELS 1
+
+#define tRRD_S_DRAM_NANOSECONDS 3.3
+#define tRRD_L_DRAM_NANOSECONDS 4.9
+#define tFAW_DRAM_NANOSECONDS   21.0
+#define tCCD_S_DRAM_NANOSECONDS 2.5
+#define tCCD_L_DRAM_NANOSECONDS 5.0
+#define tRFC_DRAM_NANOSECONDS   350.0
+#define tREFI_DRAM_NANOSECONDS  7800.0
 
 namespace cc = champsim::components;
 
+// Organization, timing and bus rate of the off-chip DRAM.
+struct dram_descriptor {
+    uint32_t io_frequency = DRAM_IO_FREQ, // MT/s
+             channels = DRAM_CHANNELS,
+             ranks = DRAM_RANKS,
+             banks = DRAM_BANKS,
+             rows = DRAM_ROWS,
+             columns = DRAM_COLUMNS,
+             rq_size = DRAM_RQ_SIZE,
+             wq_size = DRAM_WQ_SIZE;
+
+    double tRP = tRP_DRAM_NANOSECONDS,
+           tRCD = tRCD_DRAM_NANOSECONDS,
+           tCAS = tCAS_DRAM_NANOSECONDS,
+           dbus_turn_around = DRAM_DBUS_TURN_AROUND_NANOSECONDS,
+           write_high_watermark = DRAM_WRITE_HIGH_WM_FRACTION, // fraction of wq_size
+           write_low_watermark = DRAM_WRITE_LOW_WM_FRACTION;
+
+    // compress the memory trace through zstd
+    bool memory_trace_compression = false;
+
+    // Detailed timing mode: bank-group activate and column spacing, the
+    // four-activate window and refresh. Banks are interleaved across bank
+    // groups and each channel can be split into independent sub-channels
+    // (DDR5), each with its own half-width data bus.
+    bool detailed_timing = false;
+
+    uint32_t bank_groups = DRAM_BANK_GROUPS,
+             subchannels = DRAM_SUBCHANNELS;
+
+    double tRRD_S = tRRD_S_DRAM_NANOSECONDS,
+           tRRD_L = tRRD_L_DRAM_NANOSECONDS,
+           tFAW = tFAW_DRAM_NANOSECONDS,
+           tCCD_S = tCCD_S_DRAM_NANOSECONDS,
+           tCCD_L = tCCD_L_DRAM_NANOSECONDS,
+           tRFC = tRFC_DRAM_NANOSECONDS,
+           tREFI = tREFI_DRAM_NANOSECONDS;
+
+    uint64_t size_mb() const {
+        return (uint64_t)channels * ranks * banks * rows * (BLOCK_SIZE * columns / 1024) / 1024;
+    }
+};
+
+// Per-bank view of a channel queue, used by the FR-FCFS scheduler.
+class BANK_QUEUES {
+  public:
+    uint32_t banks, size;
+
+    // slots of the requests waiting to be scheduled on each bank, indexed by
+    // rank * banks + bank
+    std::vector<std::vector<uint32_t>> pending;
+
+    // decoded row of each slot
+    std::vector<uint32_t> row;
+
+    // bank queue depth seen by arriving requests
+    std::vector<uint64_t> depth_histogram;
+
+    BANK_QUEUES() : banks(0), size(0) {}
+
+    void resize(uint32_t ranks, uint32_t banks, uint32_t size) {
+        this->banks = banks;
+        this->size = size;
+
+        pending.assign(ranks * banks, std::vector<uint32_t>());
+        row.assign(size, UINT32_MAX);
+        depth_histogram.assign(ranks * banks * (size + 1), 0);
+    }
+
+    std::vector<uint32_t> &bank_pending(uint32_t rank, uint32_t bank) {
+        return pending[rank * banks + bank];
+    }
+
+    uint64_t &depth(uint32_t rank, uint32_t bank, uint32_t depth) {
+        return depth_histogram[(rank * banks + bank) * (size + 1) + depth];
+    }
+
+    void reset_stats() {
+        std::fill(depth_histogram.begin(), depth_histogram.end(), 0);
+    }
+};
+
+// Command history of a rank, used by the detailed timing mode.
+class RANK_TIMING {
+  public:
+    // issue cycles of the last four activates, oldest at act_head
+    uint64_t act_window[4];
+    uint32_t act_head;
+
+    uint64_t last_act;
+    uint32_t last_act_group;
+
+    // issue cycles and bank groups of the column commands that can still
+    // delay the next ones
+    std::vector<std::pair<uint64_t, uint32_t>> columns;
+
+    // the rank is refreshing until refresh_until, the next refresh is due at
+    // next_refresh
+    uint64_t refresh_until, next_refresh;
+
+    // banks closed by the last refresh, whose next activate needs no
+    // precharge
+    std::vector<bool> precharged;
+
+    RANK_TIMING() {
+        for (uint32_t i=0; i<4; i++)
+            act_window[i] = 0;
+        act_head = 0;
+
+        last_act = 0;
+        last_act_group = UINT32_MAX;
+
+        refresh_until = 0;
+        next_refresh = 0;
+    }
+};
+
 // DRAM
 class MEMORY_CONTROLLER : public MEMORY {
   public:
     const string NAME;
 
-    DRAM_ARRAY dram_array[DRAM_CHANNELS][DRAM_RANKS][DRAM_BANKS];
-    uint64_t dbus_cycle_available[DRAM_CHANNELS], dbus_cycle_congested[DRAM_CHANNELS], dbus_congested[NUM_TYPES+1][NUM_TYPES+1];
-    uint64_t bank_cycle_available[DRAM_CHANNELS][DRAM_RANKS][DRAM_BANKS];
-    uint8_t  do_write, write_mode[DRAM_CHANNELS];
-    uint32_t processed_writes, scheduled_reads[DRAM_CHANNELS], scheduled_writes[DRAM_CHANNELS];
+    dram_descriptor desc;
+
+    // address mapping, from the least significant bits: channel, bank,
+    // column, rank and row
+    uint32_t channel_mask, bank_shift, bank_mask, column_shift, column_mask,
+             rank_shift, rank_mask, row_shift, row_mask;
+
+    // independently scheduled channels (sub-channels in detailed timing mode)
+    // and the width of their data bus
+    uint32_t channels, channel_width;
+
+    uint32_t write_high_wm, write_low_wm, dbus_turn_around_time;
+
+    // detailed timing mode, in CPU cycles
+    uint32_t bank_group_mask, tRRD_S, tRRD_L, tFAW, tCCD_S, tCCD_L, tRFC, tREFI;
+    std::vector<std::vector<RANK_TIMING>> rank_timing;
+    std::vector<uint64_t> refreshes;
+
+    // host efficiency, channel operate calls and those skipped because the
+    // channel had nothing to do
+    uint64_t channel_operates, skipped_channel_operates;
+
+    std::vector<uint64_t> dbus_cycle_available, dbus_cycle_congested;
+
+    // data bus cycles used by the transfers, over all channels and never
+    // reset, to measure the bandwidth utilization over a period
+    uint64_t dbus_busy_cycles;
+    uint64_t dbus_congested[NUM_TYPES+1][NUM_TYPES+1];
+    std::vector<uint8_t> write_mode;
+    uint8_t  do_write;
+    uint32_t processed_writes;
+    std::vector<uint32_t> scheduled_reads, scheduled_writes;
     int fill_level;
 
-    BANK_REQUEST bank_request[DRAM_CHANNELS][DRAM_RANKS][DRAM_BANKS];
+    std::vector<std::vector<std::vector<BANK_REQUEST>>> bank_request;
 
     // queues
-    PACKET_QUEUE WQ[DRAM_CHANNELS], RQ[DRAM_CHANNELS],
-                 PROCESSED { "DRAM_PROCESSED", ROB_SIZE };
+    std::vector<PACKET_QUEUE> WQ, RQ;
+    PACKET_QUEUE PROCESSED { "DRAM_PROCESSED", ROB_SIZE };
+
+    std::vector<BANK_QUEUES> WQ_banks, RQ_banks;
 
     cc::memory_system   *_upper_level_dcache_new[NUM_CPUS],
                         *_upper_level_icache_new[NUM_CPUS],
                         *_sdc;
 
-    std::ofstream _memory_trace;
+    champsim::dram_trace_writer _memory_trace;
 
     // constructor
     MEMORY_CONTROLLER(string v1) : NAME (v1) {
@@ -62,43 +221,24 @@ class MEMORY_CONTROLLER : public MEMORY {
         }
         do_write = 0;
         processed_writes = 0;
-        for (uint32_t i=0; i<DRAM_CHANNELS; i++) {
-            dbus_cycle_available[i] = 0;
-            dbus_cycle_congested[i] = 0;
-            write_mode[i] = 0;
-            scheduled_reads[i] = 0;
-            scheduled_writes[i] = 0;
-
-            for (uint32_t j=0; j<DRAM_RANKS; j++) {
-                for (uint32_t k=0; k<DRAM_BANKS; k++)
-                    bank_cycle_available[i][j][k] = 0;
-            }
-
-            WQ[i].NAME = "DRAM_WQ" + to_string(i);
-            WQ[i].SIZE = DRAM_WQ_SIZE;
-            WQ[i].entry = new PACKET [DRAM_WQ_SIZE];
-
-            RQ[i].NAME = "DRAM_RQ" + to_string(i);
-            RQ[i].SIZE = DRAM_RQ_SIZE;
-            RQ[i].entry = new PACKET [DRAM_RQ_SIZE];
-        }
+        channel_operates = 0;
+        skipped_channel_operates = 0;
+        dbus_busy_cycles = 0;
 
         fill_level = FILL_DRAM;
-    }
 
-    // destructor
-    ~MEMORY_CONTROLLER() {
-        this->_memory_trace.close();
-    };
+        configure(dram_descriptor());
+    }
 
-    void initialize();
+    void configure(const dram_descriptor &desc), initialize();
 
     // functions
     int  add_rq(PACKET *packet),
          add_wq(PACKET *packet),
          add_pq(PACKET *packet);
 
-    void update_fill_path(PACKET &packet);
+    void update_fill_path(PACKET &packet),
+         record_access(PACKET *packet, bool write);
 
     void return_data(PACKET *packet),
          operate(),
@@ -119,9 +259,18 @@ class MEMORY_CONTROLLER : public MEMORY {
              dram_get_column (uint64_t address),
              drc_check_hit (uint64_t address, uint32_t cpu, uint32_t channel, uint32_t rank, uint32_t bank, uint32_t row);
 
-    uint64_t get_bank_earliest_cycle();
+    uint64_t get_bank_earliest_cycle(),
+             current_cycle(),
+             detailed_latency(uint32_t channel, uint32_t rank, uint32_t bank, uint8_t row_buffer_hit, uint64_t cycle);
+
+    void refresh(uint32_t channel, uint64_t cycle);
 
     int check_dram_queue(PACKET_QUEUE *queue, PACKET *packet);
+
+    BANK_QUEUES &bank_queues(PACKET_QUEUE *queue);
+
+    void bank_enqueue(PACKET_QUEUE *queue, uint32_t index, bool arrival),
+         bank_dequeue(PACKET_QUEUE *queue, uint32_t index);
 };
 
 #endif
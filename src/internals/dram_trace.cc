@@ -0,0 +1,198 @@
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#
+#include "dram_trace.hh"
+
+using namespace champsim;
+
+bool dram_trace_header::valid() const {
+    return std::memcmp(this->magic, expected_magic, sizeof(this->magic)) == 0 &&
+           this->version == current_version &&
+           this->record_size == sizeof(dram_trace_record);
+}
+
+/**
+ * @brief Quotes a path for the shell, single quotes included.
+ */
+static std::string shell_quote(const std::string& path) {
+    std::string quoted = "'";
+
+    for (char c : path) {
+        if (c == '\'')
+            quoted += "'\\''";
+        else
+            quoted += c;
+    }
+
+    return quoted + "'";
+}
+
+dram_trace_writer::dram_trace_writer()
+    : _head(0),
+      _tail(0),
+      _stop(false),
+      _sleeping(false),
+      _failed(false),
+      _file(nullptr),
+      _piped(false) {}
+
+dram_trace_writer::~dram_trace_writer() { this->close(); }
+
+void dram_trace_writer::open(const std::string& path, bool compressed) {
+    dram_trace_header header;
+
+    if (compressed) {
+        std::string cmd = "zstd -q -c > " + shell_quote(path + ".zst");
+
+        this->_file = popen(cmd.c_str(), "w");
+    } else {
+        this->_file = fopen(path.c_str(), "wb");
+    }
+
+    if (this->_file == nullptr) {
+        throw std::runtime_error("Unable to open the DRAM memory trace " +
+                                 path + ".");
+    }
+
+    this->_path = path;
+    this->_piped = compressed;
+
+    std::memcpy(header.magic, dram_trace_header::expected_magic,
+                sizeof(header.magic));
+    header.version = dram_trace_header::current_version;
+    header.record_size = sizeof(dram_trace_record);
+
+    if (fwrite(&header, sizeof(header), 1, this->_file) != 1) {
+        this->_piped ? pclose(this->_file) : fclose(this->_file);
+        this->_file = nullptr;
+
+        throw std::runtime_error("Unable to write the DRAM memory trace " +
+                                 path + ".");
+    }
+
+    this->_ring.reset(new dram_trace_record[ring_size]);
+    this->_head = 0;
+    this->_tail = 0;
+    this->_stop = false;
+    this->_sleeping = false;
+    this->_failed = false;
+    this->_writer = std::thread(&dram_trace_writer::drain, this);
+}
+
+void dram_trace_writer::close() {
+    int status;
+
+    if (!this->is_open()) return;
+
+    this->_stop.store(true, std::memory_order_seq_cst);
+    this->wake();
+    this->_writer.join();
+
+    if (this->_piped)
+        status = pclose(this->_file);
+    else
+        status = fclose(this->_file);
+
+    if (status != 0 || this->_failed) {
+        std::cerr << "Error while writing the DRAM memory trace "
+                  << this->_path << ", the trace is incomplete." << std::endl;
+    }
+
+    this->_file = nullptr;
+    this->_ring.reset();
+}
+
+/**
+ * @brief Wakes the writer thread up. The mutex is taken so that the
+ * notification cannot slip between the check and the wait of the writer.
+ */
+void dram_trace_writer::wake() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    this->_wake.notify_one();
+}
+
+void dram_trace_writer::drain() {
+    std::size_t tail = this->_tail.load(std::memory_order_relaxed);
+
+    while (true) {
+        // The stop flag is read before the head so that no record pushed
+        // before close() can be missed.
+        bool stop = this->_stop.load(std::memory_order_acquire);
+        std::size_t head = this->_head.load(std::memory_order_acquire);
+
+        if (head == tail) {
+            if (stop) break;
+
+            // Sleeping until a batch of records is pending. The flag is raised
+            // before the head is read again, so that either the writer sees
+            // the new records or the simulation thread sees the flag.
+            std::unique_lock<std::mutex> lock(this->_mutex);
+
+            this->_sleeping.store(true, std::memory_order_seq_cst);
+            this->_wake.wait(lock, [this, tail]() {
+                return this->_stop.load(std::memory_order_seq_cst) ||
+                       this->_head.load(std::memory_order_seq_cst) - tail >=
+                           wake_batch;
+            });
+            this->_sleeping.store(false, std::memory_order_relaxed);
+
+            continue;
+        }
+
+        // Writing the largest contiguous chunk of the ring at once. After a
+        // failure, records are still consumed so that the simulation goes on.
+        std::size_t first = tail % ring_size,
+                    count = std::min(head - tail, ring_size - first);
+
+        if (!this->_failed &&
+            fwrite(&this->_ring[first], sizeof(dram_trace_record), count,
+                   this->_file) != count) {
+            this->_failed = true;
+        }
+
+        tail += count;
+        this->_tail.store(tail, std::memory_order_release);
+    }
+
+    if (fflush(this->_file) != 0) this->_failed = true;
+}
+
+dram_trace_reader::dram_trace_reader(const std::string& path)
+    : _file(nullptr), _piped(false) {
+    dram_trace_header header;
+
+    if (path.size() > 4 && path.compare(path.size() - 4, 4, ".zst") == 0) {
+        std::string cmd = "zstd -q -dc " + shell_quote(path);
+
+        this->_file = popen(cmd.c_str(), "r");
+        this->_piped = true;
+    } else {
+        this->_file = fopen(path.c_str(), "rb");
+    }
+
+    if (this->_file == nullptr) {
+        throw std::runtime_error("Unable to open the DRAM memory trace " +
+                                 path + ".");
+    }
+
+    if (fread(&header, sizeof(header), 1, this->_file) != 1 ||
+        !header.valid()) {
+        this->_piped ? pclose(this->_file) : fclose(this->_file);
+        throw std::runtime_error(path + " is not a DRAM memory trace.");
+    }
+}
+
+dram_trace_reader::~dram_trace_reader() {
+    if (this->_file == nullptr) return;
+
+    if (this->_piped)
+        pclose(this->_file);
+    else
+        fclose(this->_file);
+}
+
+bool dram_trace_reader::next(dram_trace_record& rec) {
+    return fread(&rec, sizeof(rec), 1, this->_file) == 1;
+}
@@ -0,0 +1,127 @@
+#ifndef __CHAMPSIM_INTERNALS_DRAM_TRACE_HH__
+#define __CHAMPSIM_INTERNALS_DRAM_TRACE_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace champsim {
+/**
+ * @brief A fixed-size record of the DRAM memory trace. The trace file starts
+ * with a dram_trace_header and is followed by records until the end of file.
+ */
+struct dram_trace_record {
+    enum flag : uint8_t {
+        write = 1 << 0,
+        went_offchip_pred = 1 << 1,
+        l1d_offchip_pred_used = 1 << 2,
+        pf_went_offchip_pred = 1 << 3,
+        pf_went_offchip = 1 << 4,
+    };
+
+    uint64_t address, cycle;
+    uint8_t type, cpu, fill_level, flags;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(dram_trace_record) == 24);
+
+struct dram_trace_header {
+    static constexpr char expected_magic[8] = {'C', 'S', 'D', 'R',
+                                               'A', 'M', 'T', 'R'};
+    static constexpr uint32_t current_version = 1;
+
+    char magic[8];
+    uint32_t version, record_size;
+
+    bool valid() const;
+};
+
+static_assert(sizeof(dram_trace_header) == 16);
+
+/**
+ * @brief Writes the DRAM memory trace from a background thread. The simulation
+ * thread only copies records into a single-producer single-consumer ring,
+ * the writer thread drains it to the trace file, optionally compressed by
+ * piping it through zstd. The ring is only allocated when a trace is opened.
+ *
+ * The writer sleeps on a condition variable until wake_batch records are
+ * pending, so that it is not woken up for every record.
+ */
+class dram_trace_writer {
+   private:
+    static constexpr std::size_t ring_size = 1 << 16,
+                                 wake_batch = ring_size / 8;
+
+    std::unique_ptr<dram_trace_record[]> _ring;
+    std::atomic<std::size_t> _head, _tail;
+    std::atomic<bool> _stop, _sleeping, _failed;
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+
+    std::string _path;
+    FILE* _file;
+    bool _piped;
+    std::thread _writer;
+
+    void drain();
+    void wake();
+
+   public:
+    dram_trace_writer();
+    ~dram_trace_writer();
+
+    dram_trace_writer(const dram_trace_writer&) = delete;
+    dram_trace_writer& operator=(const dram_trace_writer&) = delete;
+
+    void open(const std::string& path, bool compressed), close();
+
+    bool is_open() const { return this->_file != nullptr; }
+
+    void record(const dram_trace_record& rec) {
+        std::size_t head = this->_head.load(std::memory_order_relaxed);
+
+        // The ring is full: wait for the writer rather than dropping records.
+        while (head - this->_tail.load(std::memory_order_acquire) ==
+               ring_size) {
+            std::this_thread::yield();
+        }
+
+        this->_ring[head % ring_size] = rec;
+        this->_head.store(head + 1, std::memory_order_seq_cst);
+
+        if (this->_sleeping.load(std::memory_order_seq_cst) &&
+            head + 1 - this->_tail.load(std::memory_order_relaxed) >=
+                wake_batch) {
+            this->wake();
+        }
+    }
+};
+
+/**
+ * @brief Reads back a DRAM memory trace written by dram_trace_writer,
+ * decompressing it on the fly if the file name ends with .zst.
+ */
+class dram_trace_reader {
+   private:
+    FILE* _file;
+    bool _piped;
+
+   public:
+    dram_trace_reader(const std::string& path);
+    ~dram_trace_reader();
+
+    dram_trace_reader(const dram_trace_reader&) = delete;
+    dram_trace_reader& operator=(const dram_trace_reader&) = delete;
+
+    bool next(dram_trace_record& rec);
+};
+}  // namespace champsim
+
+#endif  // __CHAMPSIM_INTERNALS_DRAM_TRACE_HH__
@@ -0,0 +1,89 @@
+#include <sys/resource.h>
+
+#include <boost/format.hpp>
+#
+#include <internals/host_profiler.hh>
+
+bool champsim::host_profiler::_enabled = false;
+bool champsim::host_profiler::_profiling = false;
+champsim::host_profiler::scope* champsim::host_profiler::_current = nullptr;
+std::array<std::chrono::nanoseconds,
+           champsim::host_profiler::num_components>
+    champsim::host_profiler::_times = {};
+std::chrono::steady_clock::time_point champsim::host_profiler::_begin_time;
+
+/**
+ * @brief Enables the host statistics.
+ * @param profile_components Whether the host time spent in each component
+ * should be measured as well, which slows down the simulation.
+ */
+void champsim::host_profiler::enable(bool profile_components) {
+    _enabled = true;
+    _profiling = profile_components;
+}
+
+bool champsim::host_profiler::enabled() { return _enabled; }
+
+/**
+ * @brief Marks the beginning of the simulation loop.
+ */
+void champsim::host_profiler::start() {
+    _begin_time = std::chrono::steady_clock::now();
+    _times.fill(std::chrono::nanoseconds::zero());
+}
+
+/**
+ * @brief Dumps the throughput of the simulator, its peak resident set size and
+ * the breakdown of the host time per component if it was measured.
+ * @param os The output stream to write to.
+ * @param simulated_instructions The number of instructions retired by all the
+ * modeled cores since the beginning of the simulation loop.
+ */
+void champsim::host_profiler::dump(std::ostream& os,
+                                   uint64_t simulated_instructions) {
+    struct rusage usage;
+    double host_seconds, other_seconds;
+
+    if (!_enabled) return;
+
+    host_seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - _begin_time)
+                       .count();
+    other_seconds = host_seconds;
+
+    getrusage(RUSAGE_SELF, &usage);
+
+    os << std::endl << "Host Statistics" << std::endl;
+    os << (boost::format("Host time: %.3f s Simulated instructions: %u KIPS: "
+                         "%.2f Peak RSS: %.1f MB") %
+           host_seconds % simulated_instructions %
+           (simulated_instructions / host_seconds / 1000.0) %
+           (usage.ru_maxrss / 1024.0))
+       << std::endl;
+
+    if (!_profiling) return;
+
+    for (std::size_t i = 0; i < num_components; i++) {
+        double seconds = std::chrono::duration<double>(_times[i]).count();
+
+        other_seconds -= seconds;
+
+        os << (boost::format("Host time %s: %.3f s (%.1f%%)") %
+               component_name(static_cast<component>(i)) % seconds %
+               (100.0 * seconds / host_seconds))
+           << std::endl;
+    }
+
+    os << (boost::format("Host time other: %.3f s (%.1f%%)") % other_seconds %
+           (100.0 * other_seconds / host_seconds))
+       << std::endl;
+}
+
+const char* champsim::host_profiler::component_name(component comp) {
+    static const char* names[num_components] = {
+        "core", "itlb", "dtlb", "stlb", "l1i",
+        "l1d",  "l2c",  "sdc",  "llc",  "dram",
+    };
+
+    return names[comp];
+}
@@ -0,0 +1,91 @@
+#ifndef __CHAMPSIM_INTERNALS_HOST_PROFILER_HH__
+#define __CHAMPSIM_INTERNALS_HOST_PROFILER_HH__
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace champsim {
+/**
+ * @brief Accounts for the host time spent simulating each component of the
+ * modeled system. Time is only measured once the profiler is enabled
+ * (--host_profile), so that regular simulations do not pay for it.
+ */
+class host_profiler {
+   public:
+    enum component : std::size_t {
+        core = 0,
+        itlb,
+        dtlb,
+        stlb,
+        l1i,
+        l1d,
+        l2c,
+        sdc,
+        llc,
+        dram,
+        num_components,
+    };
+
+    /**
+     * @brief Charges the host time elapsed during its lifetime to a component.
+     * Scopes can be nested, in which case the time spent in inner scopes is
+     * only charged to the inner components.
+     */
+    class scope {
+       private:
+        bool _active;
+        component _comp;
+        std::chrono::steady_clock::time_point _start;
+        std::chrono::nanoseconds _nested;
+        scope* _parent;
+
+       public:
+        scope(component comp) : _active(host_profiler::_profiling) {
+            if (!_active) [[likely]]
+                return;
+
+            this->_comp = comp;
+            this->_nested = std::chrono::nanoseconds::zero();
+            this->_parent = host_profiler::_current;
+            host_profiler::_current = this;
+            this->_start = std::chrono::steady_clock::now();
+        }
+
+        ~scope() {
+            if (!_active) [[likely]]
+                return;
+
+            std::chrono::nanoseconds elapsed =
+                std::chrono::steady_clock::now() - this->_start;
+
+            host_profiler::_times[this->_comp] += elapsed - this->_nested;
+
+            if (this->_parent) this->_parent->_nested += elapsed;
+
+            host_profiler::_current = this->_parent;
+        }
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+    };
+
+   private:
+    static bool _enabled, _profiling;
+    static scope* _current;
+    static std::array<std::chrono::nanoseconds, num_components> _times;
+    static std::chrono::steady_clock::time_point _begin_time;
+
+   public:
+    static void enable(bool profile_components);
+    static bool enabled();
+
+    static void start();
+    static void dump(std::ostream& os, uint64_t simulated_instructions);
+
+    static const char* component_name(component comp);
+};
+}  // namespace champsim
+
+#endif  // __CHAMPSIM_INTERNALS_HOST_PROFILER_HH__
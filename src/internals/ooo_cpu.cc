@@ -1,5 +1,8 @@
 #include <chrono>
 #
+#include <boost/dll.hpp>
+#
+#include <internals/host_profiler.hh>
 #include <internals/simulator.hh>
 #
 #include "ooo_cpu.h"
@@ -10,13 +13,16 @@ using namespace champsim::cpu;
 
 using namespace std::literals;
 
+namespace dll = boost::dll;
+
 // out-of-order core
 O3_CPU ooo_cpu[NUM_CPUS];
 // uint64_t current_core_cycle[NUM_CPUS], stall_cycle[NUM_CPUS];
 uint32_t SCHEDULING_LATENCY = 0, EXEC_LATENCY = 0, DECODE_LATENCY = 0;
 
 O3_CPU::O3_CPU()
-    : fill_path_policy(nullptr),
+    : branch_predictor(nullptr),
+      fill_path_policy(nullptr),
       _warmup_complete(false),
       _simulation_complete(false),
       _stall_cycle(0) {
@@ -76,9 +82,13 @@ O3_CPU::O3_CPU()
     RTE0_tail = 0;
     RTE1_tail = 0;
 
+    sched_head = 0;
+    sched_blocked_until = 0;
+
     for (uint32_t i = 0; i < LQ_SIZE; i++) {
         RTL0[i] = LQ_SIZE;
         RTL1[i] = LQ_SIZE;
+        LQ_free.push(i);
     }
 
     RTL0_head = 0;
@@ -108,6 +118,10 @@ O3_CPU::~O3_CPU() {
     if (this->fill_path_policy) {
         delete this->fill_path_policy;
     }
+
+    if (this->branch_predictor) {
+        delete this->branch_predictor;
+    }
 }
 
 /**
@@ -262,6 +276,31 @@ void O3_CPU::initialize_core(const cpu_descriptor &desc) {
     this->_mm = cc::metadata_cache(16, 2, 512);
 }
 
+/**
+ * @brief Binds the branch predictor named in the core configuration to this
+ * core. The branch predictor statically linked through
+ * CHAMPSIM_BRANCH_PREDICTOR is kept, and called without going through the
+ * ibranchpredictor interface, when it is the one requested. Any other branch
+ * predictor is loaded as a plugin.
+ *
+ * @param name The name of the branch predictor.
+ */
+void O3_CPU::init_branch_predictor(const std::string &name) {
+    std::string branch_predictor_path = "./branch_predictors/" + name,
+                branch_predictor_config_path =
+                    "config/branch_predictors/" + name + ".json";
+
+    if (name == CHAMPSIM_BRANCH_PREDICTOR) return;
+
+    this->branch_predictor_callable =
+        dll::import_alias<cb::ibranchpredictor *()>(
+            branch_predictor_path, "create_branchpredictor",
+            dll::load_mode::append_decorations);
+
+    this->branch_predictor = this->branch_predictor_callable();
+    this->branch_predictor->init(branch_predictor_config_path, this);
+}
+
 void O3_CPU::initialize_instruction(ooo_model_instr &instr) {
     bool reads_sp = false, writes_sp = false, reads_flags = false,
          reads_ip = false, writes_ip = false, reads_other = false;
@@ -894,6 +933,16 @@ uint32_t O3_CPU::add_to_rob(ooo_model_instr *arch_instr) {
     ROB.entry[index] = *arch_instr;
     ROB.entry[index].event_cycle = this->_current_core_cycle;
 
+    for (uint32_t i = 0; i < helper::MAX_INSTR_DESTINATIONS; i++) {
+        uint64_t address = ROB.entry[index].destination_memory[i];
+
+        if (address == 0) continue;
+
+        std::vector<uint32_t> &writers = store_writers[address];
+        if (writers.empty() || writers.back() != index)
+            writers.push_back(index);
+    }
+
     ROB.occupancy++;
     ROB.tail++;
     if (ROB.tail >= ROB.SIZE) ROB.tail = 0;
@@ -990,40 +1039,45 @@ uint32_t O3_CPU::add_to_decode_buffer(ooo_model_instr *arch_instr) {
 uint32_t O3_CPU::check_rob(uint64_t instr_id) {
     if ((ROB.head == ROB.tail) && ROB.occupancy == 0) return ROB.SIZE;
 
-    if (ROB.head < ROB.tail) {
-        for (uint32_t i = ROB.head; i < ROB.tail; i++) {
-            if (ROB.entry[i].instr_id == instr_id) {
-                DP(if (warmup_complete[ROB.cpu]) {
-                    cout << "[ROB] " << __func__
-                         << " same instr_id: " << ROB.entry[i].instr_id;
-                    cout << " rob_index: " << i << endl;
-                });
-                return i;
-            }
-        }
-    } else {
-        for (uint32_t i = ROB.head; i < ROB.SIZE; i++) {
-            if (ROB.entry[i].instr_id == instr_id) {
-                DP(if (warmup_complete[cpu]) {
-                    cout << "[ROB] " << __func__
-                         << " same instr_id: " << ROB.entry[i].instr_id;
-                    cout << " rob_index: " << i << endl;
-                });
-                return i;
-            }
-        }
-        for (uint32_t i = 0; i < ROB.tail; i++) {
-            if (ROB.entry[i].instr_id == instr_id) {
-                DP(if (warmup_complete[cpu]) {
-                    cout << "[ROB] " << __func__
-                         << " same instr_id: " << ROB.entry[i].instr_id;
-                    cout << " rob_index: " << i << endl;
-                });
-                return i;
-            }
+    // instruction ids are handed out consecutively and every instruction
+    // enters the ROB in program order, so an instruction sits at a fixed
+    // offset from the head of the ROB
+    uint32_t rob_index = ROB.SIZE;
+    uint64_t head_id = ROB.entry[ROB.head].instr_id;
+
+    if ((instr_id >= head_id) && (instr_id - head_id < ROB.occupancy)) {
+        uint32_t index = (ROB.head + (instr_id - head_id)) % ROB.SIZE;
+        if (ROB.entry[index].instr_id == instr_id) rob_index = index;
+    }
+
+#ifdef ROB_SANITY_CHECK
+    // cross-check the direct lookup against a scan of the occupied entries
+    uint32_t scanned_index = ROB.SIZE;
+    for (uint32_t i = 0; i < ROB.occupancy; i++) {
+        uint32_t index = (ROB.head + i) % ROB.SIZE;
+        if (ROB.entry[index].instr_id == instr_id) {
+            scanned_index = index;
+            break;
         }
     }
 
+    if (scanned_index != rob_index) {
+        cerr << "[ROB_ERROR] " << __func__ << " direct lookup returned "
+             << rob_index << " but the ROB holds instr_id: " << instr_id
+             << " at rob_index: " << scanned_index << endl;
+        assert(0);
+    }
+#endif
+
+    if (rob_index != ROB.SIZE) {
+        DP(if (warmup_complete[cpu]) {
+            cout << "[ROB] " << __func__
+                 << " same instr_id: " << ROB.entry[rob_index].instr_id;
+            cout << " rob_index: " << rob_index << endl;
+        });
+        return rob_index;
+    }
+
     cerr << "[ROB_ERROR] " << __func__ << " does not have any matching index! ";
     cerr << " instr_id: " << instr_id << endl;
     assert(0);
@@ -1090,7 +1144,9 @@ void O3_CPU::fetch_instruction() {
             trace_packet.asid[1] = 0;
             trace_packet.event_cycle = this->_current_core_cycle;
 
-            if ((rq_index = ITLB.add_rq(&trace_packet)) != -2) {
+            if ((rq_index = (this->tlb
+                                 ? this->tlb->add_instruction_rq(&trace_packet)
+                                 : ITLB->add_rq(&trace_packet))) != -2) {
                 // successfully sent to the ITLB, so mark all instructions in
                 // the IFETCH_BUFFER that match this ip as translated INFLIGHT
                 for (uint32_t j = 0; j < IFETCH_BUFFER.SIZE; j++) {
@@ -1326,42 +1382,52 @@ int O3_CPU::prefetch_code_line(uint64_t pf_v_addr) {
 // I. Instruction is fetched
 // II. Instruction is completed
 // III. Instruction is retired
-void O3_CPU::schedule_instruction() {
-    if ((ROB.head == ROB.tail) && ROB.occupancy == 0) return;
-
-    num_searched = 0;
-    if (ROB.head < ROB.tail) {
-        for (uint32_t i = ROB.head; i < ROB.tail; i++) {
-            if ((ROB.entry[i].fetched != COMPLETED) ||
-                (ROB.entry[i].event_cycle > this->_current_core_cycle) ||
-                (num_searched >= SCHEDULER_SIZE))
-                return;
+/**
+ * @brief Tells whether a scheduled instruction is not ready yet, which stalls
+ * scheduling as the in-order scan of the ROB would. sched_blocked_until only
+ * grows, so before stalling on it, it is re-derived from the scheduled
+ * instructions, oldest first, whose cycles may have been brought forward.
+ */
+bool O3_CPU::scheduling_blocked() {
+    if (sched_blocked_until <= this->_current_core_cycle) return false;
 
-            if (ROB.entry[i].scheduled == 0) do_scheduling(i);
+    uint32_t i = ROB.head;
 
-            if (ROB.entry[i].executed == 0) num_searched++;
+    for (uint32_t n = 0; n < ROB.occupancy && ROB.entry[i].scheduled != 0;
+         n++) {
+        if (ROB.entry[i].event_cycle > this->_current_core_cycle) {
+            sched_blocked_until = ROB.entry[i].event_cycle;
+            return true;
         }
-    } else {
-        for (uint32_t i = ROB.head; i < ROB.SIZE; i++) {
-            if ((ROB.entry[i].fetched != COMPLETED) ||
-                (ROB.entry[i].event_cycle > this->_current_core_cycle) ||
-                (num_searched >= SCHEDULER_SIZE))
-                return;
 
-            if (ROB.entry[i].scheduled == 0) do_scheduling(i);
+        i++;
+        if (i == ROB.SIZE) i = 0;
+    }
 
-            if (ROB.entry[i].executed == 0) num_searched++;
-        }
-        for (uint32_t i = 0; i < ROB.tail; i++) {
-            if ((ROB.entry[i].fetched != COMPLETED) ||
-                (ROB.entry[i].event_cycle > this->_current_core_cycle) ||
-                (num_searched >= SCHEDULER_SIZE))
-                return;
+    sched_blocked_until = 0;
 
-            if (ROB.entry[i].scheduled == 0) do_scheduling(i);
+    return false;
+}
 
-            if (ROB.entry[i].executed == 0) num_searched++;
-        }
+void O3_CPU::schedule_instruction() {
+    if (scheduling_blocked()) return;
+
+    // instructions are scheduled in order, from the oldest one that is not
+    // scheduled yet, while the scheduler window has room
+    num_searched = issue_queue.size();
+
+    while (ROB.entry[sched_head].scheduled == 0) {
+        if ((ROB.entry[sched_head].fetched != COMPLETED) ||
+            (ROB.entry[sched_head].event_cycle > this->_current_core_cycle) ||
+            (num_searched >= SCHEDULER_SIZE))
+            return;
+
+        do_scheduling(sched_head);
+
+        if (ROB.entry[sched_head].executed == 0) num_searched++;
+
+        sched_head++;
+        if (sched_head == ROB.SIZE) sched_head = 0;
     }
 }
 
@@ -1371,6 +1437,8 @@ void O3_CPU::do_scheduling(uint32_t rob_index) {
 
     reg_dependency(rob_index);
 
+    issue_queue.insert(rob_index);
+
     if (ROB.entry[rob_index].is_memory)
         ROB.entry[rob_index].scheduled = INFLIGHT;
     else {
@@ -1383,6 +1451,9 @@ void O3_CPU::do_scheduling(uint32_t rob_index) {
         else
             ROB.entry[rob_index].event_cycle += SCHEDULING_LATENCY;
 
+        sched_blocked_until =
+            std::max(sched_blocked_until, ROB.entry[rob_index].event_cycle);
+
         if (ROB.entry[rob_index].reg_ready) {
 #ifdef SANITY_CHECK
             if (RTE1[RTE1_tail] < ROB_SIZE) assert(0);
@@ -1427,38 +1498,54 @@ void O3_CPU::reg_dependency(uint32_t rob_index) {
         }
     });
 
-    // check RAW dependency
-    int prior = rob_index - 1;
-    if (prior < 0) prior = ROB.SIZE - 1;
-
-    if (rob_index != ROB.head) {
-        if ((int)ROB.head <= prior) {
-            for (int i = prior; i >= (int)ROB.head; i--)
-                if (ROB.entry[i].executed != COMPLETED) {
-                    for (uint32_t j = 0; j < NUM_INSTR_SOURCES; j++) {
-                        if (ROB.entry[rob_index].source_registers[j] &&
-                            (ROB.entry[rob_index].reg_RAW_checked[j] == 0))
-                            reg_RAW_dependency(i, rob_index, j);
-                    }
-                }
-        } else {
-            for (int i = prior; i >= 0; i--)
-                if (ROB.entry[i].executed != COMPLETED) {
-                    for (uint32_t j = 0; j < NUM_INSTR_SOURCES; j++) {
-                        if (ROB.entry[rob_index].source_registers[j] &&
-                            (ROB.entry[rob_index].reg_RAW_checked[j] == 0))
-                            reg_RAW_dependency(i, rob_index, j);
-                    }
-                }
-            for (int i = ROB.SIZE - 1; i >= (int)ROB.head; i--)
-                if (ROB.entry[i].executed != COMPLETED) {
-                    for (uint32_t j = 0; j < NUM_INSTR_SOURCES; j++) {
-                        if (ROB.entry[rob_index].source_registers[j] &&
-                            (ROB.entry[rob_index].reg_RAW_checked[j] == 0))
-                            reg_RAW_dependency(i, rob_index, j);
-                    }
-                }
-        }
+    // check RAW dependency against the youngest older writer of each source
+    // register that has not completed yet. Dependencies are recorded from the
+    // youngest producer to the oldest, as a backward walk over the ROB would.
+    std::array<std::pair<uint32_t, uint32_t>, NUM_INSTR_SOURCES> producers;
+    std::size_t num_producers = 0;
+
+    for (uint32_t j = 0; j < NUM_INSTR_SOURCES; j++) {
+        uint8_t reg = ROB.entry[rob_index].source_registers[j];
+
+        if (reg && !ROB.entry[rob_index].reg_RAW_checked[j] &&
+            !reg_writers[reg].empty())
+            producers[num_producers++] =
+                std::make_pair(reg_writers[reg].back(), j);
+    }
+
+    std::stable_sort(producers.begin(), producers.begin() + num_producers,
+                     [this](const std::pair<uint32_t, uint32_t> &a,
+                            const std::pair<uint32_t, uint32_t> &b) {
+                         return ((a.first + ROB.SIZE - ROB.head) % ROB.SIZE) >
+                                ((b.first + ROB.SIZE - ROB.head) % ROB.SIZE);
+                     });
+
+    for (std::size_t k = 0; k < num_producers; k++)
+        reg_RAW_dependency(producers[k].first, rob_index, producers[k].second);
+
+    reg_rename(rob_index);
+}
+
+void O3_CPU::reg_rename(uint32_t rob_index) {
+    for (uint32_t i = 0; i < helper::MAX_INSTR_DESTINATIONS; i++) {
+        uint8_t reg = ROB.entry[rob_index].destination_registers[i];
+
+        if (reg && (reg_writers[reg].empty() ||
+                    reg_writers[reg].back() != rob_index))
+            reg_writers[reg].push_back(rob_index);
+    }
+}
+
+void O3_CPU::reg_rename_release(uint32_t rob_index) {
+    for (uint32_t i = 0; i < helper::MAX_INSTR_DESTINATIONS; i++) {
+        uint8_t reg = ROB.entry[rob_index].destination_registers[i];
+
+        if (reg == 0) continue;
+
+        auto it = std::find(reg_writers[reg].begin(), reg_writers[reg].end(),
+                            rob_index);
+
+        if (it != reg_writers[reg].end()) reg_writers[reg].erase(it);
     }
 }
 
@@ -1516,6 +1603,10 @@ void O3_CPU::execute_instruction() {
                 RTE0_head++;
                 if (RTE0_head == ROB_SIZE) RTE0_head = 0;
                 exec_issued++;
+            } else {
+                // the queue is in wake-up order, nothing behind its head
+                // issues before it
+                break;
             }
         } else {
             // DP (if (warmup_complete[cpu]) {
@@ -1540,6 +1631,8 @@ void O3_CPU::execute_instruction() {
                 RTE1_head++;
                 if (RTE1_head == ROB_SIZE) RTE1_head = 0;
                 exec_issued++;
+            } else {
+                break;
             }
         } else {
             // DP (if (warmup_complete[cpu]) {
@@ -1562,6 +1655,8 @@ void O3_CPU::do_execution(uint32_t rob_index) {
     // current_core_cycle[cpu] << endl;
 
     ROB.entry[rob_index].executed = INFLIGHT;
+    issue_queue.erase(rob_index);
+    completion_queue.insert(rob_index);
 
     // ADD LATENCY
     if (ROB.entry[rob_index].event_cycle < this->_current_core_cycle)
@@ -1570,6 +1665,9 @@ void O3_CPU::do_execution(uint32_t rob_index) {
     else
         ROB.entry[rob_index].event_cycle += EXEC_LATENCY;
 
+    sched_blocked_until =
+        std::max(sched_blocked_until, ROB.entry[rob_index].event_cycle);
+
     inflight_reg_executions++;
 
     DP(if (warmup_complete[cpu]) {
@@ -1610,50 +1708,24 @@ uint8_t O3_CPU::mem_reg_dependence_resolved(uint32_t rob_index) {
 }
 
 void O3_CPU::schedule_memory_instruction() {
-    if ((ROB.head == ROB.tail) && ROB.occupancy == 0) return;
+    if (scheduling_blocked()) return;
 
     // execution is out-of-order but we have an in-order scheduling algorithm to
-    // detect all RAW dependencies
+    // detect all RAW dependencies: the scheduled instructions that did not
+    // start executing are visited oldest first, while the scheduler window has
+    // room
     num_searched = 0;
-    if (ROB.head < ROB.tail) {
-        for (uint32_t i = ROB.head; i < ROB.tail; i++) {
-            if ((ROB.entry[i].fetched != COMPLETED) ||
-                (ROB.entry[i].event_cycle > this->_current_core_cycle) ||
-                (num_searched >= SCHEDULER_SIZE))
-                break;
-
-            if (ROB.entry[i].is_memory && mem_reg_dependence_resolved(i) &&
-                (ROB.entry[i].scheduled == INFLIGHT))
-                do_memory_scheduling(i);
+    issue_queue.walk(ROB.head, [this](std::size_t i) {
+        if (num_searched >= SCHEDULER_SIZE) return false;
 
-            if (ROB.entry[i].executed == 0) num_searched++;
-        }
-    } else {
-        for (uint32_t i = ROB.head; i < ROB.SIZE; i++) {
-            if ((ROB.entry[i].fetched != COMPLETED) ||
-                (ROB.entry[i].event_cycle > this->_current_core_cycle) ||
-                (num_searched >= SCHEDULER_SIZE))
-                break;
+        if (ROB.entry[i].is_memory && mem_reg_dependence_resolved(i) &&
+            (ROB.entry[i].scheduled == INFLIGHT))
+            do_memory_scheduling(i);
 
-            if (ROB.entry[i].is_memory && mem_reg_dependence_resolved(i) &&
-                (ROB.entry[i].scheduled == INFLIGHT))
-                do_memory_scheduling(i);
+        if (ROB.entry[i].executed == 0) num_searched++;
 
-            if (ROB.entry[i].executed == 0) num_searched++;
-        }
-        for (uint32_t i = 0; i < ROB.tail; i++) {
-            if ((ROB.entry[i].fetched != COMPLETED) ||
-                (ROB.entry[i].event_cycle > this->_current_core_cycle) ||
-                (num_searched >= SCHEDULER_SIZE))
-                break;
-
-            if (ROB.entry[i].is_memory && mem_reg_dependence_resolved(i) &&
-                (ROB.entry[i].scheduled == INFLIGHT))
-                do_memory_scheduling(i);
-
-            if (ROB.entry[i].executed == 0) num_searched++;
-        }
-    }
+        return true;
+    });
 }
 
 void O3_CPU::execute_memory_instruction() {
@@ -1665,11 +1737,12 @@ void O3_CPU::do_memory_scheduling(uint32_t rob_index) {
     uint32_t not_available = check_and_add_lsq(rob_index);
     if (not_available == 0) {
         ROB.entry[rob_index].scheduled = COMPLETED;
-        if (ROB.entry[rob_index].executed ==
-            0)  // it could be already set to COMPLETED due to store-to-load
-                // forwarding
+        // it could be already set to COMPLETED due to store-to-load forwarding
+        if (ROB.entry[rob_index].executed == 0)
             ROB.entry[rob_index].executed = INFLIGHT;
 
+        issue_queue.erase(rob_index);
+
         DP(if (warmup_complete[cpu]) {
             cout << "[ROB] " << __func__
                  << " instr_id: " << ROB.entry[rob_index].instr_id
@@ -1741,22 +1814,16 @@ uint32_t O3_CPU::check_and_add_lsq(uint32_t rob_index) {
 }
 
 void O3_CPU::add_load_queue(uint32_t rob_index, uint32_t data_index) {
-    // search for an empty slot
-    uint32_t lq_index = LQ.SIZE;
-    for (uint32_t i = 0; i < LQ.SIZE; i++) {
-        if (LQ.entry[i].virtual_address == 0) {
-            lq_index = i;
-            break;
-        }
-    }
-
-    // sanity check
-    if (lq_index == LQ.SIZE) {
+    // take the lowest empty slot
+    if (LQ_free.empty()) {
         cerr << "instr_id: " << ROB.entry[rob_index].instr_id
              << " no empty slot in the load queue!!!" << endl;
         assert(0);
     }
 
+    uint32_t lq_index = LQ_free.top();
+    LQ_free.pop();
+
     // add it to the load queue
     ROB.entry[rob_index].lq_index[data_index] = lq_index;
     LQ.entry[lq_index].instr_id = ROB.entry[rob_index].instr_id;
@@ -1780,27 +1847,20 @@ void O3_CPU::add_load_queue(uint32_t rob_index, uint32_t data_index) {
 
     LQ.occupancy++;
 
-    // check RAW dependency
-    int prior = rob_index - 1;
-    if (prior < 0) prior = ROB.SIZE - 1;
-
-    if (rob_index != ROB.head) {
-        if ((int)ROB.head <= prior) {
-            for (int i = prior; i >= (int)ROB.head; i--) {
-                if (LQ.entry[lq_index].producer_id != UINT64_MAX) break;
+    // check RAW dependency: the producer is the youngest older store to the
+    // same address still in the ROB
+    auto writers = store_writers.find(LQ.entry[lq_index].virtual_address);
+    uint32_t producer = ROB.SIZE;
 
-                mem_RAW_dependency(i, rob_index, data_index, lq_index);
-            }
-        } else {
-            for (int i = prior; i >= 0; i--) {
-                if (LQ.entry[lq_index].producer_id != UINT64_MAX) break;
+    if (writers != store_writers.end() && rob_index != ROB.head) {
+        uint32_t age = (rob_index + ROB.SIZE - ROB.head) % ROB.SIZE;
 
-                mem_RAW_dependency(i, rob_index, data_index, lq_index);
-            }
-            for (int i = ROB.SIZE - 1; i >= (int)ROB.head; i--) {
-                if (LQ.entry[lq_index].producer_id != UINT64_MAX) break;
-
-                mem_RAW_dependency(i, rob_index, data_index, lq_index);
+        for (auto it = writers->second.rbegin(); it != writers->second.rend();
+             ++it) {
+            if ((*it + ROB.SIZE - ROB.head) % ROB.SIZE < age) {
+                producer = *it;
+                mem_RAW_dependency(producer, rob_index, data_index, lq_index);
+                break;
             }
         }
     }
@@ -1808,26 +1868,31 @@ void O3_CPU::add_load_queue(uint32_t rob_index, uint32_t data_index) {
     // check
     // 1) if store-to-load forwarding is possible
     // 2) if there is WAR that are not correctly executed
+    // only the stores indexed under the load address can match
     uint32_t forwarding_index = SQ.SIZE;
-    for (uint32_t i = 0; i < SQ.SIZE; i++) {
-        // skip empty slot
-        if (SQ.entry[i].virtual_address == 0) continue;
-
+    if (producer != ROB.SIZE) {
         // forwarding should be done by the SQ entry that holds the same
         // producer_id from RAW dependency check
-        if (SQ.entry[i].virtual_address ==
-            LQ.entry[lq_index]
-                .virtual_address) {  // store-to-load forwarding check
-
-            // forwarding store is in the SQ
-            if ((rob_index != ROB.head) && (LQ.entry[lq_index].producer_id ==
-                                            SQ.entry[i].instr_id)) {  // RAW
-                forwarding_index = i;
-                break;  // should be break
+        for (uint32_t i = 0; i < helper::MAX_INSTR_DESTINATIONS; i++) {
+            uint32_t sq_index = ROB.entry[producer].sq_index[i];
+
+            if ((ROB.entry[producer].destination_memory[i] ==
+                 LQ.entry[lq_index].virtual_address) &&
+                (sq_index != UINT32_MAX) && (sq_index < forwarding_index))
+                forwarding_index = sq_index;
+        }
+    } else if (writers != store_writers.end()) {
+        for (uint32_t store : writers->second) {
+            bool in_sq = false;
+            for (uint32_t i = 0; i < helper::MAX_INSTR_DESTINATIONS; i++) {
+                if ((ROB.entry[store].destination_memory[i] ==
+                     LQ.entry[lq_index].virtual_address) &&
+                    (ROB.entry[store].sq_index[i] != UINT32_MAX))
+                    in_sq = true;
             }
 
-            if ((LQ.entry[lq_index].producer_id == UINT64_MAX) &&
-                (LQ.entry[lq_index].instr_id <= SQ.entry[i].instr_id)) {  // WAR
+            if (in_sq && (LQ.entry[lq_index].instr_id <=
+                          ROB.entry[store].instr_id)) {  // WAR
                 // a load is about to be added in the load queue and we found a
                 // store that is "logically later in the program order but
                 // already executed" => this is not correctly executed WAR due
@@ -1857,7 +1922,7 @@ void O3_CPU::add_load_queue(uint32_t rob_index, uint32_t data_index) {
                          << " instr_id: " << LQ.entry[lq_index].instr_id
                          << " reset fetched: " << +LQ.entry[lq_index].fetched;
                     cout << " to obey WAR store instr_id: "
-                         << SQ.entry[i].instr_id
+                         << ROB.entry[store].instr_id
                          << " cycle: " << current_core_cycle[cpu] << endl;
                 });
             }
@@ -1886,7 +1951,7 @@ void O3_CPU::add_load_queue(uint32_t rob_index, uint32_t data_index) {
                 assert(0);
             }
             if (ROB.entry[fwr_rob_index].num_mem_ops == 0)
-                inflight_mem_executions++;
+                mem_ops_completed(fwr_rob_index);
 
             DP(if (warmup_complete[cpu]) {
                 cout << "[LQ] " << __func__
@@ -2080,7 +2145,8 @@ void O3_CPU::operate_lsq() {
                          << endl;
                 });
 
-                int rq_index = DTLB.add_rq(&data_packet);
+                int rq_index = this->tlb ? this->tlb->add_data_rq(&data_packet)
+                                         : DTLB->add_rq(&data_packet);
 
                 if (rq_index == -2)
                     break;
@@ -2171,7 +2237,8 @@ void O3_CPU::operate_lsq() {
                          << endl;
                 });
 
-                int rq_index = DTLB.add_rq(&data_packet);
+                int rq_index = this->tlb ? this->tlb->add_data_rq(&data_packet)
+                                         : DTLB->add_rq(&data_packet);
 
                 if (rq_index == -2)
                     break;  // break here
@@ -2235,7 +2302,7 @@ void O3_CPU::execute_store(uint32_t rob_index, uint32_t sq_index,
         cerr << "instr_id: " << ROB.entry[rob_index].instr_id << endl;
         assert(0);
     }
-    if (ROB.entry[rob_index].num_mem_ops == 0) inflight_mem_executions++;
+    if (ROB.entry[rob_index].num_mem_ops == 0) mem_ops_completed(rob_index);
 
     DP(if (warmup_complete[cpu]) {
         cout << "[SQ1] " << __func__
@@ -2299,7 +2366,7 @@ void O3_CPU::execute_store(uint32_t rob_index, uint32_t sq_index,
                         }
 #endif
                         if (ROB.entry[fwr_rob_index].num_mem_ops == 0)
-                            inflight_mem_executions++;
+                            mem_ops_completed(fwr_rob_index);
 
                         DP(if (warmup_complete[cpu]) {
                             cout << "[LQ3] " << __func__
@@ -2375,6 +2442,7 @@ void O3_CPU::complete_execution(uint32_t rob_index) {
         if ((ROB.entry[rob_index].executed == INFLIGHT) &&
             (ROB.entry[rob_index].event_cycle <= this->_current_core_cycle)) {
             ROB.entry[rob_index].executed = COMPLETED;
+            reg_rename_release(rob_index);
             inflight_reg_executions--;
             completed_executions++;
 
@@ -2401,6 +2469,7 @@ void O3_CPU::complete_execution(uint32_t rob_index) {
                 (ROB.entry[rob_index].event_cycle <=
                  this->_current_core_cycle)) {
                 ROB.entry[rob_index].executed = COMPLETED;
+                reg_rename_release(rob_index);
                 inflight_mem_executions--;
                 completed_executions++;
 
@@ -2427,6 +2496,15 @@ void O3_CPU::complete_execution(uint32_t rob_index) {
     }
 }
 
+/**
+ * @brief Queues a memory instruction whose operations are all done for
+ * completion.
+ */
+void O3_CPU::mem_ops_completed(uint32_t rob_index) {
+    inflight_mem_executions++;
+    completion_queue.insert(rob_index);
+}
+
 void O3_CPU::reg_RAW_release(uint32_t rob_index) {
     // if (!ROB.entry[rob_index].registers_instrs_depend_on_me.empty())
 
@@ -2480,24 +2558,55 @@ void O3_CPU::reg_RAW_release(uint32_t rob_index) {
 }
 
 void O3_CPU::operate_cache() {
-    ITLB.operate();
-    DTLB.operate();
-    STLB.operate();
+    if (this->tlb) {
+        champsim::host_profiler::scope s(champsim::host_profiler::dtlb);
+        this->tlb->operate();
+    } else {
+        {
+            champsim::host_profiler::scope s(champsim::host_profiler::itlb);
+            ITLB->operate();
+        }
+        {
+            champsim::host_profiler::scope s(champsim::host_profiler::dtlb);
+            DTLB->operate();
+        }
+        {
+            champsim::host_profiler::scope s(champsim::host_profiler::stlb);
+            STLB->operate();
+        }
+    }
 
-    this->l1i->operate();
-    this->l1d->operate();
-    this->l2c->operate();
-    this->sdc->operate();
+    {
+        champsim::host_profiler::scope s(champsim::host_profiler::l1i);
+        this->l1i->operate();
+    }
+    {
+        champsim::host_profiler::scope s(champsim::host_profiler::l1d);
+        this->l1d->operate();
+    }
+    {
+        champsim::host_profiler::scope s(champsim::host_profiler::l2c);
+        this->l2c->operate();
+    }
+    {
+        champsim::host_profiler::scope s(champsim::host_profiler::sdc);
+        this->sdc->operate();
+    }
 
     // also handle per-cycle prefetcher operation
     l1i_prefetcher_cycle_operate();
 }
 
 void O3_CPU::update_rob() {
-    if (ITLB.PROCESSED.occupancy &&
-        (ITLB.PROCESSED.entry[ITLB.PROCESSED.head].event_cycle <=
+    PACKET_QUEUE &itlb_processed =
+                     this->tlb ? this->tlb->ITLB_PROCESSED : ITLB->PROCESSED,
+                 &dtlb_processed =
+                     this->tlb ? this->tlb->DTLB_PROCESSED : DTLB->PROCESSED;
+
+    if (itlb_processed.occupancy &&
+        (itlb_processed.entry[itlb_processed.head].event_cycle <=
          this->_current_core_cycle))
-        complete_instr_fetch(&ITLB.PROCESSED, 1);
+        complete_instr_fetch(&itlb_processed, 1);
 
     // Marks the related entries in either the store queue and the load queue as
     // completed.
@@ -2508,10 +2617,10 @@ void O3_CPU::update_rob() {
         complete_instr_fetch(this->l1i->processed_queue(), false);
     }
 
-    if (DTLB.PROCESSED.occupancy &&
-        (DTLB.PROCESSED.entry[DTLB.PROCESSED.head].event_cycle <=
+    if (dtlb_processed.occupancy &&
+        (dtlb_processed.entry[dtlb_processed.head].event_cycle <=
          this->_current_core_cycle))
-        complete_data_fetch(&DTLB.PROCESSED, 1);
+        complete_data_fetch(&dtlb_processed, 1);
 
     // Marks the related entries in either the store queue and the load queue as
     // completed.
@@ -2535,17 +2644,15 @@ void O3_CPU::update_rob() {
     //     complete_data_fetch(&uncore.DRAM.PROCESSED, false);
     // }
 
-    // update ROB entries with completed executions
-    if ((inflight_reg_executions > 0) || (inflight_mem_executions > 0)) {
-        if (ROB.head < ROB.tail) {
-            for (uint32_t i = ROB.head; i < ROB.tail; i++)
-                complete_execution(i);
-        } else {
-            for (uint32_t i = ROB.head; i < ROB.SIZE; i++)
-                complete_execution(i);
-            for (uint32_t i = 0; i < ROB.tail; i++) complete_execution(i);
-        }
-    }
+    // update ROB entries with completed executions, only visiting the
+    // instructions queued for completion, oldest first
+    completion_queue.walk(ROB.head, [this](std::size_t i) {
+        complete_execution(i);
+
+        if (ROB.entry[i].executed == COMPLETED) completion_queue.erase(i);
+
+        return true;
+    });
 }
 
 void O3_CPU::complete_instr_fetch(PACKET_QUEUE *queue, uint8_t is_it_tlb) {
@@ -2804,7 +2911,7 @@ void O3_CPU::complete_data_fetch(PACKET_QUEUE *queue, uint8_t is_it_tlb) {
             }
 #endif
             if (ROB.entry[rob_index].num_mem_ops == 0)
-                inflight_mem_executions++;
+                mem_ops_completed(rob_index);
 
             DP(if (warmup_complete[cpu]) {
                 cout << "[ROB] " << __func__
@@ -3246,7 +3353,7 @@ void O3_CPU::handle_merged_load(PACKET *provider) {
 #endif
 
         if (ROB.entry[merged_rob_index].num_mem_ops == 0)
-            inflight_mem_executions++;
+            mem_ops_completed(merged_rob_index);
 
         DP(if (warmup_complete[cpu]) {
             cout << "[ROB] " << __func__
@@ -3286,6 +3393,8 @@ void O3_CPU::release_load_queue(uint32_t lq_index) {
 
 #endif  // !defined(ENABLE_DCLR)
 
+    if (LQ.entry[lq_index].virtual_address) LQ_free.push(lq_index);
+
     LSQ_ENTRY empty_entry;
     LQ.entry[lq_index] = empty_entry;
     LQ.occupancy--;
@@ -3432,6 +3541,19 @@ void O3_CPU::retire_rob() {
             }
         }
 
+        // drop the retiring stores from the in-flight store index
+        for (uint32_t i = 0; i < helper::MAX_INSTR_DESTINATIONS; i++) {
+            uint64_t address = ROB.entry[ROB.head].destination_memory[i];
+            if (address == 0) continue;
+
+            auto writers = store_writers.find(address);
+            if (writers == store_writers.end()) continue;
+
+            if (writers->second.front() == ROB.head)
+                writers->second.erase(writers->second.begin());
+            if (writers->second.empty()) store_writers.erase(writers);
+        }
+
         // release ROB entry
         DP(if (warmup_complete[cpu]) {
             cout << "[ROB] " << __func__
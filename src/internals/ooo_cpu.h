@@ -1,18 +1,29 @@
 #ifndef OOO_CPU_H
 #define OOO_CPU_H
 
+#include <array>
+#include <map>
+#include <memory>
+#include <queue>
+#include <unordered_map>
 #include <vector>
 #
 #include <chrono>
+#include <functional>
 #
 #include "cache.h"
 #
 #include <instruction_reader.hh>
 #
+#include <internals/slot_queue.hh>
+#
+#include <internals/branch_predictors/ibranchpredictor.hh>
+#
 #include <internals/components/cache.hh>
 #include <internals/components/irreg_access_pred.hh>
 #include <internals/components/miss_map.hh>
 #include <internals/components/offchip_pred_perc.hh>
+#include <internals/components/tlb.hh>
 #
 #include <internals/policies/fill_path_policies.hh>
 
@@ -26,6 +37,7 @@
 using namespace std;
 using namespace champsim::cpu;
 
+namespace cb = champsim::branch_predictors;
 namespace cc = champsim::components;
 namespace cpol = champsim::policies;
 
@@ -94,6 +106,10 @@ struct cpu_descriptor {
     std::string l1d_config_file, l1i_config_file, l2c_config_file,
         sdc_config_file;
 
+    std::string branch_predictor;
+
+    std::string tlb_model;
+
    public:
     cpu_descriptor() = default;
 };
@@ -152,6 +168,31 @@ class O3_CPU {
     uint32_t RTS0[SQ_SIZE], RTS0_head, RTS0_tail, RTS1[SQ_SIZE], RTS1_head,
         RTS1_tail;
 
+    // Rename table: for each architectural register, the ROB indices of the
+    // scheduled instructions writing it that have not completed yet, oldest
+    // first.
+    std::array<std::vector<uint32_t>, 256> reg_writers;
+
+    // In-flight store index: for each store address, the ROB indices of the
+    // instructions writing it that have not retired yet, oldest first.
+    std::unordered_map<uint64_t, std::vector<uint32_t>> store_writers;
+
+    // Free load queue slots, lowest index first.
+    std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>>
+        LQ_free;
+
+    // Scheduler. The ROB entries from its head to sched_head are scheduled,
+    // the ones from sched_head to its tail are waiting to be, in order. The
+    // issue queue holds the scheduled instructions that did not start
+    // executing, the completion queue the executing ones that may complete.
+    // Scheduling stalls until sched_blocked_until, the latest cycle at which a
+    // scheduled instruction becomes ready. Completions may bring the cycle of
+    // an instruction forward, so the stall is checked against the scheduled
+    // instructions before being applied.
+    uint32_t sched_head;
+    uint64_t sched_blocked_until;
+    champsim::slot_queue<ROB_SIZE> issue_queue, completion_queue;
+
     // branch
     int branch_mispredict_stall_fetch;  // flag that says that we should stall
                                         // because a branch prediction was wrong
@@ -165,13 +206,19 @@ class O3_CPU {
     uint64_t total_rob_occupancy_at_branch_mispredict;
     uint64_t total_branch_types[8];
 
-    // TLBs and caches
-    CACHE ITLB{"ITLB",       ITLB_SET,     ITLB_WAY,     ITLB_SET *ITLB_WAY,
-               ITLB_WQ_SIZE, ITLB_RQ_SIZE, ITLB_PQ_SIZE, ITLB_MSHR_SIZE},
-        DTLB{"DTLB",       DTLB_SET,     DTLB_WAY,     DTLB_SET *DTLB_WAY,
-             DTLB_WQ_SIZE, DTLB_RQ_SIZE, DTLB_PQ_SIZE, DTLB_MSHR_SIZE},
-        STLB{"STLB",       STLB_SET,     STLB_WAY,     STLB_SET *STLB_WAY,
-             STLB_WQ_SIZE, STLB_RQ_SIZE, STLB_PQ_SIZE, STLB_MSHR_SIZE};
+    // Branch predictor loaded from the core configuration. When null, the
+    // branch predictor statically linked through CHAMPSIM_BRANCH_PREDICTOR is
+    // called directly.
+    cb::ibranchpredictor *branch_predictor;
+    std::function<cb::ibranchpredictor *()> branch_predictor_callable;
+
+    // Legacy TLBs, only built when the core configuration keeps the legacy
+    // translation model.
+    std::unique_ptr<CACHE> ITLB, DTLB, STLB;
+
+    // Lightweight translation model loaded from the core configuration. When
+    // set, it handles every translation in place of the legacy TLBs above.
+    std::unique_ptr<cc::tlb_hierarchy> tlb;
 
     cc::location_map _location_map;
     cc::metadata_cache _mm;
@@ -218,6 +265,7 @@ class O3_CPU {
 
     // functions
     bool should_read_instruction() const;
+    bool scheduling_blocked();
     void initialize_instruction(ooo_model_instr &instr);
     void read_from_trace(), fetch_instruction(), decode_and_dispatch(),
         schedule_instruction(), execute_instruction(),
@@ -226,9 +274,11 @@ class O3_CPU {
         do_execution(uint32_t rob_index),
         do_memory_scheduling(uint32_t rob_index), operate_lsq(),
         complete_execution(uint32_t rob_index),
+        mem_ops_completed(uint32_t rob_index),
         reg_RAW_dependency(uint32_t prior, uint32_t current,
                            uint32_t source_index),
-        reg_RAW_release(uint32_t rob_index),
+        reg_RAW_release(uint32_t rob_index), reg_rename(uint32_t rob_index),
+        reg_rename_release(uint32_t rob_index),
         mem_RAW_dependency(uint32_t prior, uint32_t current,
                            uint32_t data_index, uint32_t lq_index),
         handle_merged_translation(PACKET *provider),
@@ -267,9 +317,33 @@ class O3_CPU {
     uint8_t mem_reg_dependence_resolved(uint32_t rob_index);
 
     // branch predictor
-    uint8_t predict_branch(uint64_t ip);
-    void initialize_branch_predictor(),
-        last_branch_result(uint64_t ip, uint8_t taken);
+    void init_branch_predictor(const std::string &name);
+
+    uint8_t predict_branch(uint64_t ip) {
+        if (this->branch_predictor) [[unlikely]]
+            return this->branch_predictor->predict_branch(ip);
+
+        return this->builtin_predict_branch(ip);
+    }
+
+    void initialize_branch_predictor() {
+        if (this->branch_predictor) [[unlikely]]
+            this->branch_predictor->initialize();
+        else
+            this->builtin_initialize_branch_predictor();
+    }
+
+    void last_branch_result(uint64_t ip, uint8_t taken) {
+        if (this->branch_predictor) [[unlikely]]
+            this->branch_predictor->last_branch_result(ip, taken);
+        else
+            this->builtin_last_branch_result(ip, taken);
+    }
+
+    // statically linked branch predictor
+    uint8_t builtin_predict_branch(uint64_t ip);
+    void builtin_initialize_branch_predictor(),
+        builtin_last_branch_result(uint64_t ip, uint8_t taken);
 
     // code prefetching
     void l1i_prefetcher_initialize();
@@ -0,0 +1,97 @@
+#ifndef __CHAMPSIM_INTERNALS_PLUGIN_REGISTRY_HH__
+#define __CHAMPSIM_INTERNALS_PLUGIN_REGISTRY_HH__
+
+#include <functional>
+#include <string>
+#
+#include <boost/dll.hpp>
+#include <boost/dll/alias.hpp>
+#include <boost/preprocessor/cat.hpp>
+
+namespace champsim {
+/**
+ * @brief Table of the plugins linked statically into the simulator (see
+ * CHAMPSIM_STATIC_PREFETCHERS and CHAMPSIM_STATIC_REPLACEMENTS), keyed by
+ * plugin name. The table is generated by CMake from static_plugins.cc.in, with
+ * one entry per plugin linked in, and holds the functions the plugins export
+ * through CHAMPSIM_PLUGIN_ALIAS. Referencing it from import_plugin is what
+ * pulls these functions into the simulator.
+ *
+ * @tparam PluginT The interface implemented by the plugins.
+ */
+template <typename PluginT>
+class plugin_registry {
+   public:
+    using factory = std::function<PluginT*()>;
+
+    struct entry {
+        const char* name;
+        PluginT* (*create)();
+    };
+
+   public:
+    /**
+     * @brief Gets the generated table, ended by an entry without name.
+     */
+    static const entry* table();
+
+    /**
+     * @brief Looks up a statically linked plugin.
+     * @param name The name of the plugin.
+     * @return The function creating instances of the plugin, or an empty
+     * function if that plugin is not statically linked.
+     */
+    static factory find(const std::string& name) {
+        for (const entry* e = plugin_registry::table(); e->name != nullptr;
+             e++) {
+            if (name == e->name) return e->create;
+        }
+
+        return factory();
+    }
+};
+
+/**
+ * @brief Gets the function creating instances of a plugin. Statically linked
+ * plugins are preferred and the others are loaded from their shared objects.
+ *
+ * @tparam PluginT The interface implemented by the plugin.
+ * @param directory The directory in which the shared object of the plugin
+ * lives.
+ * @param name The name of the plugin.
+ * @param alias The symbol exported by the shared object of the plugin.
+ */
+template <typename PluginT>
+std::function<PluginT*()> import_plugin(const std::string& directory,
+                                        const std::string& name,
+                                        const std::string& alias) {
+    std::function<PluginT*()> f = plugin_registry<PluginT>::find(name);
+
+    if (f) return f;
+
+    return boost::dll::import_alias<PluginT*()>(
+        directory + name, alias, boost::dll::load_mode::append_decorations);
+}
+}  // namespace champsim
+
+/**
+ * @brief Exports the function creating instances of a plugin. Sources of
+ * statically linked plugins are built with CHAMPSIM_STATIC_PLUGIN set to the
+ * name of the plugin and define champsim_static_<alias>_<name>, listed in the
+ * generated table of static plugins; otherwise the function is exported from
+ * the shared object under the given alias. Either way, the header invoking
+ * this macro must be included by a single source file of the plugin.
+ */
+#if defined(CHAMPSIM_STATIC_PLUGIN)
+#define CHAMPSIM_PLUGIN_ALIAS(PluginT, factory, alias) \
+    extern "C" PluginT* BOOST_PP_CAT(                  \
+        BOOST_PP_CAT(champsim_static_, alias),         \
+        BOOST_PP_CAT(_, CHAMPSIM_STATIC_PLUGIN))() {   \
+        return factory();                              \
+    }
+#else
+#define CHAMPSIM_PLUGIN_ALIAS(PluginT, factory, alias) \
+    BOOST_DLL_ALIAS(factory, alias)
+#endif
+
+#endif  // __CHAMPSIM_INTERNALS_PLUGIN_REGISTRY_HH__
@@ -1,12 +1,17 @@
 #ifndef __CHAMPSIM_INTERNALS_PREFETCHERS_IPREFETCHER_HH__
 #define __CHAMPSIM_INTERNALS_PREFETCHERS_IPREFETCHER_HH__
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <map>
 #include <string>
+#include <vector>
 #
 #include <exception>
 #
 #include <internals/components/cache.hh>
+#include <internals/plugin_registry.hh>
 #
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -83,6 +88,37 @@ class iprefetcher {
      */
     virtual void operate(const prefetch_request_descriptor& desc) {}
 
+    /**
+     * @brief Whether the cache hands the accesses of a cycle to operate_batch
+     * at once, instead of calling operate on each of them. It is set by the
+     * "batched" key of the configuration file.
+     */
+    bool batched() const { return this->_batched; }
+
+    /**
+     * @brief This method performs the operation of the prefetcher on all the
+     * accesses of a cycle. Prefetchers overloading it append their requests to
+     * the candidates, that the cache issues in one pass afterwards. By
+     * default, operate is called on each access.
+     * @param descs The accesses of the cycle, in order.
+     * @param count The number of accesses.
+     * @param candidates A buffer, reused across cycles, receiving the prefetch
+     * requests.
+     */
+    virtual void operate_batch(
+        const prefetch_request_descriptor* descs, std::size_t count,
+        std::vector<cc::cache::prefetch_descriptor>& /*candidates*/) {
+        for (std::size_t i = 0; i < count; i++) this->operate(descs[i]);
+    }
+
+    /**
+     * @brief Scales the aggressiveness of the prefetcher, as decided by the
+     * throttling of its cache. A scale of 1 stands for the configured degree
+     * or distance. Prefetchers without such a knob ignore it.
+     * @param scale The factor to apply to the configured aggressiveness.
+     */
+    virtual void throttle(const float& /*scale*/) {}
+
     /**
      * @brief This method performs updates on the prefetcher on the event of a
      * fill in the cache.
@@ -104,12 +140,14 @@ class iprefetcher {
     iprefetcher(const iprefetcher& o)
         : _cache_inst(o._cache_inst),
           _cache_type(o._cache_type),
-          _name(o._name) {}
+          _name(o._name),
+          _batched(o._batched) {}
 
     iprefetcher& operator=(const iprefetcher& o) {
         this->_cache_inst = o._cache_inst;
         this->_cache_type = o._cache_type;
         this->_name = o._name;
+        this->_batched = o._batched;
 
         return *this;
     }
@@ -143,6 +181,15 @@ class iprefetcher {
         }
 
         this->_cache_inst = cache_inst;
+
+        this->_batched = props.get<bool>("batched", false);
+    }
+
+    /**
+     * @brief Scales a configured degree or distance, without going below one.
+     */
+    static uint64_t _scaled(const uint64_t& value, const float& scale) {
+        return std::max<uint64_t>(1, std::lround(value * scale));
     }
 
    private:
@@ -157,8 +204,23 @@ class iprefetcher {
     cc::cache_type _cache_type;
 
     std::string _name;
+
+    bool _batched = false;
 };
 }  // namespace prefetchers
+
+// Defined in the generated table of static plugins.
+template <>
+const plugin_registry<prefetchers::iprefetcher>::entry*
+plugin_registry<prefetchers::iprefetcher>::table();
 }  // namespace champsim
 
+/**
+ * @brief Exports the function creating instances of a prefetcher plugin,
+ * either from its shared object or to the table of static plugins.
+ */
+#define CHAMPSIM_PREFETCHER_ALIAS(factory)                                \
+    CHAMPSIM_PLUGIN_ALIAS(::champsim::prefetchers::iprefetcher, factory, \
+                          create_prefetcher)
+
 #endif  // __CHAMPSIM_INTERNALS_PREFETCHERS_IPREFETCHER_HH__
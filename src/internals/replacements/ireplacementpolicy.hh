@@ -8,6 +8,8 @@
 #
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
+#
+#include <internals/plugin_registry.hh>
 
 static std::map<std::string, cc::cache_type> replacement_type_map = {
 	{ "itlb", cc::is_itlb },
@@ -91,6 +93,18 @@ namespace champsim {
 			std::string _name;
 		};
 	}
+
+	// Defined in the generated table of static plugins.
+	template <>
+	const plugin_registry<replacements::ireplacementpolicy>::entry*
+	plugin_registry<replacements::ireplacementpolicy>::table ();
 }
 
+/**
+ * @brief Exports the function creating instances of a replacement policy
+ * plugin, either from its shared object or to the table of static plugins.
+ */
+#define CHAMPSIM_REPLACEMENTPOLICY_ALIAS(factory) \
+	CHAMPSIM_PLUGIN_ALIAS(::champsim::replacements::ireplacementpolicy, factory, create_replacementpolicy)
+
 #endif // __CHAMPSIM_INTERNALS_REPLACEMENTS_IREPLACEMENTPOLICY_HH__
@@ -3,6 +3,7 @@
 #
 #include <boost/property_tree/json_parser.hpp>
 #
+#include <internals/host_profiler.hh>
 #include <internals/simulator.hh>
 
 using namespace champsim;
@@ -14,7 +15,10 @@ simulator* simulator::_inst = nullptr;
  * @brief Constructor of the Simulator class.
  */
 simulator::simulator()
-    : _curr_state(simulator::instanciated), _desc("ChampSim") {
+    : _curr_state(simulator::instanciated),
+      _desc("ChampSim"),
+      _host_stats(false),
+      _host_profile(false) {
     // Preparing the option parsing utilities.
     this->_init_options_descriptor();
 }
@@ -61,6 +65,10 @@ void simulator::parse_args(int argc, char** argv) {
         throw std::runtime_error("No simulation instructions specified.");
     }
 
+    if (this->_host_profile || this->_host_stats) {
+        host_profiler::enable(this->_host_profile);
+    }
+
     // Checking traces.
     if (!vm.count("traces")) {
         throw std::runtime_error("No traces specified.");
@@ -123,6 +131,7 @@ O3_CPU* champsim::simulator::modeled_cpu(const std::size_t& idx) const {
 void champsim::simulator::start_warmup() {
     // Marking the time of the beginning of the simulation.
     this->_begin_time = std::chrono::system_clock::now();
+    host_profiler::start();
 
     // Changing the state of the simulator.
     this->_curr_state = warmup;
@@ -218,7 +227,12 @@ void simulator::_init_options_descriptor() {
         po::value<uint32_t>(&this->_sim_desc.warmup_instructions),
         "")("simulation_instructions",
             po::value<uint32_t>(&this->_sim_desc.simulation_instructions), "")(
-        "traces", po::value<std::vector<std::string>>(&this->_traces), "");
+        "traces", po::value<std::vector<std::string>>(&this->_traces), "")(
+        "host_stats", po::bool_switch(&this->_host_stats),
+        "Report the throughput and the peak memory usage of the simulator.")(
+        "host_profile", po::bool_switch(&this->_host_profile),
+        "Also report the host time spent simulating each component (slows "
+        "down the simulation).");
 }
 
 /**
@@ -258,6 +272,44 @@ void simulator::_initialize(const computer_descriptor& desc) {
     this->_memory_trace_dir =
         this->_config.get<std::string>("dram.memory_trace_directory");
 
+    // DRAM organization, timing and bus rate, defaulting to the built-in
+    // configuration.
+    dram_descriptor& dram = this->_sim_desc.dram;
+
+    dram.io_frequency =
+        this->_config.get<uint32_t>("dram.io_frequency", dram.io_frequency);
+    dram.channels = this->_config.get<uint32_t>("dram.channels", dram.channels);
+    dram.ranks = this->_config.get<uint32_t>("dram.ranks", dram.ranks);
+    dram.banks = this->_config.get<uint32_t>("dram.banks", dram.banks);
+    dram.rows = this->_config.get<uint32_t>("dram.rows", dram.rows);
+    dram.columns = this->_config.get<uint32_t>("dram.columns", dram.columns);
+    dram.rq_size = this->_config.get<uint32_t>("dram.rq_size", dram.rq_size);
+    dram.wq_size = this->_config.get<uint32_t>("dram.wq_size", dram.wq_size);
+    dram.tRP = this->_config.get<double>("dram.tRP", dram.tRP);
+    dram.tRCD = this->_config.get<double>("dram.tRCD", dram.tRCD);
+    dram.tCAS = this->_config.get<double>("dram.tCAS", dram.tCAS);
+    dram.dbus_turn_around = this->_config.get<double>("dram.dbus_turn_around",
+                                                      dram.dbus_turn_around);
+    dram.write_high_watermark = this->_config.get<double>(
+        "dram.write_high_watermark", dram.write_high_watermark);
+    dram.write_low_watermark = this->_config.get<double>(
+        "dram.write_low_watermark", dram.write_low_watermark);
+    dram.memory_trace_compression = this->_config.get<bool>(
+        "dram.memory_trace_compression", dram.memory_trace_compression);
+    dram.detailed_timing =
+        this->_config.get<bool>("dram.detailed_timing", dram.detailed_timing);
+    dram.bank_groups =
+        this->_config.get<uint32_t>("dram.bank_groups", dram.bank_groups);
+    dram.subchannels =
+        this->_config.get<uint32_t>("dram.subchannels", dram.subchannels);
+    dram.tRRD_S = this->_config.get<double>("dram.tRRD_S", dram.tRRD_S);
+    dram.tRRD_L = this->_config.get<double>("dram.tRRD_L", dram.tRRD_L);
+    dram.tFAW = this->_config.get<double>("dram.tFAW", dram.tFAW);
+    dram.tCCD_S = this->_config.get<double>("dram.tCCD_S", dram.tCCD_S);
+    dram.tCCD_L = this->_config.get<double>("dram.tCCD_L", dram.tCCD_L);
+    dram.tRFC = this->_config.get<double>("dram.tRFC", dram.tRFC);
+    dram.tREFI = this->_config.get<double>("dram.tREFI", dram.tREFI);
+
     // Iterating over the core configurations provided.
     pt::ptree cores_subtree = this->_config.get_child("cores");
 
@@ -275,6 +327,9 @@ void simulator::_initialize(const computer_descriptor& desc) {
             it->second.get<std::string>("sdc.config");
         this->_sim_desc.cpus[i].sdc_enabled =
             it->second.get<bool>("sdc.enabled", false);
+        this->_sim_desc.cpus[i].branch_predictor =
+            it->second.get<std::string>("branch_predictor",
+                                        CHAMPSIM_BRANCH_PREDICTOR);
         this->_sim_desc.cpus[i].stride_threshold =
             it->second.get<uint64_t>("irregular_predictor.stride_threshold");
         this->_sim_desc.cpus[i].irreg_pred_sets =
@@ -298,6 +353,65 @@ void simulator::_initialize(const computer_descriptor& desc) {
         this->_sim_desc.cpus[i].pld_threshold_2 =
             it->second.get<uint64_t>("popular_level_detector.threshold_2");
 
+        // Binding the branch predictor of this core.
+        curr_cpu->init_branch_predictor(
+            this->_sim_desc.cpus[i].branch_predictor);
+
+        // Building the translation model of this core. The legacy TLBs are
+        // only built when the lightweight model is not requested.
+        this->_sim_desc.cpus[i].tlb_model =
+            it->second.get<std::string>("tlb.model", "legacy");
+
+        if (this->_sim_desc.cpus[i].tlb_model == "lightweight") {
+            cc::tlb_hierarchy::descriptor tlb;
+            uint64_t page_size =
+                it->second.get<uint64_t>("tlb.page_size", PAGE_SIZE);
+
+            if (page_size != PAGE_SIZE && page_size != (1ULL << 21))
+                throw std::runtime_error(
+                    "TLB page sizes can only be 4096 or 2097152 bytes.");
+
+            tlb.log2_page_size = lg2(page_size);
+
+            for (auto level : {std::make_pair("itlb", &tlb.itlb),
+                               std::make_pair("dtlb", &tlb.dtlb),
+                               std::make_pair("stlb", &tlb.stlb)}) {
+                std::string prefix = std::string("tlb.") + level.first;
+
+                level.second->sets = it->second.get<uint32_t>(
+                    prefix + ".sets", level.second->sets);
+                level.second->ways = it->second.get<uint32_t>(
+                    prefix + ".ways", level.second->ways);
+                level.second->latency = it->second.get<uint32_t>(
+                    prefix + ".latency", level.second->latency);
+                level.second->queue_size = it->second.get<uint32_t>(
+                    prefix + ".queue_size", level.second->queue_size);
+            }
+
+            tlb.pwc_entries =
+                it->second.get<uint32_t>("tlb.pwc_entries", tlb.pwc_entries);
+            tlb.walkers = it->second.get<uint32_t>("tlb.walkers", tlb.walkers);
+            tlb.walk_queue_size = it->second.get<uint32_t>(
+                "tlb.walk_queue_size", tlb.walk_queue_size);
+            tlb.walk_level_latency = it->second.get<uint32_t>(
+                "tlb.walk_level_latency", tlb.walk_level_latency);
+
+            curr_cpu->tlb = std::make_unique<cc::tlb_hierarchy>(tlb, i);
+        } else if (this->_sim_desc.cpus[i].tlb_model == "legacy") {
+            curr_cpu->ITLB = std::make_unique<CACHE>(
+                "ITLB", ITLB_SET, ITLB_WAY, ITLB_SET * ITLB_WAY, ITLB_WQ_SIZE,
+                ITLB_RQ_SIZE, ITLB_PQ_SIZE, ITLB_MSHR_SIZE);
+            curr_cpu->DTLB = std::make_unique<CACHE>(
+                "DTLB", DTLB_SET, DTLB_WAY, DTLB_SET * DTLB_WAY, DTLB_WQ_SIZE,
+                DTLB_RQ_SIZE, DTLB_PQ_SIZE, DTLB_MSHR_SIZE);
+            curr_cpu->STLB = std::make_unique<CACHE>(
+                "STLB", STLB_SET, STLB_WAY, STLB_SET * STLB_WAY, STLB_WQ_SIZE,
+                STLB_RQ_SIZE, STLB_PQ_SIZE, STLB_MSHR_SIZE);
+        } else {
+            throw std::runtime_error("Unknown TLB model " +
+                                     this->_sim_desc.cpus[i].tlb_model + ".");
+        }
+
         // Updating the metadata cache of this core.
         curr_cpu->_mm = std::move(cc::metadata_cache(
             this->_sim_desc.cpus[i].metadata_cache_sets,
@@ -12,6 +12,7 @@
 #
 #include <boost/property_tree/ptree.hpp>
 #
+#include <internals/dram_controller.h>
 #include <internals/ooo_cpu.h>
 
 #include <internals/instruction_reader.hh>
@@ -31,6 +32,8 @@ struct computer_descriptor {
 
     std::string llc_config_file;
 
+    dram_descriptor dram;
+
     bool legacy_traces;
 
     uint32_t warmup_instructions, simulation_instructions;
@@ -66,6 +69,7 @@ class simulator {
     // Here is the whole simulation description.
     computer_descriptor _sim_desc;
     std::vector<std::string> _traces;
+    bool _host_stats, _host_profile;
 
     // Here are all the utilities needed to describe the modeled CPUs and theirs
     // inputs.
@@ -0,0 +1,76 @@
+#ifndef __CHAMPSIM_INTERNALS_SLOT_QUEUE_HH__
+#define __CHAMPSIM_INTERNALS_SLOT_QUEUE_HH__
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace champsim {
+/**
+ * @brief A queue of slots of a circular buffer, such as the ROB, kept as a
+ * bitmap indexed by slot. Walking it from the head of the buffer yields its
+ * members oldest first, whatever the order they were queued in, and only
+ * costs a word per 64 slots on top of the members visited.
+ */
+template <std::size_t N>
+class slot_queue {
+   private:
+    std::array<uint64_t, (N + 63) / 64> _words{};
+    std::size_t _size = 0;
+
+    // first member at or after slot, N if there is none
+    std::size_t _next(std::size_t slot) const {
+        std::size_t word = slot >> 6;
+
+        if (word >= this->_words.size()) return N;
+
+        uint64_t bits = this->_words[word] & (~0ULL << (slot & 63));
+
+        while (bits == 0) {
+            if (++word == this->_words.size()) return N;
+
+            bits = this->_words[word];
+        }
+
+        return (word << 6) + std::countr_zero(bits);
+    }
+
+   public:
+    bool empty() const { return this->_size == 0; }
+    std::size_t size() const { return this->_size; }
+
+    bool contains(std::size_t slot) const {
+        return (this->_words[slot >> 6] >> (slot & 63)) & 1ULL;
+    }
+
+    void insert(std::size_t slot) {
+        if (this->contains(slot)) return;
+
+        this->_words[slot >> 6] |= 1ULL << (slot & 63);
+        this->_size++;
+    }
+
+    void erase(std::size_t slot) {
+        if (!this->contains(slot)) return;
+
+        this->_words[slot >> 6] &= ~(1ULL << (slot & 63));
+        this->_size--;
+    }
+
+    /**
+     * @brief Calls f on the members, from the one at head and wrapping around,
+     * until f returns false. f may erase the member it is given.
+     */
+    template <typename F>
+    void walk(std::size_t head, F f) {
+        for (std::size_t i = this->_next(head); i < N; i = this->_next(i + 1))
+            if (!f(i)) return;
+
+        for (std::size_t i = this->_next(0); i < head; i = this->_next(i + 1))
+            if (!f(i)) return;
+    }
+};
+}  // namespace champsim
+
+#endif  // __CHAMPSIM_INTERNALS_SLOT_QUEUE_HH__
@@ -0,0 +1,137 @@
+#ifndef __CHAMPSIM_INTERNALS_TABLE_ARENA_HH__
+#define __CHAMPSIM_INTERNALS_TABLE_ARENA_HH__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace champsim {
+/**
+ * @brief A single cache-aligned allocation holding all the tables of a
+ * component whose geometry is only known at run time.
+ *
+ * Tables are carved out of the arena twice with the same sequence of calls:
+ * once before allocate() to size it, carve() then returns null pointers, and
+ * once after allocate() to bind them. Copying an arena copies its bytes in one
+ * go, the owner only has to rewind() it and bind its tables again.
+ */
+class table_arena {
+   public:
+    static constexpr std::size_t alignment = 64;
+
+   private:
+    struct deleter {
+        void operator()(unsigned char* p) const { std::free(p); }
+    };
+
+    std::unique_ptr<unsigned char, deleter> _data;
+    std::size_t _size, _used;
+
+    void _copy(const table_arena& o) {
+        this->_data.reset();
+        this->_size = o._size;
+        this->_used = 0;
+
+        if (o._data) {
+            this->allocate();
+            std::memcpy(this->_data.get(), o._data.get(), this->_size);
+        }
+    }
+
+   public:
+    table_arena() : _size(0), _used(0) {}
+
+    table_arena(const table_arena& o) { this->_copy(o); }
+
+    table_arena& operator=(const table_arena& o) {
+        if (this != &o) this->_copy(o);
+
+        return *this;
+    }
+
+    /**
+     * @brief Reserves room for count elements of type T, aligned on a cache
+     * line, and returns them once the arena is allocated. The arena is
+     * zero-filled and copied byte by byte, so T must be trivially copyable.
+     */
+    template <typename T>
+    T* carve(std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Tables carved out of an arena are copied with memcpy.");
+
+        std::size_t offset = (this->_used + alignment - 1) & ~(alignment - 1);
+
+        this->_used = offset + count * sizeof(T);
+
+        if (!this->_data) {
+            this->_size = this->_used;
+            return nullptr;
+        }
+
+        return reinterpret_cast<T*>(this->_data.get() + offset);
+    }
+
+    /**
+     * @brief Allocates the zero-filled storage sized by the previous carve()
+     * calls and rewinds the arena.
+     */
+    void allocate() {
+        std::size_t size =
+            std::max<std::size_t>((this->_size + alignment - 1) &
+                                      ~(alignment - 1),
+                                  alignment);
+        unsigned char* p =
+            static_cast<unsigned char*>(std::aligned_alloc(alignment, size));
+
+        if (p == nullptr) throw std::bad_alloc();
+
+        std::memset(p, 0, size);
+
+        this->_data.reset(p);
+        this->_used = 0;
+    }
+
+    /**
+     * @brief Drops the storage so that the arena can be sized again.
+     */
+    void clear() {
+        this->_data.reset();
+        this->_size = 0;
+        this->_used = 0;
+    }
+
+    void rewind() { this->_used = 0; }
+
+    std::size_t size() const { return this->_size; }
+};
+
+/**
+ * @brief A row-major two-dimensional view over arena storage, so that tables
+ * keep their table[set][way] indexing.
+ */
+template <typename T>
+class table_view {
+   private:
+    T* _data;
+    std::size_t _cols;
+
+   public:
+    table_view() : _data(nullptr), _cols(0) {}
+    table_view(T* data, std::size_t cols) : _data(data), _cols(cols) {}
+
+    T* operator[](std::size_t row) const {
+        return this->_data + row * this->_cols;
+    }
+
+    static table_view carve(table_arena& arena, std::size_t rows,
+                            std::size_t cols) {
+        return table_view(arena.carve<T>(rows * cols), cols);
+    }
+};
+}  // namespace champsim
+
+#endif  // __CHAMPSIM_INTERNALS_TABLE_ARENA_HH__
@@ -0,0 +1,66 @@
+#include <plugins/branch_predictors/bimodal/bimodal.hh>
+#
+#include <algorithm>
+
+namespace cb = champsim::branch_predictors;
+
+/**
+ * Constructor of the class.
+ */
+cb::bimodal_predictor::bimodal_predictor() {}
+
+cb::bimodal_predictor::bimodal_predictor(const cb::bimodal_predictor& o)
+    : ibranchpredictor(o),
+      _prime(o._prime),
+      _max_counter(o._max_counter),
+      _table(o._table) {}
+
+/**
+ * Destructor of the class.
+ */
+cb::bimodal_predictor::~bimodal_predictor() {}
+
+void cb::bimodal_predictor::initialize() {
+    std::fill(this->_table.begin(), this->_table.end(), 0);
+}
+
+uint8_t cb::bimodal_predictor::predict_branch(uint64_t ip) {
+    uint32_t hash = ip % this->_prime;
+
+    return (this->_table[hash] >= ((this->_max_counter + 1) / 2)) ? 1 : 0;
+}
+
+void cb::bimodal_predictor::last_branch_result(uint64_t ip, uint8_t taken) {
+    uint32_t hash = ip % this->_prime;
+
+    if (taken && (this->_table[hash] < this->_max_counter))
+        this->_table[hash]++;
+    else if ((taken == 0) && (this->_table[hash] > 0))
+        this->_table[hash]--;
+}
+
+cb::bimodal_predictor* cb::bimodal_predictor::clone() {
+    return new bimodal_predictor(*this);
+}
+
+/**
+ * This method is used to create an instance of the branch predictor and
+ * provide it to the performance model.
+ */
+cb::ibranchpredictor* cb::bimodal_predictor::create_branchpredictor() {
+    return new cb::bimodal_predictor();
+}
+
+void cb::bimodal_predictor::_init(const pt::ptree& props, O3_CPU* cpu_inst) {
+    // Calling the version of the parent class first.
+    cb::ibranchpredictor::_init(props, cpu_inst);
+
+    this->_prime = props.get<uint32_t>("prime");
+    this->_max_counter = props.get<uint32_t>("max_counter");
+
+    // Now that have got the knobs from the configuration file, let's create the
+    // data structures.
+    this->_table = std::vector<uint32_t>(props.get<std::size_t>("table_size"));
+
+    this->initialize();
+}
@@ -0,0 +1,81 @@
+#include <plugins/branch_predictors/gshare/gshare.hh>
+#
+#include <algorithm>
+
+namespace cb = champsim::branch_predictors;
+
+/**
+ * Constructor of the class.
+ */
+cb::gshare_predictor::gshare_predictor() {}
+
+cb::gshare_predictor::gshare_predictor(const cb::gshare_predictor& o)
+    : ibranchpredictor(o),
+      _history_length(o._history_length),
+      _history_mask(o._history_mask),
+      _history_vector(o._history_vector),
+      _table(o._table) {}
+
+/**
+ * Destructor of the class.
+ */
+cb::gshare_predictor::~gshare_predictor() {}
+
+void cb::gshare_predictor::initialize() {
+    this->_history_vector = 0;
+
+    // 2 is slightly taken.
+    std::fill(this->_table.begin(), this->_table.end(), 2);
+}
+
+uint8_t cb::gshare_predictor::predict_branch(uint64_t ip) {
+    return (this->_table[this->_table_hash(ip)] >= 2) ? 1 : 0;
+}
+
+void cb::gshare_predictor::last_branch_result(uint64_t ip, uint8_t taken) {
+    uint32_t& counter = this->_table[this->_table_hash(ip)];
+
+    if (taken == 1) {
+        if (counter < 3) counter++;
+    } else {
+        if (counter > 0) counter--;
+    }
+
+    // Updating the branch history vector.
+    this->_history_vector <<= 1;
+    this->_history_vector &= this->_history_mask;
+    this->_history_vector |= taken;
+}
+
+cb::gshare_predictor* cb::gshare_predictor::clone() {
+    return new gshare_predictor(*this);
+}
+
+/**
+ * This method is used to create an instance of the branch predictor and
+ * provide it to the performance model.
+ */
+cb::ibranchpredictor* cb::gshare_predictor::create_branchpredictor() {
+    return new cb::gshare_predictor();
+}
+
+void cb::gshare_predictor::_init(const pt::ptree& props, O3_CPU* cpu_inst) {
+    // Calling the version of the parent class first.
+    cb::ibranchpredictor::_init(props, cpu_inst);
+
+    this->_history_length = props.get<uint32_t>("history_length");
+    this->_history_mask = (1U << this->_history_length) - 1;
+
+    // Now that have got the knobs from the configuration file, let's create the
+    // data structures.
+    this->_table = std::vector<uint32_t>(props.get<std::size_t>("table_size"));
+
+    this->initialize();
+}
+
+uint32_t cb::gshare_predictor::_table_hash(const uint64_t& ip) const {
+    uint32_t hash = ip ^ (ip >> this->_history_length) ^
+                    (ip >> (this->_history_length * 2)) ^ this->_history_vector;
+
+    return hash % this->_table.size();
+}
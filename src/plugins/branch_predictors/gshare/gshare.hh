@@ -0,0 +1,52 @@
+#include <internals/branch_predictors/ibranchpredictor.hh>
+#
+#include <vector>
+#
+#include <boost/property_tree/ptree.hpp>
+#
+#include <boost/dll.hpp>
+#include <boost/dll/alias.hpp>
+
+namespace dll = boost::dll;
+namespace pt = boost::property_tree;
+
+namespace champsim {
+namespace branch_predictors {
+/**
+ * @brief An implementation of a gshare branch predictor: a table of
+ * saturating counters indexed by the instruction pointer hashed with the
+ * global branch history.
+ */
+class gshare_predictor : public ibranchpredictor {
+   public:
+    virtual ~gshare_predictor();
+
+    virtual void initialize() final;
+    virtual uint8_t predict_branch(uint64_t ip) final;
+    virtual void last_branch_result(uint64_t ip, uint8_t taken) final;
+
+    virtual gshare_predictor* clone() final;
+
+    static ibranchpredictor* create_branchpredictor();
+
+   protected:
+    gshare_predictor();
+
+   private:
+    gshare_predictor(const gshare_predictor& o);
+
+    virtual void _init(const pt::ptree& props, O3_CPU* cpu_inst) final;
+
+    uint32_t _table_hash(const uint64_t& ip) const;
+
+   private:
+    uint32_t _history_length, _history_mask, _history_vector;
+    std::vector<uint32_t> _table;
+};
+}  // namespace branch_predictors
+}  // namespace champsim
+
+// Exporting the symbol used for module loading.
+BOOST_DLL_ALIAS(
+    champsim::branch_predictors::gshare_predictor::create_branchpredictor,
+    create_branchpredictor)
@@ -0,0 +1,145 @@
+#include <plugins/branch_predictors/hashed_perceptron/hashed_perceptron.hh>
+#
+#include <algorithm>
+
+namespace cb = champsim::branch_predictors;
+
+/**
+ * Constructor of the class.
+ */
+cb::hashed_perceptron_predictor::hashed_perceptron_predictor() {}
+
+cb::hashed_perceptron_predictor::hashed_perceptron_predictor(
+    const cb::hashed_perceptron_predictor& o)
+    : ibranchpredictor(o),
+      _log_table_size(o._log_table_size),
+      _table_size(o._table_size),
+      _speed(o._speed),
+      _initial_theta(o._initial_theta),
+      _tables(o._tables),
+      _ghist_words(o._ghist_words),
+      _indices(o._indices),
+      _theta(o._theta),
+      _tc(o._tc),
+      _yout(o._yout) {}
+
+/**
+ * Destructor of the class.
+ */
+cb::hashed_perceptron_predictor::~hashed_perceptron_predictor() {}
+
+void cb::hashed_perceptron_predictor::initialize() {
+    std::fill(this->_tables.begin(), this->_tables.end(), 0);
+    std::fill(this->_ghist_words.begin(), this->_ghist_words.end(), 0);
+
+    this->_indices.fill(0);
+    this->_theta = this->_initial_theta;
+    this->_tc = 0;
+    this->_yout = 0;
+}
+
+uint8_t cb::hashed_perceptron_predictor::predict_branch(uint64_t ip) {
+    this->_yout = 0;
+
+    for (std::size_t i = 0; i < num_tables; i++) {
+        // Hashing global history bits 0..n-1 into x by XORing the words of
+        // the global history, the last word being shorter than the others.
+        uint32_t n = history_lengths[i], most_words = n / this->_log_table_size,
+                 last_word = n % this->_log_table_size, x = 0, j;
+
+        for (j = 0; j < most_words; j++) x ^= this->_ghist_words[j];
+
+        x ^= this->_ghist_words[j] & ((1U << last_word) - 1);
+
+        // XORing in the PC to spread accesses around (like gshare) and staying
+        // within the table size.
+        x ^= ip;
+        x &= this->_table_size - 1;
+
+        // Remembering this index for update and adding the selected weight
+        // to the perceptron sum.
+        this->_indices[i] = x;
+        this->_yout += this->_tables[i * this->_table_size + x];
+    }
+
+    return this->_yout >= 1;
+}
+
+void cb::hashed_perceptron_predictor::last_branch_result(uint64_t /*ip*/,
+                                                         uint8_t taken) {
+    bool correct = taken == (this->_yout >= 1), b = taken;
+    int32_t a = (this->_yout < 0) ? -this->_yout : this->_yout;
+
+    // Inserting this branch outcome into the global history.
+    for (uint32_t& word : this->_ghist_words) {
+        word <<= 1;
+        word |= b;
+
+        b = !!(word & this->_table_size);
+        word &= this->_table_size - 1;
+    }
+
+    // Perceptron learning rule: train on a misprediction or a weak correct
+    // prediction.
+    if (correct && a >= this->_theta) return;
+
+    for (std::size_t i = 0; i < num_tables; i++) {
+        int32_t& c = this->_tables[i * this->_table_size + this->_indices[i]];
+
+        // Incrementing if taken, decrementing if not, saturating at 127/-128.
+        if (taken) {
+            if (c < 127) c++;
+        } else {
+            if (c > -128) c--;
+        }
+    }
+
+    // Dynamic threshold setting from Seznec's O-GEHL paper.
+    if (!correct) {
+        this->_tc++;
+
+        if (this->_tc >= static_cast<int32_t>(this->_speed)) {
+            this->_theta++;
+            this->_tc = 0;
+        }
+    } else {
+        this->_tc--;
+
+        if (this->_tc <= -static_cast<int32_t>(this->_speed)) {
+            this->_theta--;
+            this->_tc = 0;
+        }
+    }
+}
+
+cb::hashed_perceptron_predictor* cb::hashed_perceptron_predictor::clone() {
+    return new hashed_perceptron_predictor(*this);
+}
+
+/**
+ * This method is used to create an instance of the branch predictor and
+ * provide it to the performance model.
+ */
+cb::ibranchpredictor*
+cb::hashed_perceptron_predictor::create_branchpredictor() {
+    return new cb::hashed_perceptron_predictor();
+}
+
+void cb::hashed_perceptron_predictor::_init(const pt::ptree& props,
+                                            O3_CPU* cpu_inst) {
+    // Calling the version of the parent class first.
+    cb::ibranchpredictor::_init(props, cpu_inst);
+
+    this->_log_table_size = props.get<uint32_t>("log_table_size");
+    this->_table_size = 1U << this->_log_table_size;
+    this->_speed = props.get<uint32_t>("speed");
+    this->_initial_theta = props.get<uint32_t>("theta");
+
+    // Now that have got the knobs from the configuration file, let's create the
+    // data structures.
+    this->_tables = std::vector<int32_t>(num_tables * this->_table_size);
+    this->_ghist_words = std::vector<uint32_t>(
+        history_lengths.back() / this->_log_table_size + 1);
+
+    this->initialize();
+}
@@ -0,0 +1,71 @@
+#include <internals/branch_predictors/ibranchpredictor.hh>
+#
+#include <array>
+#include <vector>
+#
+#include <boost/property_tree/ptree.hpp>
+#
+#include <boost/dll.hpp>
+#include <boost/dll/alias.hpp>
+
+namespace dll = boost::dll;
+namespace pt = boost::property_tree;
+
+namespace champsim {
+namespace branch_predictors {
+/**
+ * @brief An implementation of the hashed perceptron branch predictor using
+ * geometric history lengths and dynamic threshold setting, written by Daniel
+ * A. Jimenez.
+ */
+class hashed_perceptron_predictor : public ibranchpredictor {
+   public:
+    // This many tables.
+    static constexpr std::size_t num_tables = 16;
+
+    // Geometric global history lengths, the first table being the biases.
+    static constexpr std::array<uint32_t, num_tables> history_lengths = {
+        0, 3, 4, 6, 8, 10, 14, 19, 26, 36, 49, 67, 91, 125, 170, 232};
+
+   public:
+    virtual ~hashed_perceptron_predictor();
+
+    virtual void initialize() final;
+    virtual uint8_t predict_branch(uint64_t ip) final;
+    virtual void last_branch_result(uint64_t ip, uint8_t taken) final;
+
+    virtual hashed_perceptron_predictor* clone() final;
+
+    static ibranchpredictor* create_branchpredictor();
+
+   protected:
+    hashed_perceptron_predictor();
+
+   private:
+    hashed_perceptron_predictor(const hashed_perceptron_predictor& o);
+
+    virtual void _init(const pt::ptree& props, O3_CPU* cpu_inst) final;
+
+   private:
+    uint32_t _log_table_size, _table_size, _speed, _initial_theta;
+
+    // Tables of 8-bit weights, table_size weights per table.
+    std::vector<int32_t> _tables;
+
+    // Words that store the global history, log_table_size bits per word.
+    std::vector<uint32_t> _ghist_words;
+
+    // Remembers the indices into the tables from prediction to update.
+    std::array<uint32_t, num_tables> _indices;
+
+    // Threshold, counter for the threshold setting algorithm and perceptron
+    // sum.
+    int32_t _theta, _tc, _yout;
+};
+}  // namespace branch_predictors
+}  // namespace champsim
+
+// Exporting the symbol used for module loading.
+BOOST_DLL_ALIAS(champsim::branch_predictors::hashed_perceptron_predictor::
+                    create_branchpredictor,
+                create_branchpredictor)
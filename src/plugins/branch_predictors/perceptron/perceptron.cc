@@ -0,0 +1,165 @@
+#include <plugins/branch_predictors/perceptron/perceptron.hh>
+#
+#include <algorithm>
+
+namespace cb = champsim::branch_predictors;
+
+/**
+ * Constructor of the class.
+ */
+cb::perceptron_predictor::perceptron_predictor() {}
+
+cb::perceptron_predictor::perceptron_predictor(
+    const cb::perceptron_predictor& o)
+    : ibranchpredictor(o),
+      _history_length(o._history_length),
+      _num_perceptrons(o._num_perceptrons),
+      _max_weight(o._max_weight),
+      _min_weight(o._min_weight),
+      _theta(o._theta),
+      _weights(o._weights),
+      _state_buf(o._state_buf),
+      _state_buf_ctr(o._state_buf_ctr),
+      _last_state(o._last_state),
+      _spec_global_history(o._spec_global_history),
+      _global_history(o._global_history) {}
+
+/**
+ * Destructor of the class.
+ */
+cb::perceptron_predictor::~perceptron_predictor() {}
+
+void cb::perceptron_predictor::initialize() {
+    this->_spec_global_history = 0;
+    this->_global_history = 0;
+    this->_state_buf_ctr = 0;
+    this->_last_state = 0;
+
+    std::fill(this->_weights.begin(), this->_weights.end(), 0);
+}
+
+uint8_t cb::perceptron_predictor::predict_branch(uint64_t ip) {
+    uint64_t mask;
+    int32_t output;
+    const int32_t* w;
+
+    // Getting the next "free" perceptron state, possibly letting the counter
+    // wrap around.
+    this->_last_state = this->_state_buf_ctr++;
+    if (this->_state_buf_ctr >= this->_state_buf.size())
+        this->_state_buf_ctr = 0;
+
+    perceptron_state& u = this->_state_buf[this->_last_state];
+
+    // Hashing the address to get an index into the table of perceptrons.
+    u.perc = ip % this->_num_perceptrons;
+    w = &this->_weights[u.perc * (this->_history_length + 1)];
+
+    // Initializing the output to the bias weight, then adding the weights of
+    // taken branches and subtracting the weights of not taken branches in
+    // the history register.
+    output = *w++;
+
+    mask = 1;
+    for (uint32_t i = 0; i < this->_history_length; i++, mask <<= 1, w++) {
+        if (this->_spec_global_history & mask)
+            output += *w;
+        else
+            output += -*w;
+    }
+
+    // Recording the values needed to update the predictor.
+    u.output = output;
+    u.history = this->_spec_global_history;
+    u.prediction = output >= 0;
+
+    // Updating the speculative global history register.
+    this->_spec_global_history <<= 1;
+    this->_spec_global_history |= u.prediction;
+
+    return u.prediction;
+}
+
+void cb::perceptron_predictor::last_branch_result(uint64_t /*ip*/,
+                                                  uint8_t taken) {
+    uint64_t mask;
+    int32_t* w;
+    const perceptron_state& u = this->_state_buf[this->_last_state];
+
+    // Updating the real global history shift register.
+    this->_global_history <<= 1;
+    this->_global_history |= taken;
+
+    // If this branch was mispredicted, the speculative history is restored to
+    // the last known real history.
+    if (u.prediction != taken)
+        this->_spec_global_history = this->_global_history;
+
+    // If the output of the perceptron is outside of [-theta, theta] and the
+    // prediction was correct, the weights don't need to be adjusted.
+    if (u.output > this->_theta && taken) return;
+    if (u.output < -this->_theta && !taken) return;
+
+    // Updating the bias weight first, with saturating arithmetic.
+    w = &this->_weights[u.perc * (this->_history_length + 1)];
+
+    if (taken)
+        (*w)++;
+    else
+        (*w)--;
+    if (*w > this->_max_weight) *w = this->_max_weight;
+    if (*w < this->_min_weight) *w = this->_min_weight;
+
+    w++;
+
+    // Then, for each weight, the one is incremented if the corresponding bit
+    // in the history positively correlates with the branch outcome, otherwise
+    // it is decremented.
+    mask = 1;
+    for (uint32_t i = 0; i < this->_history_length; i++, mask <<= 1, w++) {
+        if (!!(u.history & mask) == taken) {
+            (*w)++;
+            if (*w > this->_max_weight) *w = this->_max_weight;
+        } else {
+            (*w)--;
+            if (*w < this->_min_weight) *w = this->_min_weight;
+        }
+    }
+}
+
+cb::perceptron_predictor* cb::perceptron_predictor::clone() {
+    return new perceptron_predictor(*this);
+}
+
+/**
+ * This method is used to create an instance of the branch predictor and
+ * provide it to the performance model.
+ */
+cb::ibranchpredictor* cb::perceptron_predictor::create_branchpredictor() {
+    return new cb::perceptron_predictor();
+}
+
+void cb::perceptron_predictor::_init(const pt::ptree& props,
+                                     O3_CPU* cpu_inst) {
+    uint32_t weight_bits;
+
+    // Calling the version of the parent class first.
+    cb::ibranchpredictor::_init(props, cpu_inst);
+
+    this->_history_length = props.get<uint32_t>("history_length");
+    this->_num_perceptrons = props.get<uint32_t>("num_perceptrons");
+    weight_bits = props.get<uint32_t>("weight_bits");
+
+    this->_max_weight = (1 << (weight_bits - 1)) - 1;
+    this->_min_weight = -(this->_max_weight + 1);
+    this->_theta = static_cast<int32_t>(1.93 * this->_history_length + 14);
+
+    // Now that have got the knobs from the configuration file, let's create the
+    // data structures.
+    this->_weights = std::vector<int32_t>(this->_num_perceptrons *
+                                          (this->_history_length + 1));
+    this->_state_buf = std::vector<perceptron_state>(
+        props.get<std::size_t>("update_entries"));
+
+    this->initialize();
+}
@@ -0,0 +1,74 @@
+#include <internals/branch_predictors/ibranchpredictor.hh>
+#
+#include <vector>
+#
+#include <boost/property_tree/ptree.hpp>
+#
+#include <boost/dll.hpp>
+#include <boost/dll/alias.hpp>
+
+namespace dll = boost::dll;
+namespace pt = boost::property_tree;
+
+namespace champsim {
+namespace branch_predictors {
+/**
+ * @brief An implementation of the perceptron branch predictor from Jimenez &
+ * Lin, "Dynamic branch prediction with perceptrons", HPCA 2001.
+ */
+class perceptron_predictor : public ibranchpredictor {
+   private:
+    /**
+     * @brief Keeps the information needed to update the perceptron that
+     * yielded a prediction.
+     */
+    struct perceptron_state {
+       public:
+        int32_t prediction, /*!< 1 for taken, 0 for not taken. */
+            output;         /*!< The perceptron output. */
+        uint64_t history;   /*!< The history register yielding this
+                               prediction. */
+        std::size_t perc;   /*!< The perceptron yielding this prediction. */
+    };
+
+   public:
+    virtual ~perceptron_predictor();
+
+    virtual void initialize() final;
+    virtual uint8_t predict_branch(uint64_t ip) final;
+    virtual void last_branch_result(uint64_t ip, uint8_t taken) final;
+
+    virtual perceptron_predictor* clone() final;
+
+    static ibranchpredictor* create_branchpredictor();
+
+   protected:
+    perceptron_predictor();
+
+   private:
+    perceptron_predictor(const perceptron_predictor& o);
+
+    virtual void _init(const pt::ptree& props, O3_CPU* cpu_inst) final;
+
+   private:
+    uint32_t _history_length, _num_perceptrons;
+    int32_t _max_weight, _min_weight, _theta;
+
+    // Weights of all the perceptrons, history_length + 1 per perceptron (the
+    // first one being the bias weight).
+    std::vector<int32_t> _weights;
+
+    std::vector<perceptron_state> _state_buf;
+    std::size_t _state_buf_ctr, _last_state;
+
+    // Speculative global history, updated by the predictor, and real global
+    // history, updated when the predictor is updated.
+    uint64_t _spec_global_history, _global_history;
+};
+}  // namespace branch_predictors
+}  // namespace champsim
+
+// Exporting the symbol used for module loading.
+BOOST_DLL_ALIAS(
+    champsim::branch_predictors::perceptron_predictor::create_branchpredictor,
+    create_branchpredictor)
@@ -1,7 +1,102 @@
+#include <algorithm>
+#include <unordered_map>
+#
 #include <plugins/prefetchers/l1d_berti/helpers.hh>
 
 namespace cp = champsim::prefetchers;
 
+namespace {
+/**
+ * @brief Recency order of the entries of a table, as a doubly-linked list. It
+ * replaces the LRU positions updated by a scan of the whole table on every
+ * access, in the same order.
+ */
+template <std::size_t N>
+class lru_list {
+   private:
+    uint16_t _prev[N], _next[N];
+    uint16_t _mru, _lru;
+
+    void unlink(uint16_t i) {
+        (i == this->_mru) ? (this->_mru = this->_next[i])
+                          : (this->_next[this->_prev[i]] = this->_next[i]);
+        (i == this->_lru) ? (this->_lru = this->_prev[i])
+                          : (this->_prev[this->_next[i]] = this->_prev[i]);
+    }
+
+   public:
+    // Entry 0 is the most recently used, as in the initial LRU positions.
+    void reset() {
+        for (std::size_t i = 0; i < N; i++) {
+            this->_prev[i] = i - 1;
+            this->_next[i] = i + 1;
+        }
+
+        this->_mru = 0;
+        this->_lru = N - 1;
+    }
+
+    void touch(uint64_t i) {
+        if (i == this->_mru) return;
+
+        this->unlink(i);
+        this->_prev[i] = N;
+        this->_next[i] = this->_mru;
+        this->_prev[this->_mru] = i;
+        this->_mru = i;
+    }
+
+    uint64_t evict() {
+        uint64_t victim = this->_lru;
+
+        this->touch(victim);
+
+        return victim;
+    }
+};
+
+// Mask of the lowest bits of a page bit vector.
+inline uint64_t l1d_low_mask(int bits) {
+    return (bits >= L1D_PAGE_BLOCKS) ? UINT64_MAX
+                                     : (((uint64_t)1 << bits) - 1);
+}
+
+/**
+ * @brief Indices over the tables of a core, only used by the helpers.
+ */
+struct l1d_helper_tables {
+    // Page addresses of the current pages table, scanned without touching
+    // the rest of the entries.
+    uint64_t current_pages_tags[L1D_CURRENT_PAGES_TABLE_ENTRIES];
+    lru_list<L1D_CURRENT_PAGES_TABLE_ENTRIES> current_pages_lru;
+
+    // Slot of the previous request and latency entries of each page pointer
+    // and offset. A (pointer, offset) pair is never allocated twice, so a
+    // slot per pair is enough.
+    uint16_t prev_requests_index[L1D_CURRENT_PAGES_TABLE_ENTRIES]
+                                [L1D_PAGE_BLOCKS];
+    uint16_t latencies_index[L1D_CURRENT_PAGES_TABLE_ENTRIES][L1D_PAGE_BLOCKS];
+    uint64_t prev_requests_head, latencies_head;
+
+    // Age of the youngest previous request whose time is larger than the one
+    // of the next request, i.e. where the 16 bits time wrapped around.
+    uint64_t prev_requests_wrap;
+
+    // Slot of each truncated page address of the record pages table, the
+    // lowest one for the null address that all entries start with.
+    std::unordered_map<uint64_t, uint64_t> record_pages_index;
+    lru_list<L1D_RECORD_PAGES_TABLE_ENTRIES> record_pages_lru;
+};
+
+l1d_helper_tables l1d_helper_sets[cp::l1d_isolation_policy::sets];
+l1d_helper_tables *l1d_state = &l1d_helper_sets[0];
+}  // namespace
+
+void cp::l1d_select_tables(uint32_t cpu) {
+    l1d_bind_tables(cpu);
+    l1d_state = &l1d_helper_sets[l1d_isolation_policy::set(cpu)];
+}
+
 uint64_t cp::l1d_get_latency(uint64_t cycle, uint64_t cycle_prev) {
     uint64_t cycle_masked = cycle & L1D_TIME_MASK;
     uint64_t cycle_prev_masked = cycle_prev & L1D_TIME_MASK;
@@ -26,59 +121,41 @@ int cp::l1d_calculate_stride(uint64_t prev_offset, uint64_t current_offset) {
 }
 
 uint64_t cp::l1d_count_bit_vector(uint64_t vector) {
-    uint64_t count = 0;
-    for (int i = 0; i < L1D_PAGE_BLOCKS; i++) {
-        if (vector & ((uint64_t)1 << i)) {
-            count++;
-        }
-    }
-    return count;
+    return __builtin_popcountll(vector);
 }
 
 uint64_t cp::l1d_count_wrong_berti_bit_vector(uint64_t vector, int berti) {
-    uint64_t wrong = 0;
-    for (int i = 0; i < L1D_PAGE_BLOCKS; i++) {
-        if (vector & ((uint64_t)1 << i)) {
-            if (i + berti >= 0 && i + berti < L1D_PAGE_BLOCKS &&
-                !(vector & ((uint64_t)1 << (i + berti)))) {
-                wrong++;
-            }
-        }
+    // Blocks whose block at the berti distance is in the page but was not
+    // accessed.
+    if (berti >= 0) {
+        return __builtin_popcountll(vector &
+                                    l1d_low_mask(L1D_PAGE_BLOCKS - berti) &
+                                    ~(vector >> berti));
     }
-    return wrong;
+    return __builtin_popcountll(vector & ~l1d_low_mask(-berti) &
+                                ~(vector << -berti));
 }
 
 uint64_t cp::l1d_count_lost_berti_bit_vector(uint64_t vector, int berti) {
-    uint64_t lost = 0;
     if (berti > 0) {
-        for (int i = 0; i < berti; i++) {
-            if (vector & ((uint64_t)1 << i)) {
-                lost++;
-            }
-        }
+        return __builtin_popcountll(vector & l1d_low_mask(berti));
     } else if (berti < 0) {
-        for (int i = L1D_PAGE_OFFSET_MASK; i > L1D_PAGE_OFFSET_MASK + berti;
-             i--) {
-            if (vector & ((uint64_t)1 << i)) {
-                lost++;
-            }
-        }
+        return __builtin_popcountll(vector &
+                                    ~l1d_low_mask(L1D_PAGE_BLOCKS + berti));
     }
-    return lost;
+    return 0;
 }
 
 bool cp::l1d_all_last_berti_accessed_bit_vector(uint64_t vector, int berti) {
     unsigned count_yes = 0;
     unsigned count_no = 0;
     if (berti < 0) {
-        for (int i = 0; i < (0 - berti); i++) {
-            (vector & ((uint64_t)1 << i)) ? count_yes++ : count_no++;
-        }
+        count_yes = __builtin_popcountll(vector & l1d_low_mask(0 - berti));
+        count_no = (0 - berti) - count_yes;
     } else if (berti > 0) {
-        for (int i = L1D_PAGE_OFFSET_MASK; i > L1D_PAGE_OFFSET_MASK - berti;
-             i--) {
-            (vector & ((uint64_t)1 << i)) ? count_yes++ : count_no++;
-        }
+        count_yes = __builtin_popcountll(
+            vector & ~l1d_low_mask(L1D_PAGE_BLOCKS - berti));
+        count_no = berti - count_yes;
     } else
         return true;
     // cout << "COUNT: " << count_yes << " " << count_no << " " <<
@@ -102,44 +179,31 @@ void cp::l1d_init_current_pages_table() {
         l1d_current_pages_table[i].stride = 0;
         l1d_current_pages_table[i].short_reuse = true;
         l1d_current_pages_table[i].continue_burst = false;
-        l1d_current_pages_table[i].lru = i;
+        l1d_state->current_pages_tags[i] = 0;
     }
+    l1d_state->current_pages_lru.reset();
 }
 
 uint64_t cp::l1d_get_current_pages_entry(uint64_t page_addr) {
     for (int i = 0; i < L1D_CURRENT_PAGES_TABLE_ENTRIES; i++) {
-        if (l1d_current_pages_table[i].page_addr == page_addr) return i;
+        if (l1d_state->current_pages_tags[i] == page_addr) return i;
     }
     return L1D_CURRENT_PAGES_TABLE_ENTRIES;
 }
 
 void cp::l1d_update_lru_current_pages_table(uint64_t index) {
     assert(index < L1D_CURRENT_PAGES_TABLE_ENTRIES);
-    for (int i = 0; i < L1D_CURRENT_PAGES_TABLE_ENTRIES; i++) {
-        if (l1d_current_pages_table[i].lru <
-            l1d_current_pages_table[index].lru) {  // Found
-            l1d_current_pages_table[i].lru++;
-        }
-    }
-    l1d_current_pages_table[index].lru = 0;
+    l1d_state->current_pages_lru.touch(index);
 }
 
 uint64_t cp::l1d_get_lru_current_pages_entry() {
-    uint64_t lru = L1D_CURRENT_PAGES_TABLE_ENTRIES;
-    for (int i = 0; i < L1D_CURRENT_PAGES_TABLE_ENTRIES; i++) {
-        l1d_current_pages_table[i].lru++;
-        if (l1d_current_pages_table[i].lru == L1D_CURRENT_PAGES_TABLE_ENTRIES) {
-            l1d_current_pages_table[i].lru = 0;
-            lru = i;
-        }
-    }
-    assert(lru != L1D_CURRENT_PAGES_TABLE_ENTRIES);
-    return lru;
+    return l1d_state->current_pages_lru.evict();
 }
 
 void cp::l1d_add_current_pages_table(uint64_t index, uint64_t page_addr) {
     assert(index < L1D_CURRENT_PAGES_TABLE_ENTRIES);
     l1d_current_pages_table[index].page_addr = page_addr;
+    l1d_state->current_pages_tags[index] = page_addr;
     l1d_current_pages_table[index].u_vector = 0;
     for (int i = 0; i < L1D_CURRENT_PAGES_TABLE_NUM_BERTI; i++) {
         l1d_current_pages_table[index].berti[i] = 0;
@@ -264,20 +328,32 @@ bool cp::l1d_offset_requested_current_pages_table(uint64_t index,
 }
 
 void cp::l1d_init_prev_requests_table() {
-    l1d_prev_requests_table_head = 0;
+    l1d_state->prev_requests_head = 0;
     for (int i = 0; i < L1D_PREV_REQUESTS_TABLE_ENTRIES; i++) {
         l1d_prev_requests_table[i].page_addr_pointer =
             L1D_PREV_REQUESTS_TABLE_NULL_POINTER;
     }
+    std::fill(&l1d_state->prev_requests_index[0][0],
+              &l1d_state->prev_requests_index[0][0] +
+                  L1D_CURRENT_PAGES_TABLE_ENTRIES * L1D_PAGE_BLOCKS,
+              L1D_PREV_REQUESTS_TABLE_ENTRIES);
+
+    // Times are kept across initializations, looking for the youngest wrap
+    // from the last slot
+    l1d_state->prev_requests_wrap = L1D_PREV_REQUESTS_TABLE_ENTRIES;
+    for (uint64_t age = 1; age < L1D_PREV_REQUESTS_TABLE_MASK; age++) {
+        if (l1d_prev_requests_table[L1D_PREV_REQUESTS_TABLE_MASK - age].time >
+            l1d_prev_requests_table[L1D_PREV_REQUESTS_TABLE_MASK - age + 1]
+                .time) {
+            l1d_state->prev_requests_wrap = age;
+            break;
+        }
+    }
 }
 
 uint64_t cp::l1d_find_prev_request_entry(uint64_t pointer, uint64_t offset) {
-    for (int i = 0; i < L1D_PREV_REQUESTS_TABLE_ENTRIES; i++) {
-        if (l1d_prev_requests_table[i].page_addr_pointer == pointer &&
-            l1d_prev_requests_table[i].offset == offset)
-            return i;
-    }
-    return L1D_PREV_REQUESTS_TABLE_ENTRIES;
+    assert(pointer < L1D_CURRENT_PAGES_TABLE_ENTRIES);
+    return l1d_state->prev_requests_index[pointer][offset];
 }
 
 void cp::l1d_add_prev_requests_table(uint64_t pointer, uint64_t offset,
@@ -288,20 +364,44 @@ void cp::l1d_add_prev_requests_table(uint64_t pointer, uint64_t offset,
         return;
 
     // Allocate a new entry (evict old one if necessary)
-    l1d_prev_requests_table[l1d_prev_requests_table_head].page_addr_pointer =
-        pointer;
-    l1d_prev_requests_table[l1d_prev_requests_table_head].offset = offset;
-    l1d_prev_requests_table[l1d_prev_requests_table_head].time =
-        cycle & L1D_TIME_MASK;
-    l1d_prev_requests_table_head =
-        (l1d_prev_requests_table_head + 1) & L1D_PREV_REQUESTS_TABLE_MASK;
+    l1d_prev_request_entry &entry =
+        l1d_prev_requests_table[l1d_state->prev_requests_head];
+    if (entry.page_addr_pointer != L1D_PREV_REQUESTS_TABLE_NULL_POINTER) {
+        l1d_state->prev_requests_index[entry.page_addr_pointer][entry.offset] =
+            L1D_PREV_REQUESTS_TABLE_ENTRIES;
+    }
+
+    // The previous youngest entry is one step older, and the new one wraps
+    // around if it has a smaller time
+    uint64_t youngest_time =
+        l1d_prev_requests_table[(l1d_state->prev_requests_head +
+                                 L1D_PREV_REQUESTS_TABLE_MASK) &
+                                L1D_PREV_REQUESTS_TABLE_MASK]
+            .time;
+    if (youngest_time > (cycle & L1D_TIME_MASK)) {
+        l1d_state->prev_requests_wrap = 1;
+    } else if (l1d_state->prev_requests_wrap <
+               L1D_PREV_REQUESTS_TABLE_ENTRIES) {
+        l1d_state->prev_requests_wrap++;
+    }
+
+    entry.page_addr_pointer = pointer;
+    entry.offset = offset;
+    entry.time = cycle & L1D_TIME_MASK;
+    l1d_state->prev_requests_index[pointer][offset] =
+        l1d_state->prev_requests_head;
+    l1d_state->prev_requests_head =
+        (l1d_state->prev_requests_head + 1) & L1D_PREV_REQUESTS_TABLE_MASK;
 }
 
 void cp::l1d_reset_pointer_prev_requests(uint64_t pointer) {
-    for (int i = 0; i < L1D_PREV_REQUESTS_TABLE_ENTRIES; i++) {
-        if (l1d_prev_requests_table[i].page_addr_pointer == pointer) {
-            l1d_prev_requests_table[i].page_addr_pointer =
+    assert(pointer < L1D_CURRENT_PAGES_TABLE_ENTRIES);
+    for (int i = 0; i < L1D_PAGE_BLOCKS; i++) {
+        uint16_t &slot = l1d_state->prev_requests_index[pointer][i];
+        if (slot != L1D_PREV_REQUESTS_TABLE_ENTRIES) {
+            l1d_prev_requests_table[slot].page_addr_pointer =
                 L1D_PREV_REQUESTS_TABLE_NULL_POINTER;
+            slot = L1D_PREV_REQUESTS_TABLE_ENTRIES;
         }
     }
 }
@@ -310,57 +410,63 @@ void cp::l1d_get_berti_prev_requests_table(uint64_t pointer, uint64_t offset,
                                            uint64_t latency, int *berti,
                                            unsigned *saved_cycles,
                                            uint64_t req_time) {
+    assert(pointer < L1D_CURRENT_PAGES_TABLE_ENTRIES);
     int my_pos = 0;
     uint64_t extra_time = 0;
-    uint64_t last_time =
-        l1d_prev_requests_table[(l1d_prev_requests_table_head +
-                                 L1D_PREV_REQUESTS_TABLE_MASK) &
-                                L1D_PREV_REQUESTS_TABLE_MASK]
-            .time;
+    uint64_t youngest =
+        (l1d_state->prev_requests_head + L1D_PREV_REQUESTS_TABLE_MASK) &
+        L1D_PREV_REQUESTS_TABLE_MASK;
+
+    // Requests of the page from the youngest to the oldest, the slot at the
+    // head excepted
+    std::pair<uint64_t, uint64_t> requests[L1D_PAGE_BLOCKS];
+    int num_requests = 0;
+    for (int j = 0; j < L1D_PAGE_BLOCKS; j++) {
+        uint64_t slot = l1d_state->prev_requests_index[pointer][j];
+        if (slot != L1D_PREV_REQUESTS_TABLE_ENTRIES &&
+            slot != l1d_state->prev_requests_head) {
+            requests[num_requests++] = {
+                (youngest - slot) & L1D_PREV_REQUESTS_TABLE_MASK, slot};
+        }
+    }
+    std::sort(requests, requests + num_requests);
+
     // cout << "Latency " << latency << " " << pointer << " " << offset << " ";
     // l1d_print_prev_requests_table(pointer);
-    for (uint64_t i =
-             (l1d_prev_requests_table_head + L1D_PREV_REQUESTS_TABLE_MASK) &
-             L1D_PREV_REQUESTS_TABLE_MASK;
-         i != l1d_prev_requests_table_head;
-         i = (i + L1D_PREV_REQUESTS_TABLE_MASK) &
-             L1D_PREV_REQUESTS_TABLE_MASK) {
+    for (int j = 0; j < num_requests; j++) {
+        uint64_t i = requests[j].second;
         // Against the time overflow
-        if (last_time < l1d_prev_requests_table[i].time) {
+        if (requests[j].first >= l1d_state->prev_requests_wrap) {
             extra_time = L1D_TIME_OVERFLOW;
         }
-        last_time = l1d_prev_requests_table[i].time;
-        if (l1d_prev_requests_table[i].page_addr_pointer ==
-            pointer) {                                          // Same page
-            if (l1d_prev_requests_table[i].offset == offset) {  // Its me
-                req_time = l1d_prev_requests_table[i].time;
-            } else if (req_time) {  // Not me (check only older than me)
-                if (l1d_prev_requests_table[i].time <=
-                    req_time + extra_time - latency) {
-                    berti[my_pos] = l1d_calculate_stride(
-                        l1d_prev_requests_table[i].offset, offset);
-                    saved_cycles[my_pos] = latency;
-                    // cout << "pos1 " << my_pos << ": " << berti[my_pos] <<
-                    // "->" << saved_cycles[my_pos] << endl;
-                    my_pos++;
-                } else if (req_time + extra_time -
-                               l1d_prev_requests_table[i].time >
-                           0) {  // Only if some savings
+        if (l1d_prev_requests_table[i].offset == offset) {  // Its me
+            req_time = l1d_prev_requests_table[i].time;
+        } else if (req_time) {  // Not me (check only older than me)
+            if (l1d_prev_requests_table[i].time <=
+                req_time + extra_time - latency) {
+                berti[my_pos] = l1d_calculate_stride(
+                    l1d_prev_requests_table[i].offset, offset);
+                saved_cycles[my_pos] = latency;
+                // cout << "pos1 " << my_pos << ": " << berti[my_pos] <<
+                // "->" << saved_cycles[my_pos] << endl;
+                my_pos++;
+            } else if (req_time + extra_time -
+                           l1d_prev_requests_table[i].time >
+                       0) {  // Only if some savings
 #ifdef BERTI_LATENCIES
-                    berti[my_pos] = l1d_calculate_stride(
-                        l1d_prev_requests_table[i].offset, offset);
-                    saved_cycles[my_pos] =
-                        req_time + extra_time - l1d_prev_requests_table[i].time;
-                    // cout << "pos2 " << my_pos << ": " << berti[my_pos] <<
-                    // "->" << saved_cycles[my_pos] << " " << extra_time << " "
-                    // << l1d_prev_requests_table[i].time << endl;
-                    my_pos++;
+                berti[my_pos] = l1d_calculate_stride(
+                    l1d_prev_requests_table[i].offset, offset);
+                saved_cycles[my_pos] =
+                    req_time + extra_time - l1d_prev_requests_table[i].time;
+                // cout << "pos2 " << my_pos << ": " << berti[my_pos] <<
+                // "->" << saved_cycles[my_pos] << " " << extra_time << " "
+                // << l1d_prev_requests_table[i].time << endl;
+                my_pos++;
 #endif
-                }
-                if (my_pos == L1D_CURRENT_PAGES_TABLE_NUM_BERTI_PER_ACCESS) {
-                    berti[my_pos] = 0;
-                    return;
-                }
+            }
+            if (my_pos == L1D_CURRENT_PAGES_TABLE_NUM_BERTI_PER_ACCESS) {
+                berti[my_pos] = 0;
+                return;
             }
         }
     }
@@ -368,20 +474,20 @@ void cp::l1d_get_berti_prev_requests_table(uint64_t pointer, uint64_t offset,
 }
 
 void cp::l1d_init_latencies_table() {
-    l1d_latencies_table_head = 0;
+    l1d_state->latencies_head = 0;
     for (int i = 0; i < L1D_LATENCIES_TABLE_ENTRIES; i++) {
         l1d_latencies_table[i].page_addr_pointer =
             L1D_LATENCIES_TABLE_NULL_POINTER;
     }
+    std::fill(&l1d_state->latencies_index[0][0],
+              &l1d_state->latencies_index[0][0] +
+                  L1D_CURRENT_PAGES_TABLE_ENTRIES * L1D_PAGE_BLOCKS,
+              L1D_LATENCIES_TABLE_ENTRIES);
 }
 
 uint64_t cp::l1d_find_latency_entry(uint64_t pointer, uint64_t offset) {
-    for (int i = 0; i < L1D_LATENCIES_TABLE_ENTRIES; i++) {
-        if (l1d_latencies_table[i].page_addr_pointer == pointer &&
-            l1d_latencies_table[i].offset == offset)
-            return i;
-    }
-    return L1D_LATENCIES_TABLE_ENTRIES;
+    assert(pointer < L1D_CURRENT_PAGES_TABLE_ENTRIES);
+    return l1d_state->latencies_index[pointer][offset];
 }
 
 void cp::l1d_add_latencies_table(uint64_t pointer, uint64_t offset,
@@ -391,20 +497,28 @@ void cp::l1d_add_latencies_table(uint64_t pointer, uint64_t offset,
         return;
 
     // Allocate a new entry (evict old one if necessary)
-    l1d_latencies_table[l1d_latencies_table_head].page_addr_pointer = pointer;
-    l1d_latencies_table[l1d_latencies_table_head].offset = offset;
-    l1d_latencies_table[l1d_latencies_table_head].time_lat =
-        cycle & L1D_TIME_MASK;
-    l1d_latencies_table[l1d_latencies_table_head].completed = false;
-    l1d_latencies_table_head =
-        (l1d_latencies_table_head + 1) & L1D_LATENCIES_TABLE_MASK;
+    l1d_latency_entry &entry = l1d_latencies_table[l1d_state->latencies_head];
+    if (entry.page_addr_pointer != L1D_LATENCIES_TABLE_NULL_POINTER) {
+        l1d_state->latencies_index[entry.page_addr_pointer][entry.offset] =
+            L1D_LATENCIES_TABLE_ENTRIES;
+    }
+    entry.page_addr_pointer = pointer;
+    entry.offset = offset;
+    entry.time_lat = cycle & L1D_TIME_MASK;
+    entry.completed = false;
+    l1d_state->latencies_index[pointer][offset] = l1d_state->latencies_head;
+    l1d_state->latencies_head =
+        (l1d_state->latencies_head + 1) & L1D_LATENCIES_TABLE_MASK;
 }
 
 void cp::l1d_reset_pointer_latencies(uint64_t pointer) {
-    for (int i = 0; i < L1D_LATENCIES_TABLE_ENTRIES; i++) {
-        if (l1d_latencies_table[i].page_addr_pointer == pointer) {
-            l1d_latencies_table[i].page_addr_pointer =
+    assert(pointer < L1D_CURRENT_PAGES_TABLE_ENTRIES);
+    for (int i = 0; i < L1D_PAGE_BLOCKS; i++) {
+        uint16_t &slot = l1d_state->latencies_index[pointer][i];
+        if (slot != L1D_LATENCIES_TABLE_ENTRIES) {
+            l1d_latencies_table[slot].page_addr_pointer =
                 L1D_LATENCIES_TABLE_NULL_POINTER;
+            slot = L1D_LATENCIES_TABLE_ENTRIES;
         }
     }
 }
@@ -414,6 +528,8 @@ void cp::l1d_reset_entry_latencies_table(uint64_t pointer, uint64_t offset) {
     if (index != L1D_LATENCIES_TABLE_ENTRIES) {
         l1d_latencies_table[index].page_addr_pointer =
             L1D_LATENCIES_TABLE_NULL_POINTER;
+        l1d_state->latencies_index[pointer][offset] =
+            L1D_LATENCIES_TABLE_ENTRIES;
     }
 }
 
@@ -457,40 +573,27 @@ void cp::l1d_init_record_pages_table() {
         l1d_record_pages_table[i].linnea = 0;
         l1d_record_pages_table[i].last_offset = 0;
         l1d_record_pages_table[i].short_reuse = true;
-        l1d_record_pages_table[i].lru = i;
     }
+    l1d_state->record_pages_lru.reset();
+    l1d_state->record_pages_index.clear();
+    l1d_state->record_pages_index.reserve(L1D_RECORD_PAGES_TABLE_ENTRIES);
+    l1d_state->record_pages_index[0] = 0;
 }
 
 uint64_t cp::l1d_get_lru_record_pages_entry() {
-    uint64_t lru = L1D_RECORD_PAGES_TABLE_ENTRIES;
-    for (int i = 0; i < L1D_RECORD_PAGES_TABLE_ENTRIES; i++) {
-        l1d_record_pages_table[i].lru++;
-        if (l1d_record_pages_table[i].lru == L1D_RECORD_PAGES_TABLE_ENTRIES) {
-            l1d_record_pages_table[i].lru = 0;
-            lru = i;
-        }
-    }
-    assert(lru != L1D_RECORD_PAGES_TABLE_ENTRIES);
-    return lru;
+    return l1d_state->record_pages_lru.evict();
 }
 
 void cp::l1d_update_lru_record_pages_table(uint64_t index) {
     assert(index < L1D_RECORD_PAGES_TABLE_ENTRIES);
-    for (int i = 0; i < L1D_RECORD_PAGES_TABLE_ENTRIES; i++) {
-        if (l1d_record_pages_table[i].lru <
-            l1d_record_pages_table[index].lru) {  // Found
-            l1d_record_pages_table[i].lru++;
-        }
-    }
-    l1d_record_pages_table[index].lru = 0;
+    l1d_state->record_pages_lru.touch(index);
 }
 
 uint64_t cp::l1d_get_entry_record_pages_table(uint64_t page_addr) {
     uint64_t trunc_page_addr = page_addr & L1D_TRUNCATED_PAGE_ADDR_MASK;
-    for (int i = 0; i < L1D_RECORD_PAGES_TABLE_ENTRIES; i++) {
-        if (l1d_record_pages_table[i].page_addr == trunc_page_addr) {  // Found
-            return i;
-        }
+    auto it = l1d_state->record_pages_index.find(trunc_page_addr);
+    if (it != l1d_state->record_pages_index.end()) {  // Found
+        return it->second;
     }
     return L1D_RECORD_PAGES_TABLE_ENTRIES;
 }
@@ -502,8 +605,28 @@ void cp::l1d_add_record_pages_table(uint64_t page_addr, uint64_t new_page_addr,
         l1d_update_lru_record_pages_table(index);
     } else {
         index = l1d_get_lru_record_pages_entry();
+
+        // The victim leaves the index, the next null entry standing for the
+        // null address if it was the lowest one
+        uint64_t victim_addr = l1d_record_pages_table[index].page_addr;
+        auto it = l1d_state->record_pages_index.find(victim_addr);
+        if (it->second == index) {
+            uint64_t next = index + 1;
+            while (victim_addr == 0 && next < L1D_RECORD_PAGES_TABLE_ENTRIES &&
+                   l1d_record_pages_table[next].page_addr != 0) {
+                next++;
+            }
+            if (victim_addr == 0 && next < L1D_RECORD_PAGES_TABLE_ENTRIES) {
+                it->second = next;
+            } else {
+                l1d_state->record_pages_index.erase(it);
+            }
+        }
+
         l1d_record_pages_table[index].page_addr =
             page_addr & L1D_TRUNCATED_PAGE_ADDR_MASK;
+        l1d_state->record_pages_index.emplace(
+            l1d_record_pages_table[index].page_addr, index);
     }
     l1d_record_pages_table[index].linnea = new_page_addr;
     l1d_record_pages_table[index].last_offset = last_offset;
@@ -585,6 +708,7 @@ void cp::l1d_evict_current_page_entry(uint64_t index) {
 
 void cp::l1d_remove_current_table_entry(uint64_t index) {
     l1d_current_pages_table[index].page_addr = 0;
+    l1d_state->current_pages_tags[index] = 0;
     l1d_current_pages_table[index].u_vector = 0;
     for (int i = 0; i < L1D_CURRENT_PAGES_TABLE_NUM_BERTI; i++) {
         l1d_current_pages_table[index].berti[i] = 0;
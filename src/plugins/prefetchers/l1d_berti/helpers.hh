@@ -1,6 +1,7 @@
 #ifndef __CHAMPSIM_PLUGINS_PREFETCHERS_L1D_BERTI_HELPERS_HH__
 #define __CHAMPSIM_PLUGINS_PREFETCHERS_L1D_BERTI_HELPERS_HH__
 
+#include <cstddef>
 #include <cstdint>
 #
 #include <internals/champsim.h>
@@ -124,16 +125,51 @@ typedef struct __l1d_ip_entry {
     bool short_reuse;      // 1 bit
 } l1d_ip_entry;
 
+/**
+ * @brief Compile-time policies mapping a core to the set of tables it trains.
+ * The l1d_berti plugin shares a single set between all the cores, while
+ * l1d_berti_iso is built with L1D_BERTI_ISOLATION and gives each core its own
+ * set, so that a core prefetches in a multi-core run as it would in isolation.
+ */
+struct l1d_shared_tables {
+    static constexpr std::size_t sets = 1;
+    static constexpr std::size_t set(uint32_t /*cpu*/) { return 0; }
+};
+
+struct l1d_isolated_tables {
+    static constexpr std::size_t sets = NUM_CPUS;
+    static constexpr std::size_t set(uint32_t cpu) { return cpu; }
+};
+
+#if defined(L1D_BERTI_ISOLATION)
+using l1d_isolation_policy = l1d_isolated_tables;
+#else
+using l1d_isolation_policy = l1d_shared_tables;
+#endif
+
 static l1d_current_page_entry
-    l1d_current_pages_table[L1D_CURRENT_PAGES_TABLE_ENTRIES];
+    l1d_current_pages_tables[l1d_isolation_policy::sets]
+                            [L1D_CURRENT_PAGES_TABLE_ENTRIES];
 static l1d_prev_request_entry
-    l1d_prev_requests_table[L1D_PREV_REQUESTS_TABLE_ENTRIES];
-static uint64_t l1d_prev_requests_table_head;
-static l1d_latency_entry l1d_latencies_table[L1D_LATENCIES_TABLE_ENTRIES];
-static uint64_t l1d_latencies_table_head;
+    l1d_prev_requests_tables[l1d_isolation_policy::sets]
+                            [L1D_PREV_REQUESTS_TABLE_ENTRIES];
+static l1d_latency_entry l1d_latencies_tables[l1d_isolation_policy::sets]
+                                             [L1D_LATENCIES_TABLE_ENTRIES];
 static l1d_record_page_entry
-    l1d_record_pages_table[L1D_RECORD_PAGES_TABLE_ENTRIES];
-static l1d_ip_entry l1d_ip_table[L1D_IP_TABLE_ENTRIES];
+    l1d_record_pages_tables[l1d_isolation_policy::sets]
+                           [L1D_RECORD_PAGES_TABLE_ENTRIES];
+static l1d_ip_entry l1d_ip_tables[l1d_isolation_policy::sets]
+                                 [L1D_IP_TABLE_ENTRIES];
+
+// Tables of the core being served
+static l1d_current_page_entry *l1d_current_pages_table =
+    l1d_current_pages_tables[0];
+static l1d_prev_request_entry *l1d_prev_requests_table =
+    l1d_prev_requests_tables[0];
+static l1d_latency_entry *l1d_latencies_table = l1d_latencies_tables[0];
+static l1d_record_page_entry *l1d_record_pages_table =
+    l1d_record_pages_tables[0];
+static l1d_ip_entry *l1d_ip_table = l1d_ip_tables[0];
 
 // Stats
 static uint64_t l1d_ip_misses[L1D_IP_TABLE_ENTRIES];
@@ -146,6 +182,23 @@ static uint64_t l1d_stats_pref_current;
 static uint64_t cache_accesses;
 static uint64_t cache_misses;
 
+/**
+ * @brief Binds the tables of a core in the translation unit including this
+ * header, every one of them having its own copy of the tables.
+ */
+static inline void l1d_bind_tables(uint32_t cpu) {
+    std::size_t set = l1d_isolation_policy::set(cpu);
+
+    l1d_current_pages_table = l1d_current_pages_tables[set];
+    l1d_prev_requests_table = l1d_prev_requests_tables[set];
+    l1d_latencies_table = l1d_latencies_tables[set];
+    l1d_record_pages_table = l1d_record_pages_tables[set];
+    l1d_ip_table = l1d_ip_tables[set];
+}
+
+// Binds the tables of a core in the helpers.
+void l1d_select_tables(uint32_t cpu);
+
 uint64_t l1d_get_latency(uint64_t cycle, uint64_t cycle_prev);
 int l1d_calculate_stride(uint64_t prev_offset, uint64_t current_offset);
 uint64_t l1d_count_bit_vector(uint64_t vector);
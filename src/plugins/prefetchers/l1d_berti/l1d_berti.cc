@@ -18,7 +18,10 @@ namespace cp = champsim::prefetchers;
  */
 cp::l1d_berti::l1d_berti() {}
 
-cp::l1d_berti::l1d_berti(const cp::l1d_berti& o) : iprefetcher(o) {}
+cp::l1d_berti::l1d_berti(const cp::l1d_berti& o)
+    : iprefetcher(o),
+      _berti_degree(o._berti_degree),
+      _burst_degree(o._burst_degree) {}
 
 /**
  * Destructor of the class.
@@ -35,6 +38,10 @@ void cp::l1d_berti::operate(const cp::prefetch_request_descriptor& desc) {
     assert(desc.access_type == cc::cache::load ||
            desc.access_type == cc::cache::rfo);
 
+    // Working on the tables of the core, in both this file and the helpers.
+    l1d_bind_tables(desc.cpu);
+    l1d_select_tables(desc.cpu);
+
     cache_accesses++;
     if (!desc.hit) cache_misses++;
 
@@ -285,7 +292,7 @@ void cp::l1d_berti::operate(const cp::prefetch_request_descriptor& desc) {
                 burst_end = L1D_PAGE_OFFSET_MASK + berti;
                 burst_it = -1;
             }
-            int bursts = 0;
+            uint64_t bursts = 0;
             // if (ip_index == 0x10f) cout << "BURST " << burst_init << " " <<
             // burst_end << endl;
             for (int i = burst_init; i != burst_end; i += burst_it) {
@@ -299,7 +306,7 @@ void cp::l1d_berti::operate(const cp::prefetch_request_descriptor& desc) {
                     uint64_t pf_offset = pf_line_addr & L1D_PAGE_OFFSET_MASK;
                     // We are doing the berti here. Do not leave space for it
                     if (!this->_cache_inst->prefetch_queue()->is_full() &&
-                        bursts < L1D_BURST_THROTTLING) {
+                        bursts < this->_burst_degree) {
                         // if (ip_index == 0x10f) cout << "BURST PREFETCH " <<
                         // hex << page_addr << dec << " <" << pf_offset << ">"
                         // << endl;
@@ -324,7 +331,7 @@ void cp::l1d_berti::operate(const cp::prefetch_request_descriptor& desc) {
         }
 
         // Berti mode
-        for (int i = 1; i <= L1D_BERTI_THROTTLING; i++) {
+        for (uint64_t i = 1; i <= this->_berti_degree; i++) {
             // If the prefetcher will be done
             if (!this->_cache_inst->prefetch_queue()->is_full()) {
                 uint64_t pf_line_addr = line_addr + (berti * i);
@@ -514,6 +521,9 @@ void cp::l1d_berti::operate(const cp::prefetch_request_descriptor& desc) {
  */
 void cp::l1d_berti::fill(
     const champsim::helpers::cache_access_descriptor& desc) {
+    l1d_bind_tables(desc.cpu);
+    l1d_select_tables(desc.cpu);
+
     uint64_t line_addr = (desc.full_addr >> LOG2_BLOCK_SIZE);
     uint64_t page_addr = line_addr >> L1D_PAGE_BLOCKS_BITS;
     uint64_t offset = line_addr & L1D_PAGE_OFFSET_MASK;
@@ -580,15 +590,30 @@ cp::iprefetcher* cp::l1d_berti::create_prefetcher() {
     return new cp::l1d_berti();
 }
 
+/**
+ * @brief Scales the number of bertis prefetched and the length of the bursts.
+ * Unlike the bursts, the berti mode is allowed to go down to zero, so that the
+ * lowest scales turn it off.
+ */
+void cp::l1d_berti::throttle(const float& scale) {
+    this->_berti_degree = std::lround(L1D_BERTI_THROTTLING * scale);
+    this->_burst_degree = _scaled(L1D_BURST_THROTTLING, scale);
+}
+
 void cp::l1d_berti::_init(const pt::ptree& props, cc::cache* cache_inst) {
     // Calling the version of the parent class first.
     cp::iprefetcher::_init(props, cache_inst);
 
-    l1d_init_current_pages_table();
-    l1d_init_prev_requests_table();
-    l1d_init_latencies_table();
-    l1d_init_record_pages_table();
-    l1d_init_ip_table();
+    // The policy decides whether the cores share their tables or not.
+    for (uint32_t cpu = 0; cpu < NUM_CPUS; cpu++) {
+        l1d_select_tables(cpu);
+
+        l1d_init_current_pages_table();
+        l1d_init_prev_requests_table();
+        l1d_init_latencies_table();
+        l1d_init_record_pages_table();
+        l1d_init_ip_table();
+    }
 }
 
 std::ostream& operator<<(std::ostream& os,
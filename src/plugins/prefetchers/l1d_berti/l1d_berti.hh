@@ -18,7 +18,7 @@ namespace prefetchers {
 /**
  * @brief An implementation of a next line L1D prefetcher.
  */
-class l1d_berti : public iprefetcher {
+class l1d_berti final : public iprefetcher {
    private:
     struct current_page_entry {
         uint64_t page_addr, u_vector, lru;
@@ -75,6 +75,7 @@ class l1d_berti : public iprefetcher {
     virtual ~l1d_berti();
 
     virtual void operate(const prefetch_request_descriptor& desc) final;
+    virtual void throttle(const float& scale) final;
     virtual void fill(
         const champsim::helpers::cache_access_descriptor& desc) final;
 
@@ -94,6 +95,10 @@ class l1d_berti : public iprefetcher {
 
     // Prefetcher's statistics
     berti_stats _stats;
+
+    // Bertis used and lines of a burst issued per access, once throttled.
+    uint64_t _berti_degree = L1D_BERTI_THROTTLING,
+             _burst_degree = L1D_BURST_THROTTLING;
 };
 }  // namespace prefetchers
 }  // namespace champsim
@@ -102,7 +107,6 @@ std::ostream& operator<<(
     std::ostream& os, const champsim::prefetchers::l1d_berti::berti_stats& bs);
 
 // Exporting the symbol used for module loading.
-BOOST_DLL_ALIAS(champsim::prefetchers::l1d_berti::create_prefetcher,
-                create_prefetcher)
+CHAMPSIM_PREFETCHER_ALIAS(champsim::prefetchers::l1d_berti::create_prefetcher)
 
 #endif  // __CHAMPSIM_PLUGINS_PREFETCHERS_L1D_BERTI_HH__
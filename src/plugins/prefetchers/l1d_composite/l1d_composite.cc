@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#
+#include <plugins/prefetchers/l1d_composite/l1d_composite.hh>
+#
+#include <boost/property_tree/json_parser.hpp>
+
+namespace cp = champsim::prefetchers;
+
+static std::map<std::string, cp::composite_prefetcher::arbitration_policies>
+    arbitration_map = {
+        {"priority", cp::composite_prefetcher::by_priority},
+        {"accuracy", cp::composite_prefetcher::by_accuracy},
+};
+
+/**
+ * Constructor of the class.
+ */
+cp::composite_prefetcher::composite_prefetcher() {}
+
+/**
+ * Destructor of the class.
+ */
+cp::composite_prefetcher::~composite_prefetcher() {
+    for (component& c : this->_components) delete c.prefetcher;
+}
+
+/**
+ * @brief Runs all the components on an access, in order of rank. Their
+ * requests are issued as they make them.
+ * @param desc A descriptor filled with information regarding the prefetch
+ * request.
+ */
+void cp::composite_prefetcher::operate(
+    const cp::prefetch_request_descriptor& desc) {
+    this->_credit(desc);
+    this->_rank();
+
+    this->_cache_inst->collect_prefetches(this);
+
+    for (std::size_t i : this->_order) {
+        this->_current = i;
+        this->_components[i].prefetcher->operate(desc);
+    }
+
+    this->_cache_inst->collect_prefetches(nullptr);
+}
+
+/**
+ * @brief Runs all the components on the accesses of a cycle, in order of rank.
+ * The requests are issued by the composite, none is returned to the cache.
+ */
+void cp::composite_prefetcher::operate_batch(
+    const cp::prefetch_request_descriptor* descs, std::size_t count,
+    std::vector<cc::cache::prefetch_descriptor>& candidates) {
+    for (std::size_t i = 0; i < count; i++) this->_credit(descs[i]);
+    this->_rank();
+
+    this->_cache_inst->collect_prefetches(this);
+
+    for (std::size_t i : this->_order) {
+        this->_current = i;
+        this->_components[i].prefetcher->operate_batch(descs, count,
+                                                       this->_collected);
+
+        // Batched components return their requests instead of calling
+        // prefetch_line, they never see the outcome.
+        for (const cc::cache::prefetch_descriptor& pf : this->_collected)
+            this->collect(pf);
+
+        this->_collected.clear();
+    }
+
+    this->_cache_inst->collect_prefetches(nullptr);
+}
+
+void cp::composite_prefetcher::throttle(const float& scale) {
+    for (component& c : this->_components) c.prefetcher->throttle(scale);
+}
+
+void cp::composite_prefetcher::fill(
+    const champsim::helpers::cache_access_descriptor& desc) {
+    for (component& c : this->_components) c.prefetcher->fill(desc);
+}
+
+void cp::composite_prefetcher::clear_stats() {
+    for (component& c : this->_components) {
+        c.requested = 0;
+        c.filtered = 0;
+        c.dropped = 0;
+        c.issued = 0;
+        c.useful = 0;
+
+        c.prefetcher->clear_stats();
+    }
+}
+
+void cp::composite_prefetcher::dump_stats() {
+    std::cout << "[Composite Prefetcher]" << std::endl;
+
+    for (const component& c : this->_components) {
+        std::cout << c.name << " priority: " << c.priority
+                  << " requested: " << c.requested
+                  << " filtered: " << c.filtered << " dropped: " << c.dropped
+                  << " issued: " << c.issued << " useful: " << c.useful
+                  << std::endl;
+    }
+
+    std::cout << std::endl;
+
+    for (component& c : this->_components) c.prefetcher->dump_stats();
+}
+
+cp::composite_prefetcher::recent_request&
+cp::composite_prefetcher::_recent_request(uint64_t block) {
+    return this->_recent[(block ^ (block >> 16)) & (this->_recent.size() - 1)];
+}
+
+/**
+ * @brief Credits the component that prefetched the block of a demand access,
+ * the first time the block is accessed.
+ */
+void cp::composite_prefetcher::_credit(
+    const cp::prefetch_request_descriptor& desc) {
+    uint64_t block = desc.addr >> LOG2_BLOCK_SIZE;
+
+    if (desc.access_type != cc::cache::load &&
+        desc.access_type != cc::cache::rfo)
+        return;
+
+    recent_request& r = this->_recent_request(block);
+
+    if (!r.valid || r.credited || r.block != block) return;
+
+    this->_components[r.component].useful++;
+    this->_components[r.component].window_useful++;
+
+    r.credited = true;
+}
+
+/**
+ * @brief Orders the components by priority or by accuracy. Running them in
+ * that order makes the requests of the best ranked ones go first to the
+ * prefetch queue.
+ */
+void cp::composite_prefetcher::_rank() {
+    if (this->_arbitration == by_accuracy) {
+        std::stable_sort(this->_order.begin(), this->_order.end(),
+                         [this](std::size_t a, std::size_t b) {
+                             const component &ca = this->_components[a],
+                                             &cb = this->_components[b];
+
+                             return (ca.accuracy() != cb.accuracy())
+                                        ? (ca.accuracy() > cb.accuracy())
+                                        : (ca.priority < cb.priority);
+                         });
+    } else {
+        std::stable_sort(this->_order.begin(), this->_order.end(),
+                         [this](std::size_t a, std::size_t b) {
+                             return this->_components[a].priority <
+                                    this->_components[b].priority;
+                         });
+    }
+}
+
+/**
+ * @brief Decides a request of the running component. Blocks prefetched
+ * recently are filtered out, whichever component asked for them, the others
+ * are issued right away. The requests going through are then seen by the
+ * prefetch filter of the cache, if any, which counts its own drops but still
+ * reports them as issued.
+ * @return Returns true if the request has been issued.
+ */
+bool cp::composite_prefetcher::collect(
+    const cc::cache::prefetch_descriptor& pf) {
+    component& c = this->_components[this->_current];
+    uint64_t block = pf.pf_addr >> LOG2_BLOCK_SIZE;
+    recent_request& r = this->_recent_request(block);
+    cc::cache::prefetch_descriptor tagged = pf;
+
+    c.requested++;
+
+    if (r.valid && r.block == block) {
+        c.filtered++;
+        return false;
+    }
+
+    // Tagging the request for the prefetch accounting of the cache.
+    tagged.component = this->_current + 1;
+
+    if (!this->_cache_inst->issue_prefetch_line(tagged)) {
+        c.dropped++;
+        return false;
+    }
+
+    r = {true, false, block, this->_current};
+
+    c.issued++;
+
+    // The accuracy follows the recent behaviour of the component.
+    if (++c.window_issued == this->_accuracy_window) {
+        c.window_issued >>= 1;
+        c.window_useful >>= 1;
+    }
+
+    return true;
+}
+
+/**
+ * This method is used to create an instance of the prefetcher and provide it
+ * to the performance model.
+ */
+cp::iprefetcher* cp::composite_prefetcher::create_prefetcher() {
+    return new cp::composite_prefetcher();
+}
+
+void cp::composite_prefetcher::_init(const pt::ptree& props,
+                                     cc::cache* cache_inst) {
+    std::string arbitration;
+    std::size_t recent_entries;
+    std::map<std::string, arbitration_policies>::iterator arbitration_it;
+
+    // Calling the parent class' _init method.
+    cp::iprefetcher::_init(props, cache_inst);
+
+    arbitration = props.get<std::string>("arbitration", "priority");
+
+    if ((arbitration_it = arbitration_map.find(arbitration)) ==
+        arbitration_map.end()) {
+        throw std::runtime_error("Unknown prefetcher arbitration policy \"" +
+                                 arbitration + "\".");
+    }
+
+    this->_arbitration = arbitration_it->second;
+    this->_accuracy_window = props.get<uint64_t>("accuracy_window", 256);
+    recent_entries = props.get<std::size_t>("recent_requests", 64);
+
+    if (this->_accuracy_window < 2) {
+        throw std::runtime_error(
+            "The accuracy window of a composite prefetcher is too short.");
+    }
+
+    if (recent_entries == 0 || (recent_entries & (recent_entries - 1)) != 0) {
+        throw std::runtime_error(
+            "The recent request filter of a composite prefetcher must have a "
+            "power of two entries.");
+    }
+
+    this->_recent.assign(recent_entries, recent_request());
+
+    // Loading the components, in order.
+    for (const auto& e : props.get_child("components")) {
+        component c;
+        std::string config_path;
+
+        c.name = e.second.get<std::string>("prefetcher");
+        c.priority = e.second.get<int32_t>("priority",
+                                           this->_components.size());
+        config_path = e.second.get<std::string>(
+            "config", "config/prefetchers/" + c.name + ".json");
+
+        c.callable = champsim::import_plugin<cp::iprefetcher>(
+            "./prefetchers/", c.name, "create_prefetcher");
+        c.prefetcher = c.callable();
+        c.prefetcher->init(config_path, cache_inst);
+
+        this->_order.push_back(this->_components.size());
+        this->_components.push_back(c);
+    }
+
+    if (this->_components.empty()) {
+        throw std::runtime_error("A composite prefetcher needs components.");
+    }
+}
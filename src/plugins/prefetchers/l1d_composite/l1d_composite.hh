@@ -0,0 +1,128 @@
+#ifndef __CHAMPSIM_PLUGINS_PREFETCHERS_L1D_COMPOSITE_HH__
+#define __CHAMPSIM_PLUGINS_PREFETCHERS_L1D_COMPOSITE_HH__
+
+#include <functional>
+#include <string>
+#include <vector>
+#
+#include <internals/prefetchers/iprefetcher.hh>
+#
+#include <boost/shared_ptr.hpp>
+#
+#include <boost/property_tree/ptree.hpp>
+#
+#include <boost/dll.hpp>
+#include <boost/dll/alias.hpp>
+
+namespace dll = boost::dll;
+namespace pt = boost::property_tree;
+
+namespace champsim {
+namespace prefetchers {
+/**
+ * @brief A prefetcher running an ordered list of prefetcher plugins on the
+ * same cache. The components run in order of priority or accuracy, and each of
+ * their requests is decided as soon as they make it: it is filtered out when
+ * its block was prefetched recently, and issued otherwise. prefetch_line then
+ * returns to the component whether the request was issued, as it would
+ * without the composite, so that components counting their requests or
+ * backing off on a full prefetch queue behave as they do alone.
+ *
+ * The table of recent blocks remembers which component prefetched each block,
+ * to credit it when a demand hits the block. This is why it is kept apart from
+ * the prefetch filter of the cache (recent_prefetch_filter), which only sees
+ * the requests the composite let through. A request is thus counted as
+ * filtered by one of them at most.
+ *
+ * Components are plugins loaded and initialized by the composite, which can
+ * therefore not be cloned.
+ */
+class composite_prefetcher final : public iprefetcher,
+                             public cc::cache::prefetch_collector {
+   public:
+    enum arbitration_policies { by_priority, by_accuracy };
+
+   private:
+    struct component {
+        std::string name;
+        iprefetcher* prefetcher = nullptr;
+        std::function<iprefetcher*()> callable;
+
+        // lower is issued first
+        int32_t priority = 0;
+
+        // issued and useful prefetches of the current window, used to rank
+        // the components by accuracy
+        uint64_t window_issued = 0, window_useful = 0;
+
+        uint64_t requested = 0, filtered = 0, dropped = 0, issued = 0,
+                 useful = 0;
+
+        float accuracy() const {
+            return (this->window_issued == 0)
+                       ? 1.0f
+                       : static_cast<float>(this->window_useful) /
+                             this->window_issued;
+        }
+    };
+
+    // block recently prefetched, and the component that prefetched it
+    struct recent_request {
+        bool valid = false, credited = false;
+        uint64_t block = 0;
+        std::size_t component = 0;
+    };
+
+    std::vector<component> _components;
+    arbitration_policies _arbitration = by_priority;
+    uint64_t _accuracy_window = 256;
+
+    std::vector<recent_request> _recent;
+
+    // Components in the order they run, and the one running.
+    std::vector<std::size_t> _order;
+    std::size_t _current = 0;
+
+    // Buffer reused across cycles, receiving the requests of batched
+    // components.
+    std::vector<cc::cache::prefetch_descriptor> _collected;
+
+    recent_request& _recent_request(uint64_t block);
+
+    void _credit(const prefetch_request_descriptor& desc);
+    void _rank();
+
+   public:
+    virtual ~composite_prefetcher();
+
+    virtual void operate(const prefetch_request_descriptor& desc) final;
+    virtual void operate_batch(
+        const prefetch_request_descriptor* descs, std::size_t count,
+        std::vector<cc::cache::prefetch_descriptor>& candidates) final;
+    virtual void throttle(const float& scale) final;
+    virtual void fill(
+        const champsim::helpers::cache_access_descriptor& desc) final;
+
+    virtual bool collect(const cc::cache::prefetch_descriptor& pf) final;
+
+    virtual void clear_stats() final;
+    virtual void dump_stats() final;
+
+    static iprefetcher* create_prefetcher();
+
+   protected:
+    composite_prefetcher();
+
+   private:
+    composite_prefetcher(const composite_prefetcher& o) = delete;
+
+    virtual void _init(const pt::ptree& props, cc::cache* cache_inst) final;
+};
+}  // namespace prefetchers
+}  // namespace champsim
+
+// Exporting the symbol used for module loading.
+CHAMPSIM_PREFETCHER_ALIAS(
+    champsim::prefetchers::composite_prefetcher::create_prefetcher)
+
+#endif  // __CHAMPSIM_PLUGINS_PREFETCHERS_L1D_COMPOSITE_HH__
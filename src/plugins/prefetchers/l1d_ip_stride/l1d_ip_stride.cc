@@ -11,7 +11,11 @@ cp::l1d_ip_stride_prefetcher::l1d_ip_stride_prefetcher() {}
 
 cp::l1d_ip_stride_prefetcher::l1d_ip_stride_prefetcher(
     const cp::l1d_ip_stride_prefetcher& o)
-    : iprefetcher(o) {}
+    : iprefetcher(o),
+      _prefetch_degree(o._prefetch_degree),
+      _ip_tracker_size(o._ip_tracker_size),
+      _degree(o._degree),
+      _trackers(o._trackers) {}
 
 /**
  * Destructor of the class.
@@ -26,6 +30,38 @@ cp::l1d_ip_stride_prefetcher::~l1d_ip_stride_prefetcher() {}
  */
 void cp::l1d_ip_stride_prefetcher::operate(
     const cp::prefetch_request_descriptor& desc) {
+    this->_train(desc, this->_candidates);
+
+    for (const cc::cache::prefetch_descriptor& e : this->_candidates) {
+        this->_cache_inst->prefetch_line(e.cpu, e.size, e.ip, e.base_addr,
+                                         e.pf_addr, e.fill_level, e.metadata);
+    }
+
+    this->_candidates.clear();
+}
+
+/**
+ * @brief Trains the IP trackers on the accesses of the cycle, in order, so
+ * that every tracker sees the strides operate would have seen. The cache
+ * issues the requests once the whole cycle is trained.
+ */
+void cp::l1d_ip_stride_prefetcher::operate_batch(
+    const cp::prefetch_request_descriptor* descs, std::size_t count,
+    std::vector<cc::cache::prefetch_descriptor>& candidates) {
+    for (std::size_t i = 0; i < count; i++) this->_train(descs[i], candidates);
+}
+
+void cp::l1d_ip_stride_prefetcher::throttle(const float& scale) {
+    this->_degree = _scaled(this->_prefetch_degree, scale);
+}
+
+/**
+ * @brief Trains the tracker of the IP of an access and appends the prefetch
+ * requests it leads to.
+ */
+void cp::l1d_ip_stride_prefetcher::_train(
+    const cp::prefetch_request_descriptor& desc,
+    std::vector<cc::cache::prefetch_descriptor>& candidates) {
     uint64_t cl_addr = desc.addr >> LOG2_BLOCK_SIZE;
     int64_t stride = 0LL;
 
@@ -60,16 +96,18 @@ void cp::l1d_ip_stride_prefetcher::operate(
     // We only issue prefetches if there is a pattern of seeing the same dtride
     // more than once.
     if (stride == it_match->last_stride) {
-        for (uint32_t i = 0; i < this->_prefetch_degree; i++) {
+        for (uint32_t i = 0; i < this->_degree; i++) {
             uint64_t pf_address = (cl_addr + (stride * (i + 1)))
                                   << LOG2_BLOCK_SIZE;
 
             // Only issue prefetch if the prefetch address is in the same page
-            // as the current demand access address.
-			if ((pf_address >> LOG2_PAGE_SIZE) != (desc.addr >> LOG2_PAGE_SIZE))
+            // as the current demand access address, unless the cache
+            // translates the prefetches crossing a page.
+			if ((pf_address >> LOG2_PAGE_SIZE) != (desc.addr >> LOG2_PAGE_SIZE) &&
+				this->_cache_inst->cross_page_mode() == cc::cache::cross_page_off)
 				break;
 
-			this->_cache_inst->prefetch_line(desc.cpu, BLOCK_SIZE, desc.ip, desc.addr, pf_address, cc::cache::fill_l1, 0);
+			candidates.push_back({desc.cpu, BLOCK_SIZE, 0, desc.ip, desc.addr, pf_address, cc::cache::fill_l1});
         }
     }
 
@@ -99,6 +137,7 @@ void cp::l1d_ip_stride_prefetcher::_init(const pt::ptree& props,
 
     this->_prefetch_degree = props.get<uint64_t>("prefetch_degree");
     this->_ip_tracker_size = props.get<uint64_t>("ip_tracker_size");
+    this->_degree = this->_prefetch_degree;
 
     // Now that have got the knobs from the configuration file, let's create the
     // data structures.
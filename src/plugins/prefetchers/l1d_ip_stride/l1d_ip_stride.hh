@@ -15,7 +15,7 @@ namespace prefetchers {
 /**
  * @brief An implementation of a next line L1D prefetcher.
  */
-class l1d_ip_stride_prefetcher : public iprefetcher {
+class l1d_ip_stride_prefetcher final : public iprefetcher {
    private:
     struct ip_tracker {
        public:
@@ -37,6 +37,10 @@ class l1d_ip_stride_prefetcher : public iprefetcher {
     virtual ~l1d_ip_stride_prefetcher();
 
     virtual void operate(const prefetch_request_descriptor& desc) final;
+    virtual void operate_batch(
+        const prefetch_request_descriptor* descs, std::size_t count,
+        std::vector<cc::cache::prefetch_descriptor>& candidates) final;
+    virtual void throttle(const float& scale) final;
 
     virtual l1d_ip_stride_prefetcher* clone() final;
 
@@ -50,18 +54,26 @@ class l1d_ip_stride_prefetcher : public iprefetcher {
 
     virtual void _init(const pt::ptree& props, cc::cache* cache_inst) final;
 
+    void _train(const prefetch_request_descriptor& desc,
+                std::vector<cc::cache::prefetch_descriptor>& candidates);
+
     tracker_array::iterator _find_victim();
     tracker_array::iterator _lookup_trackers(const uint64_t& ip);
     void _update_replacement_state(tracker_array::iterator it);
 
    private:
     uint64_t _prefetch_degree, _ip_tracker_size;
+
+    // Degree in use once throttled.
+    uint64_t _degree;
     std::vector<ip_tracker> _trackers;
+
+    // Requests of the access being handled by operate.
+    std::vector<cc::cache::prefetch_descriptor> _candidates;
 };
 }  // namespace prefetchers
 }  // namespace champsim
 
 // Exporting the symbol used for module loading.
-BOOST_DLL_ALIAS(
-    champsim::prefetchers::l1d_ip_stride_prefetcher::create_prefetcher,
-    create_prefetcher)
+CHAMPSIM_PREFETCHER_ALIAS(
+    champsim::prefetchers::l1d_ip_stride_prefetcher::create_prefetcher)
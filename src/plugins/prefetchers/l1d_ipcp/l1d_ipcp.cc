@@ -11,7 +11,10 @@ namespace cp = champsim::prefetchers;
  */
 cp::l1d_ipcp::l1d_ipcp() {}
 
-cp::l1d_ipcp::l1d_ipcp(const cp::l1d_ipcp& o) : iprefetcher(o) {}
+cp::l1d_ipcp::l1d_ipcp(const cp::l1d_ipcp& o)
+    : iprefetcher(o),
+      _prefetch_degree(o._prefetch_degree),
+      _degree(o._degree) {}
 
 /**
  * Destructor of the class.
@@ -34,11 +37,16 @@ void cp::l1d_ipcp::operate(const cp::prefetch_request_descriptor& desc) {
     uint16_t ip_tag =
         (desc.ip >> this->_ip_index_bits) & ((1 << this->_ip_tag_bits) - 1);
     O3_CPU* curr_cpu = champsim::simulator::instance()->modeled_cpu(desc.cpu);
-
-    // These two knobs are specific to single-core simulation and might need a
-    // tweak if used in the multi-core context.
-    // TODO: We should consider moving them to the configuration file.
-    prefetch_degree = 3;
+    // Prefetches may leave the page of the access when the cache translates
+    // them.
+    bool cross_page =
+        (this->_cache_inst->cross_page_mode() != cc::cache::cross_page_off);
+
+    // The degree comes from the configuration file, scaled by the throttling
+    // of the cache. The next-line threshold is specific to single-core
+    // simulation and might need a tweak if used in the multi-core context.
+    // TODO: We should consider moving it to the configuration file as well.
+    prefetch_degree = this->_degree;
     spec_nl_threshold = 15;
 
     // Update miss counter.
@@ -79,7 +87,8 @@ void cp::l1d_ipcp::operate(const cp::prefetch_request_descriptor& desc) {
                               << LOG2_BLOCK_SIZE;
         // metadata = ...?
 
-        if ((pf_address >> LOG2_PAGE_SIZE) == (desc.addr >> LOG2_PAGE_SIZE))
+        if ((pf_address >> LOG2_PAGE_SIZE) == (desc.addr >> LOG2_PAGE_SIZE) ||
+            cross_page)
             this->_cache_inst->prefetch_line(desc.cpu, BLOCK_SIZE, desc.ip,
                                              desc.addr, pf_address,
                                              cc::cache::fill_l1, desc.went_offchip_pred);
@@ -150,8 +159,10 @@ void cp::l1d_ipcp::operate(const cp::prefetch_request_descriptor& desc) {
                 pf_address = (cl_addr - i - 1) << LOG2_BLOCK_SIZE;
             }
 
-            // Check if prefetch address is in same 4KB page.
-            if ((pf_address >> LOG2_PAGE_SIZE) == (desc.addr >> LOG2_PAGE_SIZE))
+            // Check if prefetch address is in same 4KB page, unless the cache
+            // translates the prefetches crossing a page.
+            if ((pf_address >> LOG2_PAGE_SIZE) == (desc.addr >> LOG2_PAGE_SIZE) ||
+                cross_page)
                 this->_cache_inst->prefetch_line(desc.cpu, BLOCK_SIZE, desc.ip,
                                                  desc.addr, pf_address,
                                                  cc::cache::fill_l1, desc.went_offchip_pred);
@@ -168,8 +179,10 @@ void cp::l1d_ipcp::operate(const cp::prefetch_request_descriptor& desc) {
                 (cl_addr + (this->_trackers[index].last_stride * (i + 1)))
                 << LOG2_BLOCK_SIZE;
 
-            // Check if prefetch address is in same 4KB page.
-            if ((pf_address >> LOG2_PAGE_SIZE) == (desc.addr >> LOG2_PAGE_SIZE))
+            // Check if prefetch address is in same 4KB page, unless the cache
+            // translates the prefetches crossing a page.
+            if ((pf_address >> LOG2_PAGE_SIZE) == (desc.addr >> LOG2_PAGE_SIZE) ||
+                cross_page)
                 this->_cache_inst->prefetch_line(desc.cpu, BLOCK_SIZE, desc.ip,
                                                  desc.addr, pf_address,
                                                  cc::cache::fill_l1, desc.went_offchip_pred);
@@ -190,9 +203,11 @@ void cp::l1d_ipcp::operate(const cp::prefetch_request_descriptor& desc) {
             pref_offset += this->_dpt[signature].delta;
             uint64_t pf_address = ((cl_addr + pref_offset) << LOG2_BLOCK_SIZE);
 
-            // Check if prefetch address is in same 4KB page.
+            // Check if prefetch address is in same 4KB page. The check is
+            // skipped when the cache translates the prefetches crossing a page.
             if (((pf_address >> LOG2_PAGE_SIZE) ==
-                 (desc.addr >> LOG2_PAGE_SIZE)) ||
+                     (desc.addr >> LOG2_PAGE_SIZE) &&
+                 !cross_page) ||
                 (this->_dpt[signature].conf == -1) ||
                 (this->_dpt[signature].delta == 0)) {
                 bpbp = 1;
@@ -280,6 +295,8 @@ void cp::l1d_ipcp::_init(const pt::ptree& props, cc::cache* cache_inst) {
     this->_ghb_size = props.get<uint64_t>("ghb_size");
     this->_ip_index_bits = props.get<uint64_t>("ip_index_bits");
     this->_ip_tag_bits = props.get<uint64_t>("ip_tag_bits");
+    this->_prefetch_degree = props.get<uint64_t>("prefetch_degree", 3);
+    this->_degree = this->_prefetch_degree;
 
     // Now that we ahve retrieved the knobs, we initialize data structures.
     this->_trackers = ip_tracker(this->_ip_table_size, ip_tracker_entry());
@@ -287,6 +304,14 @@ void cp::l1d_ipcp::_init(const pt::ptree& props, cc::cache* cache_inst) {
     this->_ghb = std::vector<uint64_t>(this->_ghb_size, 0ULL);
 }
 
+/**
+ * @brief Scales the prefetch degree, streams keep prefetching with twice the
+ * degree.
+ */
+void cp::l1d_ipcp::throttle(const float& scale) {
+    this->_degree = _scaled(this->_prefetch_degree, scale);
+}
+
 uint16_t cp::l1d_ipcp::_compute_signature(const uint16_t& old_sig, int delta) {
     uint16_t new_sig = 0;
     int sig_delta = 0;
@@ -15,7 +15,7 @@ namespace prefetchers {
 /**
  * @brief An implementation of a next line L1D prefetcher.
  */
-class l1d_ipcp : public iprefetcher {
+class l1d_ipcp final : public iprefetcher {
    private:
     struct ip_tracker_entry {
        public:
@@ -67,6 +67,7 @@ class l1d_ipcp : public iprefetcher {
     virtual ~l1d_ipcp();
 
     virtual void operate(const prefetch_request_descriptor& desc) final;
+    virtual void throttle(const float& scale) final;
 
     virtual void clear_stats() final, dump_stats() final;
 
@@ -90,6 +91,9 @@ class l1d_ipcp : public iprefetcher {
    private:
     uint64_t _ip_table_size, _ghb_size, _ip_index_bits, _ip_tag_bits;
 
+    // Configured prefetch degree, and the degree in use once throttled.
+    uint64_t _prefetch_degree, _degree;
+
     // Prefetcher's data structures.
     ip_tracker _trackers;
     delta_prediction_table _dpt;
@@ -105,5 +109,4 @@ class l1d_ipcp : public iprefetcher {
 }  // namespace champsim
 
 // Exporting the symbol used for module loading.
-BOOST_DLL_ALIAS(champsim::prefetchers::l1d_ipcp::create_prefetcher,
-                create_prefetcher)
+CHAMPSIM_PREFETCHER_ALIAS(champsim::prefetchers::l1d_ipcp::create_prefetcher)
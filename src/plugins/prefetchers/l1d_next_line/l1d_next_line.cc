@@ -29,9 +29,24 @@ cp::l1d_next_line_prefetcher::~l1d_next_line_prefetcher () {
  * @param desc A descriptor filled with information regarding the prefetch request.
  */
 void cp::l1d_next_line_prefetcher::operate (const cp::prefetch_request_descriptor& desc) {
-	uint64_t pf_addr = ((desc.addr >> LOG2_BLOCK_SIZE) + 1) << LOG2_BLOCK_SIZE;
+    this->_cache_inst->prefetch_line (desc.cpu, BLOCK_SIZE, desc.ip, desc.addr, _next_line (desc.addr), cc::cache::fill_l1 , 0);
+}
 
-    this->_cache_inst->prefetch_line (desc.cpu, BLOCK_SIZE, desc.ip, desc.addr, pf_addr, cc::cache::fill_l1 , 0);
+/**
+ * @brief Returns the next line of every access of the cycle to the cache, which issues them
+ * in the order of the accesses.
+ */
+void cp::l1d_next_line_prefetcher::operate_batch (const cp::prefetch_request_descriptor* descs, std::size_t count, std::vector<cc::cache::prefetch_descriptor>& candidates) {
+	for (std::size_t i = 0; i < count; i++) {
+		candidates.push_back ({ descs[i].cpu, BLOCK_SIZE, 0, descs[i].ip, descs[i].addr, _next_line (descs[i].addr), cc::cache::fill_l1 });
+	}
+}
+
+/**
+ * @brief Computes the address of the block following the one of an access.
+ */
+uint64_t cp::l1d_next_line_prefetcher::_next_line (const uint64_t& addr) {
+	return ((addr >> LOG2_BLOCK_SIZE) + 1) << LOG2_BLOCK_SIZE;
 }
 
 cp::l1d_next_line_prefetcher* cp::l1d_next_line_prefetcher::clone () {
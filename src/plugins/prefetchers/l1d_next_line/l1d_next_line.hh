@@ -15,11 +15,12 @@ namespace champsim {
         /**
          * @brief An implementation of a next line L1D prefetcher.
          */
-		class l1d_next_line_prefetcher : public iprefetcher {
+		class l1d_next_line_prefetcher final : public iprefetcher {
 		public:
 			virtual ~l1d_next_line_prefetcher ();
 
 			virtual void operate (const prefetch_request_descriptor& desc) final;
+			virtual void operate_batch (const prefetch_request_descriptor* descs, std::size_t count, std::vector<cc::cache::prefetch_descriptor>& candidates) final;
 
 			virtual l1d_next_line_prefetcher* clone () final;
 
@@ -28,6 +29,8 @@ namespace champsim {
 		private:
 			l1d_next_line_prefetcher (const l1d_next_line_prefetcher& o);
 
+			static uint64_t _next_line (const uint64_t& addr);
+
 		protected:
 			l1d_next_line_prefetcher ();
 		};
@@ -35,7 +38,6 @@ namespace champsim {
 }
 
 // Exporting the symbol used for module loading.
-BOOST_DLL_ALIAS(
-	champsim::prefetchers::l1d_next_line_prefetcher::create_prefetcher,
-	create_prefetcher
+CHAMPSIM_PREFETCHER_ALIAS(
+	champsim::prefetchers::l1d_next_line_prefetcher::create_prefetcher
 )
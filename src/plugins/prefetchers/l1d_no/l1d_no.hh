@@ -15,7 +15,7 @@ namespace champsim {
 	/**
      * @brief An implementation of a L1D prefetcher that does nothing.
      */
-    class l1d_no_prefetcher : public iprefetcher {
+    class l1d_no_prefetcher final : public iprefetcher {
 		public:
 			virtual ~l1d_no_prefetcher ();
 
@@ -32,9 +32,8 @@ namespace champsim {
 		};
 
     // Exporting the symbol used for module loading.
-		BOOST_DLL_ALIAS(
-			champsim::prefetchers::l1d_no_prefetcher::create_prefetcher,
-			create_prefetcher
+		CHAMPSIM_PREFETCHER_ALIAS(
+			champsim::prefetchers::l1d_no_prefetcher::create_prefetcher
 		)
 	}
 }
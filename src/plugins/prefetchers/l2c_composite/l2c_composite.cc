@@ -0,0 +1,3 @@
+// The composite prefetcher of the L2C is built from the sources of
+// l1d_composite, the cache is given by its configuration file.
+#include <plugins/prefetchers/l1d_composite/l1d_composite.cc>
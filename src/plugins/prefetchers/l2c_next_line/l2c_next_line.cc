@@ -27,15 +27,38 @@ cp::l2c_next_line_prefetcher::~l2c_next_line_prefetcher() {}
 void cp::l2c_next_line_prefetcher::operate(
     const cp::prefetch_request_descriptor& desc) {
     for (uint64_t i = 1; i <= this->_degree; i++) {
-        uint64_t pf_addr = ((desc.addr >> LOG2_BLOCK_SIZE) + i)
-                           << LOG2_BLOCK_SIZE;
-
         this->_cache_inst->prefetch_line(desc.cpu, BLOCK_SIZE, desc.ip,
-                                         desc.addr, pf_addr, cc::cache::fill_l2,
-                                         0);
+                                         desc.addr, _next_line(desc.addr, i),
+                                         cc::cache::fill_l2, 0);
+    }
+}
+
+/**
+ * @brief Returns the _degree blocks following each access of the cycle to the
+ * cache, access after access and closest block first, as operate would issue
+ * them.
+ */
+void cp::l2c_next_line_prefetcher::operate_batch(
+    const cp::prefetch_request_descriptor* descs, std::size_t count,
+    std::vector<cc::cache::prefetch_descriptor>& candidates) {
+    for (std::size_t i = 0; i < count; i++) {
+        for (uint64_t j = 1; j <= this->_degree; j++) {
+            candidates.push_back({descs[i].cpu, BLOCK_SIZE, 0, descs[i].ip,
+                                  descs[i].addr, _next_line(descs[i].addr, j),
+                                  cc::cache::fill_l2});
+        }
     }
 }
 
+/**
+ * @brief Computes the address of the block found distance blocks after the
+ * one of an access.
+ */
+uint64_t cp::l2c_next_line_prefetcher::_next_line(const uint64_t& addr,
+                                                  const uint64_t& distance) {
+    return ((addr >> LOG2_BLOCK_SIZE) + distance) << LOG2_BLOCK_SIZE;
+}
+
 cp::l2c_next_line_prefetcher* cp::l2c_next_line_prefetcher::clone() {
     return new l2c_next_line_prefetcher(*this);
 }
@@ -15,11 +15,12 @@ namespace champsim {
         /**
          * @brief An implementation of a next line L2C prefetcher.
          */
-		class l2c_next_line_prefetcher : public iprefetcher {
+		class l2c_next_line_prefetcher final : public iprefetcher {
 		public:
 			virtual ~l2c_next_line_prefetcher ();
 
 			virtual void operate (const prefetch_request_descriptor& desc) final;
+			virtual void operate_batch (const prefetch_request_descriptor* descs, std::size_t count, std::vector<cc::cache::prefetch_descriptor>& candidates) final;
 
 			virtual l2c_next_line_prefetcher* clone () final;
 
@@ -30,6 +31,8 @@ namespace champsim {
 
 			virtual void _init (const pt::ptree& props, cc::cache* cache_inst) final;
 
+			static uint64_t _next_line (const uint64_t& addr, const uint64_t& distance);
+
 		protected:
 			l2c_next_line_prefetcher ();
 
@@ -40,7 +43,6 @@ namespace champsim {
 }
 
 // Exporting the symbol used for module loading.
-BOOST_DLL_ALIAS(
-	champsim::prefetchers::l2c_next_line_prefetcher::create_prefetcher,
-	create_prefetcher
+CHAMPSIM_PREFETCHER_ALIAS(
+	champsim::prefetchers::l2c_next_line_prefetcher::create_prefetcher
 )
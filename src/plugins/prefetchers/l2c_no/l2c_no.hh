@@ -15,7 +15,7 @@ namespace champsim {
         /**
          * @brief An implementation of a L2C prefetcher that does nothing.
          */
-		class l2c_no_prefetcher : public iprefetcher {
+		class l2c_no_prefetcher final : public iprefetcher {
 		public:
 			virtual ~l2c_no_prefetcher ();
 
@@ -35,7 +35,6 @@ namespace champsim {
 }
 
 // Exporting the symbol used for module loading.
-BOOST_DLL_ALIAS(
-	champsim::prefetchers::l2c_no_prefetcher::create_prefetcher,
-	create_prefetcher
+CHAMPSIM_PREFETCHER_ALIAS(
+	champsim::prefetchers::l2c_no_prefetcher::create_prefetcher
 )
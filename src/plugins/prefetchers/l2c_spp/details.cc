@@ -137,8 +137,8 @@ void details::pattern_table::update_pattern (const uint32_t& last_sig, const int
 			this->counter_sig[set]++;
 
 			if (this->counter_sig[set] > this->desc.c_sig_max) {
-				for (auto& e: this->counter_delta[set]) {
-					e >>= 1;
+				for (std::size_t way = 0; way < this->desc.pt_ways; way++) {
+					this->counter_delta[set][way] >>= 1;
 				}
 
 				this->counter_sig[set] >>= 1;
@@ -165,8 +165,8 @@ void details::pattern_table::update_pattern (const uint32_t& last_sig, const int
 		this->counter_sig[set]++;
 
 		if (this->counter_sig[set] > this->desc.c_sig_max) {
-			for (auto& e: this->counter_delta[set]) {
-				e >>= 1;
+			for (std::size_t way = 0; way < this->desc.pt_ways; way++) {
+				this->counter_delta[set][way] >>= 1;
 			}
 
 			this->counter_sig[set] >>= 1;
@@ -6,6 +6,7 @@
 #include <vector>
 #
 #include <internals/champsim.h>
+#include <internals/table_arena.hh>
 
 namespace champsim {
 	namespace prefetchers {
@@ -67,28 +68,32 @@ namespace champsim {
 							pf_issued,
 							global_accuracy;
 
-				std::vector<bool> 	valid;
+				// One spare entry: the replacement in update_entry falls
+				// through to ghr_size when no entry can be evicted.
+				bool* 		valid;
 
-				std::vector<uint32_t>	sig,
-										confidence,
-										offset,
-										delta;
+				uint32_t	*sig,
+							*confidence,
+							*offset,
+							*delta;
 
 			public:
 				global_register () = default;
 
+				void bind (table_arena& arena, const spp_descriptor& desc) {
+					this->valid = arena.carve<bool> (desc.ghr_size + 1);
+					this->sig = arena.carve<uint32_t> (desc.ghr_size + 1);
+					this->confidence = arena.carve<uint32_t> (desc.ghr_size + 1);
+					this->offset = arena.carve<uint32_t> (desc.ghr_size + 1);
+					this->delta = arena.carve<uint32_t> (desc.ghr_size + 1);
+				}
+
 				void init (const spp_descriptor& desc) {
 					this->pf_useful = 0;
 					this->pf_issued = 0;
 					this->global_accuracy = 0;
 
-					// Initializing tables.
-					this->valid = std::vector<bool> (desc.ghr_size, false);
-					this->sig = std::vector<uint32_t> (desc.ghr_size, 0);
-					this->confidence = std::vector<uint32_t> (desc.ghr_size, 0);
-					this->offset = std::vector<uint32_t> (desc.ghr_size, 0);
-					this->delta = std::vector<uint32_t> (desc.ghr_size, 0);
-
+					// The tables come zero-filled from the arena.
 					this->desc = desc;
 				}
 
@@ -99,22 +104,30 @@ namespace champsim {
 			struct signature_table {
 			public:
 				spp_descriptor desc;
-				std::vector<std::vector<bool>> valid;
-				std::vector<std::vector<uint32_t>>  tag,
-													last_offset,
-													sig,
-													lru;
+				table_view<bool> valid;
+				table_view<uint32_t>	tag,
+										last_offset,
+										sig,
+										lru;
 
 			public:
 				signature_table () = default;
 
+				void bind (table_arena& arena, const spp_descriptor& desc) {
+					this->valid = table_view<bool>::carve (arena, desc.st_sets, desc.st_ways);
+					this->tag = table_view<uint32_t>::carve (arena, desc.st_sets, desc.st_ways);
+					this->last_offset = table_view<uint32_t>::carve (arena, desc.st_sets, desc.st_ways);
+					this->sig = table_view<uint32_t>::carve (arena, desc.st_sets, desc.st_ways);
+					this->lru = table_view<uint32_t>::carve (arena, desc.st_sets, desc.st_ways);
+				}
+
 				void init (const spp_descriptor& desc) {
 					// Initializing tables.
-					this->valid = std::vector<std::vector<bool>> (desc.st_sets, std::vector<bool> (desc.st_ways, false));
-					this->tag = std::vector<std::vector<uint32_t>> (desc.st_sets, std::vector<uint32_t> (desc.st_ways, 0ULL));
-					this->last_offset = std::vector<std::vector<uint32_t>> (desc.st_sets, std::vector<uint32_t> (desc.st_ways, 0ULL));
-					this->sig = std::vector<std::vector<uint32_t>> (desc.st_sets, std::vector<uint32_t> (desc.st_ways, 0ULL));
-					this->lru = std::vector<std::vector<uint32_t>> (desc.st_sets, std::vector<uint32_t> (desc.st_ways, desc.st_ways - 1));
+					for (std::size_t set = 0; set < desc.st_sets; set++) {
+						for (std::size_t way = 0; way < desc.st_ways; way++) {
+							this->lru[set][way] = desc.st_ways - 1;
+						}
+					}
 
 					this->desc = desc;
 				}
@@ -126,19 +139,21 @@ namespace champsim {
 			struct pattern_table {
 			public:
 				spp_descriptor desc;
-				std::vector<std::vector<int32_t>> delta;
-				std::vector<std::vector<uint32_t>> counter_delta;
-				std::vector<uint32_t> counter_sig;
+				table_view<int32_t> delta;
+				table_view<uint32_t> counter_delta;
+				uint32_t* counter_sig;
 
 			public:
 				pattern_table () = default;
 
-				void init (const spp_descriptor& desc) {
-					// Initializing tables.
-					this->delta = std::vector<std::vector<int32_t>> (desc.pt_sets, std::vector<int32_t> (desc.pt_ways, 0));
-					this->counter_delta = std::vector<std::vector<uint32_t>> (desc.pt_sets, std::vector<uint32_t> (desc.pt_ways, 0));
-					this->counter_sig = std::vector<uint32_t> (desc.pt_sets, 0);
+				void bind (table_arena& arena, const spp_descriptor& desc) {
+					this->delta = table_view<int32_t>::carve (arena, desc.pt_sets, desc.pt_ways);
+					this->counter_delta = table_view<uint32_t>::carve (arena, desc.pt_sets, desc.pt_ways);
+					this->counter_sig = arena.carve<uint32_t> (desc.pt_sets);
+				}
 
+				void init (const spp_descriptor& desc) {
+					// The tables come zero-filled from the arena.
 					this->desc = desc;
 				}
 
@@ -159,19 +174,21 @@ namespace champsim {
 
 			public:
 				spp_descriptor desc;
-				std::vector<uint64_t> remainder_tag;
-				std::vector<bool> 	valid,
-									useful;
+				uint64_t* remainder_tag;
+				bool 	*valid,
+						*useful;
 
 			public:
 				prefetch_filter () = default;
 
-				void init (const spp_descriptor& desc) {
-					// Initializing tables.
-					this->remainder_tag = std::vector<uint64_t> (desc.filter_sets, 0ULL);
-					this->valid = std::vector<bool> (desc.filter_sets, false);
-					this->useful = std::vector<bool> (desc.filter_sets, false);
+				void bind (table_arena& arena, const spp_descriptor& desc) {
+					this->remainder_tag = arena.carve<uint64_t> (desc.filter_sets);
+					this->valid = arena.carve<bool> (desc.filter_sets);
+					this->useful = arena.carve<bool> (desc.filter_sets);
+				}
 
+				void init (const spp_descriptor& desc) {
+					// The tables come zero-filled from the arena.
 					this->desc = desc;
 				}
 
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cmath>
+#
 #include <plugins/prefetchers/l2c_spp/l2c_spp.hh>
 #
 #include <boost/property_tree/json_parser.hpp>
@@ -7,15 +10,16 @@ namespace cp = champsim::prefetchers;
 /**
  * Constructor of the class.
  */
-cp::l2c_spp_prefetcher::l2c_spp_prefetcher () {
+cp::l2c_spp_prefetcher::l2c_spp_prefetcher () : _base_pf_threshold (0) {
 
 }
 
 cp::l2c_spp_prefetcher::l2c_spp_prefetcher (const cp::l2c_spp_prefetcher& o) :
- 	_desc (o._desc),
-	_st (o._st), _pt (o._pt), _filter (o._filter), _ghr (o._ghr),
-    iprefetcher (o) {
-
+    iprefetcher (o),
+ 	_desc (o._desc), _base_pf_threshold (o._base_pf_threshold), _arena (o._arena),
+	_st (o._st), _pt (o._pt), _filter (o._filter), _ghr (o._ghr) {
+	// The arena holds a copy of the tables, pointing the tables at it.
+	this->_bind_tables ();
 }
 
 /**
@@ -124,10 +128,37 @@ void cp::l2c_spp_prefetcher::clone (l2c_spp_prefetcher* o) {
     cp::iprefetcher::operator= (*o);
 
     this->_desc = o->_desc;
+    this->_base_pf_threshold = o->_base_pf_threshold;
+    this->_arena = o->_arena;
     this->_st = o->_st;
     this->_pt = o->_pt;
     this->_filter = o->_filter;
     this->_ghr = o->_ghr;
+
+    this->_bind_tables ();
+}
+
+/**
+ * @brief Throttling SPP through its prefetch threshold, a more aggressive prefetcher follows less
+ * confident paths further ahead.
+ */
+void cp::l2c_spp_prefetcher::throttle (const float& scale) {
+	std::size_t threshold = std::clamp<long> (std::lround (this->_base_pf_threshold / scale), 1L, 100L);
+
+	this->_desc.pf_threshold = threshold;
+	this->_pt.desc.pf_threshold = threshold;
+}
+
+/**
+ * @brief Carves the tables out of the arena, following the geometry of the descriptor.
+ */
+void cp::l2c_spp_prefetcher::_bind_tables () {
+	this->_arena.rewind ();
+
+	this->_st.bind (this->_arena, this->_desc);
+	this->_pt.bind (this->_arena, this->_desc);
+	this->_filter.bind (this->_arena, this->_desc);
+	this->_ghr.bind (this->_arena, this->_desc);
 }
 
 /**
@@ -166,6 +197,7 @@ void cp::l2c_spp_prefetcher::_init (const pt::ptree& props, cc::cache* cache_ins
 	this->_desc.remainder_bits = props.get<std::size_t> ("prefetch_filter.remainder_bits");
 	this->_desc.fill_threshold = props.get<std::size_t> ("prefetch_filter.fill_threshold");
 	this->_desc.pf_threshold = props.get<std::size_t> ("prefetch_filter.prefetch_threshold");
+	this->_base_pf_threshold = this->_desc.pf_threshold;
 
 	this->_desc.hash_bits = this->_desc.quotient_bits + this->_desc.remainder_bits;
 	this->_desc.filter_sets = (1ULL << this->_desc.quotient_bits);
@@ -176,6 +208,12 @@ void cp::l2c_spp_prefetcher::_init (const pt::ptree& props, cc::cache* cache_ins
 
 	this->_desc.global_counter_max = ((1ULL << this->_desc.global_counter_bits) - 1ULL);
 
+	// Sizing the arena, then allocating all the tables at once.
+	this->_arena.clear ();
+	this->_bind_tables ();
+	this->_arena.allocate ();
+	this->_bind_tables ();
+
 	// Initilizing internal structures.
 	this->_st.init (this->_desc);
 	this->_pt.init (this->_desc);
@@ -20,12 +20,13 @@ namespace champsim {
 		/**
 		 * @brief An implementation of a L2C prefetcher that does nothing.
 		 */
-		class l2c_spp_prefetcher : public iprefetcher {
+		class l2c_spp_prefetcher final : public iprefetcher {
 		public:
 			virtual ~l2c_spp_prefetcher ();
 
 			virtual void operate (const prefetch_request_descriptor& desc) final;
       virtual void fill (const champsim::helpers::cache_access_descriptor& desc) final;
+			virtual void throttle (const float& scale) final;
 
 			virtual l2c_spp_prefetcher* clone () final;
 			virtual void clone (l2c_spp_prefetcher* o) final;
@@ -40,9 +41,17 @@ namespace champsim {
 
 			virtual void _init (const pt::ptree& props, cc::cache* cache_inst) final;
 
+			void _bind_tables ();
+
 		private:
 			details::spp_descriptor		_desc;
 
+			// Prefetch threshold configured, before throttling.
+			std::size_t					_base_pf_threshold;
+
+			// All the tables below live in this arena.
+			champsim::table_arena		_arena;
+
 			details::signature_table 	_st;
 			details::pattern_table 		_pt;
 			details::prefetch_filter 	_filter;
@@ -52,9 +61,8 @@ namespace champsim {
 }
 
 // Exporting the symbol used for module loading.
-BOOST_DLL_ALIAS(
-	champsim::prefetchers::l2c_spp_prefetcher::create_prefetcher,
-	create_prefetcher
+CHAMPSIM_PREFETCHER_ALIAS(
+	champsim::prefetchers::l2c_spp_prefetcher::create_prefetcher
 )
 
 #endif // __CHAMPSIM_PLUGINS_PREFETCHERS_L2C_SPP_HH__
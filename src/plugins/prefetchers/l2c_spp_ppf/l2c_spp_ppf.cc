@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <stdexcept>
+#
 #include <plugins/prefetchers/l2c_spp_ppf/l2c_spp_ppf.hh>
 #
 #include <boost/property_tree/json_parser.hpp>
@@ -11,7 +14,20 @@ cp::l2c_spp_ppf_prefetcher::l2c_spp_ppf_prefetcher() {}
 
 cp::l2c_spp_ppf_prefetcher::l2c_spp_ppf_prefetcher(
     const cp::l2c_spp_ppf_prefetcher& o)
-    : iprefetcher(o) {}
+    : iprefetcher(o),
+      _geometry(o._geometry),
+      _arena(o._arena),
+      _st(o._st),
+      _pt(o._pt),
+      _filter(o._filter),
+      _ghr(o._ghr),
+      _perc(o._perc),
+      _prefetch_q_full(o._prefetch_q_full) {
+    std::copy(o._depth_track, o._depth_track + 30, this->_depth_track);
+
+    // The arena holds a copy of the tables, pointing the tables at it.
+    this->_bind_tables();
+}
 
 /**
  * Destructor of the class.
@@ -42,23 +58,23 @@ void cp::l2c_spp_ppf_prefetcher::operate(
     }
 
     confidence_q[0] = 100;
-    GHR.global_accuracy =
-        GHR.pf_issued
-            ? ((100 * GHR.pf_useful) / GHR.pf_issued)
+    this->_ghr.global_accuracy =
+        this->_ghr.pf_issued
+            ? ((100 * this->_ghr.pf_useful) / this->_ghr.pf_issued)
             : 0;
 
     for (int i = PAGES_TRACKED - 1; i > 0; i--) {  // N down to 1
-        GHR.page_tracker[i] = GHR.page_tracker[i - 1];
+        this->_ghr.page_tracker[i] = this->_ghr.page_tracker[i - 1];
     }
 
-    GHR.page_tracker[0] = page;
+    this->_ghr.page_tracker[0] = page;
 
     int distinct_pages = 0;
     uint8_t num_pf = 0;
     for (int i = 0; i < PAGES_TRACKED; i++) {
         int j;
         for (j = 0; j < i; j++) {
-            if (GHR.page_tracker[i] == GHR.page_tracker[j]) break;
+            if (this->_ghr.page_tracker[i] == this->_ghr.page_tracker[j]) break;
         }
         if (i == j) distinct_pages++;
     }
@@ -66,16 +82,18 @@ void cp::l2c_spp_ppf_prefetcher::operate(
     // Stage 1: Read and update a sig stored in ST
     // last_sig and delta are used to update (sig, delta) correlation in PT
     // curr_sig is used to read prefetch candidates in PT
-    ST.read_and_update_sig(page, page_offset, last_sig, curr_sig, delta);
+    this->_st.read_and_update_sig(page, page_offset, last_sig, curr_sig, delta,
+                                  this->_ghr);
 
-    FILTER.train_neg = 1;
+    this->_filter.train_neg = 1;
 
     // Also check the prefetch filter in parallel to update global accuracy
     // counters
-    FILTER.check(desc.addr, 0, 0, L2C_DEMAND, 0, 0, 0, 0, 0, 0);
+    this->_filter.check(desc.addr, 0, 0, L2C_DEMAND, 0, 0, 0, 0, 0, 0,
+                        this->_ghr, this->_perc);
 
     // Stage 2: Update delta patterns stored in PT
-    if (last_sig) PT.update_pattern(last_sig, delta);
+    if (last_sig) this->_pt.update_pattern(last_sig, delta);
 
     // Stage 3: Start prefetching
     uint64_t base_addr = desc.addr;
@@ -87,10 +105,10 @@ void cp::l2c_spp_ppf_prefetcher::operate(
     uint64_t train_addr = desc.addr;
     int32_t train_delta = 0;
 
-    GHR.ip_3 = GHR.ip_2;
-    GHR.ip_2 = GHR.ip_1;
-    GHR.ip_1 = GHR.ip_0;
-    GHR.ip_0 = desc.ip;
+    this->_ghr.ip_3 = this->_ghr.ip_2;
+    this->_ghr.ip_2 = this->_ghr.ip_1;
+    this->_ghr.ip_1 = this->_ghr.ip_0;
+    this->_ghr.ip_0 = desc.ip;
 
 #ifdef LOOKAHEAD_ON
     do {
@@ -104,14 +122,15 @@ void cp::l2c_spp_ppf_prefetcher::operate(
 
         // Read the PT. Also passing info required for perceptron inferencing as
         // PT calls perc_predict()
-        PT.read_pattern(curr_sig, delta_q, confidence_q, perc_sum_q,
+        this->_pt.read_pattern(curr_sig, delta_q, confidence_q, perc_sum_q,
                                lookahead_way, lookahead_conf, pf_q_tail, depth,
                                desc.addr, base_addr, train_addr, curr_ip,
                                train_delta, last_sig,
                                this->_cache_inst->prefetch_queue_occupancy(),
                                this->_cache_inst->prefetch_queue_size(),
                                this->_cache_inst->mshr_occupancy(),
-                               this->_cache_inst->mshr_size());
+                               this->_cache_inst->mshr_size(), this->_ghr,
+                               this->_filter, this->_perc);
 
         do_lookahead = 0;
 
@@ -133,15 +152,16 @@ void cp::l2c_spp_ppf_prefetcher::operate(
                 // retrieval
                 if (num_pf < ceil(((this->_cache_inst->prefetch_queue_size()) /
                                    distinct_pages))) {
-                    if (FILTER.check(
+                    if (this->_filter.check(
                             pf_addr, train_addr, curr_ip, fill_level,
                             train_delta + delta_q[i], last_sig, curr_sig,
-                            confidence_q[i], perc_sum, (depth - 1))) {
+                            confidence_q[i], perc_sum, (depth - 1),
+                            this->_ghr, this->_perc)) {
                         // Histogramming Idea
                         int32_t perc_sum_shifted =
                             perc_sum + (PERC_COUNTER_MAX + 1) * PERC_FEATURES;
                         int32_t hist_index = perc_sum_shifted / 10;
-                        FILTER.hist_tots[hist_index]++;
+                        this->_filter.hist_tots[hist_index]++;
 
                         //[DO NOT TOUCH]:
                         if (this->_cache_inst->prefetch_line(
@@ -152,28 +172,29 @@ void cp::l2c_spp_ppf_prefetcher::operate(
                                      : cc::cache::fill_llc),
                                 0)) {
                             num_pf++;
-                            FILTER.add_to_filter(
+                            this->_filter.add_to_filter(
                                 pf_addr, train_addr, curr_ip, fill_level,
                                 train_delta + delta_q[i], last_sig, curr_sig,
-                                confidence_q[i], perc_sum, (depth - 1));
+                                confidence_q[i], perc_sum, (depth - 1),
+                                this->_ghr);
                         } else {
                             this->_prefetch_q_full++;
                         }
 
                         // Only for stats
-                        GHR.perc_pass++;
-                        GHR.depth_val = 1;
-                        GHR.pf_total++;
-                        if (fill_level == SPP_L2C_PREFETCH) GHR.pf_l2c++;
-                        if (fill_level == SPP_LLC_PREFETCH) GHR.pf_llc++;
+                        this->_ghr.perc_pass++;
+                        this->_ghr.depth_val = 1;
+                        this->_ghr.pf_total++;
+                        if (fill_level == SPP_L2C_PREFETCH) this->_ghr.pf_l2c++;
+                        if (fill_level == SPP_LLC_PREFETCH) this->_ghr.pf_llc++;
                         // Stats end
 
                         // FILTER.valid_reject[quotient] = 0;
                         if (fill_level == SPP_L2C_PREFETCH) {
-                            GHR.pf_issued++;
-                            if (GHR.pf_issued > GLOBAL_COUNTER_MAX) {
-                                GHR.pf_issued >>= 1;
-                                GHR.pf_useful >>= 1;
+                            this->_ghr.pf_issued++;
+                            if (this->_ghr.pf_issued > GLOBAL_COUNTER_MAX) {
+                                this->_ghr.pf_issued >>= 1;
+                                this->_ghr.pf_useful >>= 1;
                             }
                         }
                     }
@@ -182,7 +203,7 @@ void cp::l2c_spp_ppf_prefetcher::operate(
 #ifdef GHR_ON
                 // Store this prefetch request in GHR to bootstrap SPP learning
                 // when we see a ST miss (i.e., accessing a new page)
-                GHR.update_entry(curr_sig, confidence_q[i],
+                this->_ghr.update_entry(curr_sig, confidence_q[i],
                                         (pf_addr >> LOG2_BLOCK_SIZE) & 0x3F,
                                         delta_q[i]);
 #endif
@@ -193,10 +214,10 @@ void cp::l2c_spp_ppf_prefetcher::operate(
 
         // Update base_addr and curr_sig
         if (lookahead_way < PT_WAY) {
-            uint32_t set = get_hash(curr_sig) % PT_SET;
+            uint32_t set = get_hash(curr_sig) % this->_pt.sets;
             base_addr +=
-                (PT.delta[set][lookahead_way] << LOG2_BLOCK_SIZE);
-            prev_delta += PT.delta[set][lookahead_way];
+                (this->_pt.delta[set][lookahead_way] << LOG2_BLOCK_SIZE);
+            prev_delta += this->_pt.delta[set][lookahead_way];
 
             // PT.delta uses a 7-bit sign magnitude representation to generate
             // sig_delta
@@ -204,10 +225,10 @@ void cp::l2c_spp_ppf_prefetcher::operate(
             // PT.delta[set][lookahead_way]) & 0x3F) + 0x40) :
             // PT.delta[set][lookahead_way];
             int sig_delta =
-                (PT.delta[set][lookahead_way] < 0)
-                    ? (((-1) * PT.delta[set][lookahead_way]) +
+                (this->_pt.delta[set][lookahead_way] < 0)
+                    ? (((-1) * this->_pt.delta[set][lookahead_way]) +
                        (1 << (SIG_DELTA_BIT - 1)))
-                    : PT.delta[set][lookahead_way];
+                    : this->_pt.delta[set][lookahead_way];
             curr_sig = ((curr_sig << SIG_SHIFT) ^ sig_delta) & SIG_MASK;
         }
 #ifdef LOOKAHEAD_ON
@@ -215,9 +236,9 @@ void cp::l2c_spp_ppf_prefetcher::operate(
 #endif  // LOOKAHEAD_ON
 
     // Stats
-    if (GHR.depth_val) {
-        GHR.depth_num++;
-        GHR.depth_sum += depth;
+    if (this->_ghr.depth_val) {
+        this->_ghr.depth_num++;
+        this->_ghr.depth_sum += depth;
     }
 
     this->_depth_track[depth]++;
@@ -226,8 +247,8 @@ void cp::l2c_spp_ppf_prefetcher::operate(
 void cp::l2c_spp_ppf_prefetcher::fill(
     const champsim::helpers::cache_access_descriptor& desc) {
 #ifdef FILTER_ON
-    FILTER.check(desc.victim_addr, 0ULL, 0ULL, L2C_EVICT, 0, 0, 0, 0, 0,
-                        0);
+    this->_filter.check(desc.victim_addr, 0ULL, 0ULL, L2C_EVICT, 0, 0, 0, 0, 0,
+                        0, this->_ghr, this->_perc);
 #endif  // FILTER_ON
 }
 
@@ -237,6 +258,32 @@ cp::l2c_spp_ppf_prefetcher* cp::l2c_spp_ppf_prefetcher::clone() {
 
 void cp::l2c_spp_ppf_prefetcher::clone(l2c_spp_ppf_prefetcher* o) {
     cp::iprefetcher::operator=(*o);
+
+    this->_geometry = o->_geometry;
+    this->_arena = o->_arena;
+    this->_st = o->_st;
+    this->_pt = o->_pt;
+    this->_filter = o->_filter;
+    this->_ghr = o->_ghr;
+    this->_perc = o->_perc;
+    this->_prefetch_q_full = o->_prefetch_q_full;
+
+    std::copy(o->_depth_track, o->_depth_track + 30, this->_depth_track);
+
+    this->_bind_tables();
+}
+
+/**
+ * @brief Carves the tables out of the arena, following the geometry of the
+ * instance.
+ */
+void cp::l2c_spp_ppf_prefetcher::_bind_tables() {
+    this->_arena.rewind();
+
+    this->_st.bind(this->_arena, this->_geometry);
+    this->_pt.bind(this->_arena, this->_geometry);
+    this->_filter.bind(this->_arena, this->_geometry);
+    this->_perc.bind(this->_arena, this->_geometry);
 }
 
 /**
@@ -252,6 +299,58 @@ void cp::l2c_spp_ppf_prefetcher::_init(const pt::ptree& props,
     // Calling the version of the parent class first.
     cp::iprefetcher::_init(props, cache_inst);
 
+    // Getting the geometry of the tables, the defaults being the ones of the
+    // original implementation.
+    this->_geometry.st_set =
+        props.get<uint32_t>("signature.table.sets", ST_SET);
+    this->_geometry.st_way =
+        props.get<uint32_t>("signature.table.ways", ST_WAY);
+    this->_geometry.pt_set = props.get<uint32_t>("pattern.table.sets", PT_SET);
+    this->_geometry.quotient_bit =
+        props.get<uint32_t>("prefetch_filter.quotient_bits", QUOTIENT_BIT);
+    this->_geometry.remainder_bit =
+        props.get<uint32_t>("prefetch_filter.remainder_bits", REMAINDER_BIT);
+    this->_geometry.quotient_bit_rej =
+        props.get<uint32_t>("reject_filter.quotient_bits", QUOTIENT_BIT_REJ);
+    this->_geometry.remainder_bit_rej =
+        props.get<uint32_t>("reject_filter.remainder_bits", REMAINDER_BIT_REJ);
+
+    if (props.get_child_optional("perceptron.depths")) {
+        std::size_t i = 0;
+
+        for (const auto& e : props.get_child("perceptron.depths")) {
+            if (i == PERC_FEATURES) break;
+
+            this->_geometry.perc_depth[i++] = e.second.get_value<int32_t>();
+        }
+
+        if (i != PERC_FEATURES)
+            throw std::runtime_error(
+                "The SPP-PPF perceptron needs one depth per feature.");
+    }
+
+    if (this->_geometry.st_set == 0 || this->_geometry.st_way == 0 ||
+        this->_geometry.pt_set == 0)
+        throw std::runtime_error(
+            "The SPP-PPF tables need at least one set and way.");
+
+    for (std::size_t i = 0; i < PERC_FEATURES; i++) {
+        if (this->_geometry.perc_depth[i] <= 0)
+            throw std::runtime_error(
+                "The SPP-PPF perceptron depths must be positive.");
+    }
+
+    // Sizing the arena, then allocating all the tables at once.
+    this->_arena.clear();
+    this->_bind_tables();
+    this->_arena.allocate();
+    this->_bind_tables();
+
+    this->_st.init();
+    this->_pt.init();
+    this->_filter.init();
+    this->_perc.init();
+
     for (std::size_t i = 0; i < 30; i++) this->_depth_track[i] = 0;
 
     this->_prefetch_q_full = 0;
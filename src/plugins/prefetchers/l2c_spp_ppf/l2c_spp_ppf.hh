@@ -20,7 +20,7 @@ namespace prefetchers {
 /**
  * @brief An implementation of a L2C prefetcher that does nothing.
  */
-class l2c_spp_ppf_prefetcher : public iprefetcher {
+class l2c_spp_ppf_prefetcher final : public iprefetcher {
    public:
     virtual ~l2c_spp_ppf_prefetcher();
 
@@ -41,7 +41,20 @@ class l2c_spp_ppf_prefetcher : public iprefetcher {
 
     virtual void _init(const pt::ptree& props, cc::cache* cache_inst) final;
 
+    void _bind_tables();
+
    private:
+    SPP_PPF_GEOMETRY _geometry;
+
+    // All the tables below live in this arena.
+    champsim::table_arena _arena;
+
+    SIGNATURE_TABLE _st;
+    PATTERN_TABLE _pt;
+    PREFETCH_FILTER _filter;
+    GLOBAL_REGISTER _ghr;
+    PERCEPTRON _perc;
+
     int _depth_track[30];
     int _prefetch_q_full;
 };
@@ -49,8 +62,7 @@ class l2c_spp_ppf_prefetcher : public iprefetcher {
 }  // namespace champsim
 
 // Exporting the symbol used for module loading.
-BOOST_DLL_ALIAS(
-    champsim::prefetchers::l2c_spp_ppf_prefetcher::create_prefetcher,
-    create_prefetcher)
+CHAMPSIM_PREFETCHER_ALIAS(
+    champsim::prefetchers::l2c_spp_ppf_prefetcher::create_prefetcher)
 
 #endif  // __CHAMPSIM_PLUGINS_PREFETCHERS_L2C_SPP_PPF_HH__
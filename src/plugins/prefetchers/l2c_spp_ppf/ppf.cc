@@ -31,8 +31,9 @@ uint64_t get_hash(uint64_t key) {
 
 void SIGNATURE_TABLE::read_and_update_sig(uint64_t page, uint32_t page_offset,
                                           uint32_t &last_sig,
-                                          uint32_t &curr_sig, int32_t &delta) {
-    uint32_t set = get_hash(page) % ST_SET, match = ST_WAY,
+                                          uint32_t &curr_sig, int32_t &delta,
+                                          GLOBAL_REGISTER &GHR) {
+    uint32_t set = get_hash(page) % sets, match = ways,
              partial_page = page & ST_TAG_MASK;
     uint8_t ST_hit = 0;
     int sig_delta = 0;
@@ -41,7 +42,7 @@ void SIGNATURE_TABLE::read_and_update_sig(uint64_t page, uint32_t page_offset,
                 << " partial_page: " << partial_page << dec << endl;);
 
     // Case 1: Hit
-    for (match = 0; match < ST_WAY; match++) {
+    for (match = 0; match < ways; match++) {
         if (valid[set][match] && (tag[set][match] == partial_page)) {
             last_sig = sig[set][match];
             delta = page_offset - last_offset[set][match];
@@ -76,8 +77,8 @@ void SIGNATURE_TABLE::read_and_update_sig(uint64_t page, uint32_t page_offset,
     }
 
     // Case 2: Invalid
-    if (match == ST_WAY) {
-        for (match = 0; match < ST_WAY; match++) {
+    if (match == ways) {
+        for (match = 0; match < ways; match++) {
             if (valid[set][match] == 0) {
                 valid[set][match] = 1;
                 tag[set][match] = partial_page;
@@ -98,9 +99,9 @@ void SIGNATURE_TABLE::read_and_update_sig(uint64_t page, uint32_t page_offset,
     }
 
     // Case 3: Miss
-    if (match == ST_WAY) {
-        for (match = 0; match < ST_WAY; match++) {
-            if (lru[set][match] == ST_WAY - 1) {  // Find replacement victim
+    if (match == ways) {
+        for (match = 0; match < ways; match++) {
+            if (lru[set][match] == ways - 1) {  // Find replacement victim
                 tag[set][match] = partial_page;
                 sig[set][match] = 0;
                 curr_sig = sig[set][match];
@@ -120,7 +121,7 @@ void SIGNATURE_TABLE::read_and_update_sig(uint64_t page, uint32_t page_offset,
 
 #ifdef SPP_SANITY_CHECK
         // Assertion
-        if (match == ST_WAY) {
+        if (match == ways) {
             cout << "[ST] Cannot find a replacement victim!" << endl;
             assert(0);
         }
@@ -143,13 +144,13 @@ void SIGNATURE_TABLE::read_and_update_sig(uint64_t page, uint32_t page_offset,
 #endif
 
     // Update LRU
-    for (uint32_t way = 0; way < ST_WAY; way++) {
+    for (uint32_t way = 0; way < ways; way++) {
         if (lru[set][way] < lru[set][match]) {
             lru[set][way]++;
 
 #ifdef SPP_SANITY_CHECK
             // Assertion
-            if (lru[set][way] >= ST_WAY) {
+            if (lru[set][way] >= ways) {
                 cout << "[ST] LRU value is wrong! set: " << set
                      << " way: " << way << " lru: " << lru[set][way] << endl;
                 assert(0);
@@ -162,7 +163,7 @@ void SIGNATURE_TABLE::read_and_update_sig(uint64_t page, uint32_t page_offset,
 
 void PATTERN_TABLE::update_pattern(uint32_t last_sig, int curr_delta) {
     // Update (sig, delta) correlation
-    uint32_t set = get_hash(last_sig) % PT_SET, match = 0;
+    uint32_t set = get_hash(last_sig) % sets, match = 0;
 
     // Case 1: Hit
     for (match = 0; match < PT_WAY; match++) {
@@ -228,24 +229,37 @@ void PATTERN_TABLE::read_pattern(
     uint32_t &pf_q_tail, uint32_t &depth, uint64_t addr, uint64_t base_addr,
     uint64_t train_addr, uint64_t curr_ip, int32_t train_delta,
     uint32_t last_sig, uint32_t pq_occupancy, uint32_t pq_SIZE,
-    uint32_t mshr_occupancy, uint32_t mshr_SIZE) {
+    uint32_t mshr_occupancy, uint32_t mshr_SIZE, GLOBAL_REGISTER &GHR,
+    PREFETCH_FILTER &FILTER, PERCEPTRON &PERC) {
     // Update (sig, delta) correlation
-    uint32_t set = get_hash(curr_sig) % PT_SET, local_conf = 0, pf_conf = 0,
+    uint32_t set = get_hash(curr_sig) % sets, local_conf = 0, pf_conf = 0,
              max_conf = 0;
 
     bool found_candidate = false;
 
     if (c_sig[set]) {
+        uint32_t way_conf[PT_WAY];
+        int32_t way_delta[PT_WAY], way_sum[PT_WAY];
+
+        // The perceptron is only trained on the filter feedback, so all the
+        // ways can be evaluated in a single batch
+        for (uint32_t way = 0; way < PT_WAY; way++) {
+            local_conf = (100 * c_delta[set][way]) / c_sig[set];
+            way_conf[way] = depth ? (GHR.global_accuracy * c_delta[set][way] /
+                                     c_sig[set] * lookahead_conf / 100)
+                                  : local_conf;
+            way_delta[way] = train_delta + delta[set][way];
+        }
+
+        PERC.perc_predict(train_addr, curr_ip, GHR.ip_1, GHR.ip_2, GHR.ip_3,
+                          way_delta, last_sig, curr_sig, way_conf, depth,
+                          PT_WAY, way_sum);
+
         for (uint32_t way = 0; way < PT_WAY; way++) {
             local_conf = (100 * c_delta[set][way]) / c_sig[set];
-            pf_conf = depth ? (GHR.global_accuracy * c_delta[set][way] /
-                               c_sig[set] * lookahead_conf / 100)
-                            : local_conf;
-
-            int32_t perc_sum =
-                PERC.perc_predict(train_addr, curr_ip, GHR.ip_1, GHR.ip_2,
-                                  GHR.ip_3, train_delta + delta[set][way],
-                                  last_sig, curr_sig, pf_conf, depth);
+            pf_conf = way_conf[way];
+
+            int32_t perc_sum = way_sum[way];
             bool do_pf = (perc_sum >= PERC_THRESHOLD_LO) ? 1 : 0;
             bool fill_l2 = (perc_sum >= PERC_THRESHOLD_HI) ? 1 : 0;
 
@@ -313,7 +327,8 @@ void PATTERN_TABLE::read_pattern(
                        1))) {  // Prefetch request is in the same physical page
                     FILTER.check(pf_addr, train_addr, curr_ip, SPP_PERC_REJECT,
                                  train_delta + delta[set][way], last_sig,
-                                 curr_sig, pf_conf, perc_sum, depth);
+                                 curr_sig, pf_conf, perc_sum, depth, GHR,
+                                 PERC);
                     GHR.perc_reject++;
                 }
             }
@@ -330,18 +345,19 @@ void PATTERN_TABLE::read_pattern(
 bool PREFETCH_FILTER::check(uint64_t check_addr, uint64_t base_addr,
                             uint64_t ip, FILTER_REQUEST filter_request,
                             int cur_delta, uint32_t last_sig, uint32_t curr_sig,
-                            uint32_t conf, int32_t sum, uint32_t depth) {
+                            uint32_t conf, int32_t sum, uint32_t depth,
+                            GLOBAL_REGISTER &GHR, PERCEPTRON &PERC) {
     uint64_t cache_line = check_addr >> LOG2_BLOCK_SIZE,
              hash = get_hash(cache_line);
 
     // MAIN FILTER
-    uint64_t quotient = (hash >> REMAINDER_BIT) & ((1 << QUOTIENT_BIT) - 1),
-             remainder = hash % (1 << REMAINDER_BIT);
+    uint64_t quotient = (hash >> remainder_bit) & ((1 << quotient_bit) - 1),
+             remainder = hash % (1 << remainder_bit);
 
     // REJECT FILTER
     uint64_t quotient_reject =
-                 (hash >> REMAINDER_BIT_REJ) & ((1 << QUOTIENT_BIT_REJ) - 1),
-             remainder_reject = hash % (1 << REMAINDER_BIT_REJ);
+                 (hash >> remainder_bit_rej) & ((1 << quotient_bit_rej) - 1),
+             remainder_reject = hash % (1 << remainder_bit_rej);
 
     SPP_DP(cout << "[FILTER] check_addr: " << hex << check_addr
                 << " check_cache_line: " << (check_addr >> LOG2_BLOCK_SIZE);
@@ -615,18 +631,19 @@ bool PREFETCH_FILTER::add_to_filter(uint64_t check_addr, uint64_t base_addr,
                                     uint64_t ip, FILTER_REQUEST filter_request,
                                     int cur_delta, uint32_t last_sig,
                                     uint32_t curr_sig, uint32_t conf,
-                                    int32_t sum, uint32_t depth) {
+                                    int32_t sum, uint32_t depth,
+                                    GLOBAL_REGISTER &GHR) {
     uint64_t cache_line = check_addr >> LOG2_BLOCK_SIZE,
              hash = get_hash(cache_line);
 
     // MAIN FILTER
-    uint64_t quotient = (hash >> REMAINDER_BIT) & ((1 << QUOTIENT_BIT) - 1),
-             remainder = hash % (1 << REMAINDER_BIT);
+    uint64_t quotient = (hash >> remainder_bit) & ((1 << quotient_bit) - 1),
+             remainder = hash % (1 << remainder_bit);
 
     // REJECT FILTER
     uint64_t quotient_reject =
-                 (hash >> REMAINDER_BIT_REJ) & ((1 << QUOTIENT_BIT_REJ) - 1),
-             remainder_reject = hash % (1 << REMAINDER_BIT_REJ);
+                 (hash >> remainder_bit_rej) & ((1 << quotient_bit_rej) - 1),
+             remainder_reject = hash % (1 << remainder_bit_rej);
 
     switch (filter_request) {
         case SPP_L2C_PREFETCH:
@@ -759,10 +776,12 @@ uint32_t GLOBAL_REGISTER::check_entry(uint32_t page_offset) {
     return max_conf_way;
 }
 
-void get_perc_index(uint64_t base_addr, uint64_t ip, uint64_t ip_1,
-                    uint64_t ip_2, uint64_t ip_3, int32_t cur_delta,
-                    uint32_t last_sig, uint32_t curr_sig, uint32_t confidence,
-                    uint32_t depth, uint64_t perc_set[PERC_FEATURES]) {
+void PERCEPTRON::get_perc_index(uint64_t base_addr, uint64_t ip,
+                                uint64_t ip_1, uint64_t ip_2, uint64_t ip_3,
+                                int32_t cur_delta, uint32_t last_sig,
+                                uint32_t curr_sig, uint32_t confidence,
+                                uint32_t depth,
+                                uint64_t perc_set[PERC_FEATURES]) {
     // Returns the imdexes for the perceptron tables
     uint64_t cache_line = base_addr >> LOG2_BLOCK_SIZE,
              page_addr = base_addr >> LOG2_PAGE_SIZE;
@@ -783,7 +802,8 @@ void get_perc_index(uint64_t base_addr, uint64_t ip, uint64_t ip_1,
     pre_hash[8] = confidence;
 
     for (int i = 0; i < PERC_FEATURES; i++) {
-        perc_set[i] = (pre_hash[i]) % PERC.PERC_DEPTH[i];  // Variable depths
+        perc_set[i] = PERC_OFFSET[i] +
+                      (pre_hash[i]) % PERC_DEPTH[i];  // Variable depths
         SPP_DP(cout << "  Perceptron Set Index#: " << i << " = "
                     << perc_set[i];);
     }
@@ -813,7 +833,7 @@ int32_t PERCEPTRON::perc_predict(uint64_t base_addr, uint64_t ip, uint64_t ip_1,
 
     int32_t sum = 0;
     for (int i = 0; i < PERC_FEATURES; i++) {
-        sum += perc_weights[perc_set[i]][i];
+        sum += perc_weights[perc_set[i]];
         // Calculate Sum
     }
     SPP_DP(cout << " Sum of perceptrons: " << sum << " Prediction made: "
@@ -825,6 +845,57 @@ int32_t PERCEPTRON::perc_predict(uint64_t base_addr, uint64_t ip, uint64_t ip_1,
     return sum;
 }
 
+void PERCEPTRON::perc_predict(uint64_t base_addr, uint64_t ip, uint64_t ip_1,
+                              uint64_t ip_2, uint64_t ip_3,
+                              const int32_t *cur_delta, uint32_t last_sig,
+                              uint32_t curr_sig, const uint32_t *confidence,
+                              uint32_t depth, uint32_t count,
+                              int32_t *perc_sum) {
+    // Same indexes as get_perc_index, but the features that do not depend on
+    // the candidate are only hashed once
+    uint64_t cache_line = base_addr >> LOG2_BLOCK_SIZE,
+             page_addr = base_addr >> LOG2_PAGE_SIZE;
+    uint32_t perc_set[PERC_FEATURES][PERC_BATCH];
+
+    assert(count <= PERC_BATCH);
+
+    uint32_t shared[] = {
+        PERC_OFFSET[0] + (uint32_t)(base_addr % PERC_DEPTH[0]),
+        PERC_OFFSET[1] + (uint32_t)(cache_line % PERC_DEPTH[1]),
+        PERC_OFFSET[2] + (uint32_t)(page_addr % PERC_DEPTH[2]),
+        PERC_OFFSET[5] +
+            (uint32_t)((ip_1 ^ (ip_2 >> 1) ^ (ip_3 >> 2)) % PERC_DEPTH[5]),
+        PERC_OFFSET[6] + (uint32_t)((ip ^ depth) % PERC_DEPTH[6])};
+
+    for (uint32_t c = 0; c < count; c++) {
+        uint64_t sig_delta =
+            (cur_delta[c] < 0)
+                ? (((-1) * cur_delta[c]) + (1 << (SIG_DELTA_BIT - 1)))
+                : cur_delta[c];
+
+        perc_set[0][c] = shared[0];
+        perc_set[1][c] = shared[1];
+        perc_set[2][c] = shared[2];
+        perc_set[3][c] =
+            PERC_OFFSET[3] + (confidence[c] ^ page_addr) % PERC_DEPTH[3];
+        perc_set[4][c] =
+            PERC_OFFSET[4] + (curr_sig ^ sig_delta) % PERC_DEPTH[4];
+        perc_set[5][c] = shared[3];
+        perc_set[6][c] = shared[4];
+        perc_set[7][c] = PERC_OFFSET[7] + (ip ^ sig_delta) % PERC_DEPTH[7];
+        perc_set[8][c] = PERC_OFFSET[8] + confidence[c] % PERC_DEPTH[8];
+    }
+
+    // Feature-major accumulation: each table is walked once for all the
+    // candidates
+    for (uint32_t c = 0; c < count; c++) perc_sum[c] = 0;
+
+    for (int i = 0; i < PERC_FEATURES; i++) {
+        for (uint32_t c = 0; c < count; c++)
+            perc_sum[c] += perc_weights[perc_set[i][c]];
+    }
+}
+
 void PERCEPTRON::perc_update(uint64_t base_addr, uint64_t ip, uint64_t ip_1,
                              uint64_t ip_2, uint64_t ip_3, int32_t cur_delta,
                              uint32_t last_sig, uint32_t curr_sig,
@@ -850,7 +921,7 @@ void PERCEPTRON::perc_update(uint64_t base_addr, uint64_t ip, uint64_t ip_1,
     int32_t sum = 0;
     for (int i = 0; i < PERC_FEATURES; i++) {
         // Marking the weights as touched for final dumping in the csv
-        perc_touched[perc_set[i]][i] = 1;
+        perc_touched[perc_set[i]] = 1;
     }
     // Restore the sum that led to the prediction
     sum = perc_sum;
@@ -861,13 +932,13 @@ void PERCEPTRON::perc_update(uint64_t base_addr, uint64_t ip, uint64_t ip_1,
         for (int i = 0; i < PERC_FEATURES; i++) {
             if (sum >= PERC_THRESHOLD_HI) {
                 // Prediction was to prefectch -- so decrement counters
-                if (perc_weights[perc_set[i]][i] > -1 * (PERC_COUNTER_MAX + 1))
-                    perc_weights[perc_set[i]][i]--;
+                if (perc_weights[perc_set[i]] > -1 * (PERC_COUNTER_MAX + 1))
+                    perc_weights[perc_set[i]]--;
             }
             if (sum < PERC_THRESHOLD_HI) {
                 // Prediction was to not prefetch -- so increment counters
-                if (perc_weights[perc_set[i]][i] < PERC_COUNTER_MAX)
-                    perc_weights[perc_set[i]][i]++;
+                if (perc_weights[perc_set[i]] < PERC_COUNTER_MAX)
+                    perc_weights[perc_set[i]]++;
             }
         }
         SPP_DP(int differential = (sum >= PERC_THRESHOLD_HI) ? -1 : 1;
@@ -879,13 +950,13 @@ void PERCEPTRON::perc_update(uint64_t base_addr, uint64_t ip, uint64_t ip_1,
         for (int i = 0; i < PERC_FEATURES; i++) {
             if (sum >= PERC_THRESHOLD_HI) {
                 // Prediction was to prefetch -- so increment counters
-                if (perc_weights[perc_set[i]][i] < PERC_COUNTER_MAX)
-                    perc_weights[perc_set[i]][i]++;
+                if (perc_weights[perc_set[i]] < PERC_COUNTER_MAX)
+                    perc_weights[perc_set[i]]++;
             }
             if (sum < PERC_THRESHOLD_HI) {
                 // Prediction was to not prefetch -- so decrement counters
-                if (perc_weights[perc_set[i]][i] > -1 * (PERC_COUNTER_MAX + 1))
-                    perc_weights[perc_set[i]][i]--;
+                if (perc_weights[perc_set[i]] > -1 * (PERC_COUNTER_MAX + 1))
+                    perc_weights[perc_set[i]]--;
             }
         }
         SPP_DP(int differential = 0;
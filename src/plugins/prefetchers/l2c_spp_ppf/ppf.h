@@ -3,7 +3,11 @@
 
 #include <iostream>
 #include <fstream>
+#
+#include <internals/table_arena.hh>
 using namespace std;
+using champsim::table_arena;
+using champsim::table_view;
 
 // SPP functional knobs
 #define LOOKAHEAD_ON
@@ -61,9 +65,10 @@ using namespace std;
 #define PAGES_TRACKED 6
 
 // Perceptron paramaters
-#define PERC_ENTRIES 4096 //Upto 12-bit addressing in hashed perceptron
+#define PERC_ENTRIES 4096 //Default upper bound of the feature depths
 #define PERC_FEATURES 9 //Keep increasing based on new features
 #define PERC_COUNTER_MAX 15 //-16 to +15: 5 bits counter 
+#define PERC_BATCH PT_WAY //Candidates evaluated at once
 #define PERC_THRESHOLD_HI  -5
 #define PERC_THRESHOLD_LO  -15
 #define POS_UPDT_THRESHOLD  90
@@ -73,23 +78,63 @@ enum FILTER_REQUEST {SPP_L2C_PREFETCH, SPP_LLC_PREFETCH, L2C_DEMAND, L2C_EVICT,
 
 uint64_t get_hash(uint64_t key);
 
+// Table geometry of an instance, the defaults are the values above
+struct SPP_PPF_GEOMETRY {
+	uint32_t st_set = ST_SET,
+			 st_way = ST_WAY,
+			 pt_set = PT_SET,
+			 quotient_bit = QUOTIENT_BIT,
+			 remainder_bit = REMAINDER_BIT,
+			 quotient_bit_rej = QUOTIENT_BIT_REJ,
+			 remainder_bit_rej = REMAINDER_BIT_REJ;
+
+	// CONST depths for different features
+	int32_t  perc_depth[PERC_FEATURES] = {
+		2048,	//base_addr;
+		4096,	//cache_line;
+		4096,	//page_addr;
+		4096,	//confidence ^ page_addr;
+		1024,	//curr_sig ^ sig_delta;
+		4096,	//ip_1 ^ ip_2 ^ ip_3;
+		1024,	//ip ^ depth;
+		2048,	//ip ^ sig_delta;
+		128		//confidence;
+	};
+};
+
+class GLOBAL_REGISTER;
+class PREFETCH_FILTER;
+class PERCEPTRON;
+
 class SIGNATURE_TABLE {
   public:
-    bool     valid[ST_SET][ST_WAY];
-    uint32_t tag[ST_SET][ST_WAY],
-             last_offset[ST_SET][ST_WAY],
-             sig[ST_SET][ST_WAY],
-             lru[ST_SET][ST_WAY];
+    uint32_t sets, ways;
+    table_view<bool> valid;
+    table_view<uint32_t> tag,
+                         last_offset,
+                         sig,
+                         lru;
+
+    void bind(table_arena &arena, const SPP_PPF_GEOMETRY &geometry) {
+        sets = geometry.st_set;
+        ways = geometry.st_way;
+
+        valid = table_view<bool>::carve(arena, sets, ways);
+        tag = table_view<uint32_t>::carve(arena, sets, ways);
+        last_offset = table_view<uint32_t>::carve(arena, sets, ways);
+        sig = table_view<uint32_t>::carve(arena, sets, ways);
+        lru = table_view<uint32_t>::carve(arena, sets, ways);
+    }
 
-    SIGNATURE_TABLE() {
+    void init() {
         cout << "Initialize SIGNATURE TABLE" << endl;
-        cout << "ST_SET: " << ST_SET << endl;
-        cout << "ST_WAY: " << ST_WAY << endl;
+        cout << "ST_SET: " << sets << endl;
+        cout << "ST_WAY: " << ways << endl;
         cout << "ST_TAG_BIT: " << ST_TAG_BIT << endl;
         cout << "ST_TAG_MASK: " << hex << ST_TAG_MASK << dec << endl;
 
-        for (uint32_t set = 0; set < ST_SET; set++)
-            for (uint32_t way = 0; way < ST_WAY; way++) {
+        for (uint32_t set = 0; set < sets; set++)
+            for (uint32_t way = 0; way < ways; way++) {
                 valid[set][way] = 0;
                 tag[set][way] = 0;
                 last_offset[set][way] = 0;
@@ -98,24 +143,33 @@ class SIGNATURE_TABLE {
             }
     };
 
-    void read_and_update_sig(uint64_t page, uint32_t page_offset, uint32_t &last_sig, uint32_t &curr_sig, int32_t &delta);
+    void read_and_update_sig(uint64_t page, uint32_t page_offset, uint32_t &last_sig, uint32_t &curr_sig, int32_t &delta, GLOBAL_REGISTER &GHR);
 };
 
 class PATTERN_TABLE {
   public:
-    int      delta[PT_SET][PT_WAY];
-    uint32_t c_delta[PT_SET][PT_WAY],
-             c_sig[PT_SET];
+    uint32_t sets;
+    table_view<int> delta;
+    table_view<uint32_t> c_delta;
+    uint32_t *c_sig;
 
-    PATTERN_TABLE() {
+    void bind(table_arena &arena, const SPP_PPF_GEOMETRY &geometry) {
+        sets = geometry.pt_set;
+
+        delta = table_view<int>::carve(arena, sets, PT_WAY);
+        c_delta = table_view<uint32_t>::carve(arena, sets, PT_WAY);
+        c_sig = arena.carve<uint32_t>(sets);
+    }
+
+    void init() {
         cout << endl << "Initialize PATTERN TABLE" << endl;
-        cout << "PT_SET: " << PT_SET << endl;
+        cout << "PT_SET: " << sets << endl;
         cout << "PT_WAY: " << PT_WAY << endl;
         cout << "SIG_DELTA_BIT: " << SIG_DELTA_BIT << endl;
         cout << "C_SIG_BIT: " << C_SIG_BIT << endl;
         cout << "C_DELTA_BIT: " << C_DELTA_BIT << endl;
 
-        for (uint32_t set = 0; set < PT_SET; set++) {
+        for (uint32_t set = 0; set < sets; set++) {
             for (uint32_t way = 0; way < PT_WAY; way++) {
                 delta[set][way] = 0;
                 c_delta[set][way] = 0;
@@ -125,39 +179,44 @@ class PATTERN_TABLE {
     }
 
     void update_pattern(uint32_t last_sig, int curr_delta),
-         read_pattern(uint32_t curr_sig, int *prefetch_delta, uint32_t *confidence_q, int32_t *perc_sum_q, uint32_t &lookahead_way, uint32_t &lookahead_conf, uint32_t &pf_q_tail, uint32_t &depth, uint64_t addr, uint64_t base_addr, uint64_t train_addr, uint64_t curr_ip, int32_t train_delta, uint32_t last_sig, uint32_t pq_occupancy, uint32_t pq_SIZE, uint32_t mshr_occupancy, uint32_t mshr_SIZE);
+         read_pattern(uint32_t curr_sig, int *prefetch_delta, uint32_t *confidence_q, int32_t *perc_sum_q, uint32_t &lookahead_way, uint32_t &lookahead_conf, uint32_t &pf_q_tail, uint32_t &depth, uint64_t addr, uint64_t base_addr, uint64_t train_addr, uint64_t curr_ip, int32_t train_delta, uint32_t last_sig, uint32_t pq_occupancy, uint32_t pq_SIZE, uint32_t mshr_occupancy, uint32_t mshr_SIZE, GLOBAL_REGISTER &GHR, PREFETCH_FILTER &FILTER, PERCEPTRON &PERC);
 };
 
 class PREFETCH_FILTER {
   public:
-    uint64_t remainder_tag[FILTER_SET],
-			 pc[FILTER_SET],
-			 pc_1[FILTER_SET],
-			 pc_2[FILTER_SET],
-			 pc_3[FILTER_SET],
-			 address[FILTER_SET];
-    bool     valid[FILTER_SET],  // Consider this as "prefetched"
-             useful[FILTER_SET]; // Consider this as "used"
-	int32_t	 delta[FILTER_SET],
-			 perc_sum[FILTER_SET];
-	uint32_t last_signature[FILTER_SET],
-			 confidence[FILTER_SET],
-			 cur_signature[FILTER_SET],
-			 la_depth[FILTER_SET];
-
-	uint64_t remainder_tag_reject[FILTER_SET_REJ],
-			 pc_reject[FILTER_SET_REJ],
-			 pc_1_reject[FILTER_SET_REJ],
-			 pc_2_reject[FILTER_SET_REJ],
-			 pc_3_reject[FILTER_SET_REJ],
-			 address_reject[FILTER_SET_REJ];
-	bool 	 valid_reject[FILTER_SET_REJ]; // Entries which the perceptron rejected
-	int32_t	 delta_reject[FILTER_SET_REJ],
-			 perc_sum_reject[FILTER_SET_REJ];
-	uint32_t last_signature_reject[FILTER_SET_REJ],
-			 confidence_reject[FILTER_SET_REJ],
-			 cur_signature_reject[FILTER_SET_REJ],
-		     la_depth_reject[FILTER_SET_REJ];
+	uint32_t quotient_bit,
+			 remainder_bit,
+			 quotient_bit_rej,
+			 remainder_bit_rej;
+
+    uint64_t *remainder_tag,
+			 *pc,
+			 *pc_1,
+			 *pc_2,
+			 *pc_3,
+			 *address;
+    bool     *valid,  // Consider this as "prefetched"
+             *useful; // Consider this as "used"
+	int32_t	 *delta,
+			 *perc_sum;
+	uint32_t *last_signature,
+			 *confidence,
+			 *cur_signature,
+			 *la_depth;
+
+	uint64_t *remainder_tag_reject,
+			 *pc_reject,
+			 *pc_1_reject,
+			 *pc_2_reject,
+			 *pc_3_reject,
+			 *address_reject;
+	bool 	 *valid_reject; // Entries which the perceptron rejected
+	int32_t	 *delta_reject,
+			 *perc_sum_reject;
+	uint32_t *last_signature_reject,
+			 *confidence_reject,
+			 *cur_signature_reject,
+		     *la_depth_reject;
 
 	// Tried the set-dueling idea which din't work out
 	uint32_t PSEL_1;
@@ -170,67 +229,103 @@ class PREFETCH_FILTER {
 	float hist_hits[55];
 	float hist_tots[55];
 
-    PREFETCH_FILTER() {
+	void bind(table_arena &arena, const SPP_PPF_GEOMETRY &geometry) {
+		uint32_t sets = 1 << geometry.quotient_bit,
+				 sets_reject = 1 << geometry.quotient_bit_rej;
+
+		quotient_bit = geometry.quotient_bit;
+		remainder_bit = geometry.remainder_bit;
+		quotient_bit_rej = geometry.quotient_bit_rej;
+		remainder_bit_rej = geometry.remainder_bit_rej;
+
+		remainder_tag = arena.carve<uint64_t>(sets);
+		pc = arena.carve<uint64_t>(sets);
+		pc_1 = arena.carve<uint64_t>(sets);
+		pc_2 = arena.carve<uint64_t>(sets);
+		pc_3 = arena.carve<uint64_t>(sets);
+		address = arena.carve<uint64_t>(sets);
+		valid = arena.carve<bool>(sets);
+		useful = arena.carve<bool>(sets);
+		delta = arena.carve<int32_t>(sets);
+		perc_sum = arena.carve<int32_t>(sets);
+		last_signature = arena.carve<uint32_t>(sets);
+		confidence = arena.carve<uint32_t>(sets);
+		cur_signature = arena.carve<uint32_t>(sets);
+		la_depth = arena.carve<uint32_t>(sets);
+
+		remainder_tag_reject = arena.carve<uint64_t>(sets_reject);
+		pc_reject = arena.carve<uint64_t>(sets_reject);
+		pc_1_reject = arena.carve<uint64_t>(sets_reject);
+		pc_2_reject = arena.carve<uint64_t>(sets_reject);
+		pc_3_reject = arena.carve<uint64_t>(sets_reject);
+		address_reject = arena.carve<uint64_t>(sets_reject);
+		valid_reject = arena.carve<bool>(sets_reject);
+		delta_reject = arena.carve<int32_t>(sets_reject);
+		perc_sum_reject = arena.carve<int32_t>(sets_reject);
+		last_signature_reject = arena.carve<uint32_t>(sets_reject);
+		confidence_reject = arena.carve<uint32_t>(sets_reject);
+		cur_signature_reject = arena.carve<uint32_t>(sets_reject);
+		la_depth_reject = arena.carve<uint32_t>(sets_reject);
+	}
+
+    void init() {
         cout << endl << "Initialize PREFETCH FILTER" << endl;
-        cout << "FILTER_SET: " << FILTER_SET << endl;
+        cout << "FILTER_SET: " << (1 << quotient_bit) << endl;
 
 		for (int i = 0; i < 55; i++) {
 			hist_hits[i] = 0;
 			hist_tots[i] = 0;
 		}
-        for (uint32_t set = 0; set < FILTER_SET; set++) {
-        	remainder_tag[set] = 0;
-        	valid[set] = 0;
-        	useful[set] = 0;
-		}
-        for (uint32_t set = 0; set < FILTER_SET_REJ; set++) {
-        	valid_reject[set] = 0;
-        	remainder_tag_reject[set] = 0;
-		}
+		// The remaining tables come zero-filled from the arena
+		PSEL_1 = 0;
+		PSEL_2 = 0;
 		train_neg = 0;
     }
 
-    bool     check(uint64_t pf_addr, uint64_t base_addr, uint64_t ip, FILTER_REQUEST filter_request, int32_t cur_delta, uint32_t last_sign, uint32_t cur_sign, uint32_t confidence, int32_t sum, uint32_t depth);
-    bool     add_to_filter(uint64_t check_addr, uint64_t base_addr, uint64_t ip, FILTER_REQUEST filter_request, int cur_delta, uint32_t last_sig, uint32_t curr_sig, uint32_t conf, int32_t sum, uint32_t depth);
+    bool     check(uint64_t pf_addr, uint64_t base_addr, uint64_t ip, FILTER_REQUEST filter_request, int32_t cur_delta, uint32_t last_sign, uint32_t cur_sign, uint32_t confidence, int32_t sum, uint32_t depth, GLOBAL_REGISTER &GHR, PERCEPTRON &PERC);
+    bool     add_to_filter(uint64_t check_addr, uint64_t base_addr, uint64_t ip, FILTER_REQUEST filter_request, int cur_delta, uint32_t last_sig, uint32_t curr_sig, uint32_t conf, int32_t sum, uint32_t depth, GLOBAL_REGISTER &GHR);
 
 };
 
 class PERCEPTRON {
   public:
-	// Perc Weights
-	int32_t perc_weights[PERC_ENTRIES][PERC_FEATURES];
+	// Perc Weights, packed feature after feature in a single cache-aligned
+	// array: the table of feature i starts at PERC_OFFSET[i] and 5-bit
+	// counters fit in a byte
+	int8_t  *perc_weights;
 
 	// Only for dumping csv
-	bool    perc_touched[PERC_ENTRIES][PERC_FEATURES];
+	bool    *perc_touched;
 
 	// CONST depths for different features
 	int32_t PERC_DEPTH[PERC_FEATURES];
+	uint32_t PERC_OFFSET[PERC_FEATURES];
 
-	PERCEPTRON() {
-		cout << "\nInitialize PERCEPTRON" << endl;
-		cout << "PERC_ENTRIES: " << PERC_ENTRIES << endl;
-		cout << "PERC_FEATURES: " << PERC_FEATURES << endl;
+	void bind(table_arena &arena, const SPP_PPF_GEOMETRY &geometry) {
+		uint32_t entries = 0;
 
-		PERC_DEPTH[0] = 2048;   //base_addr;
-		PERC_DEPTH[1] = 4096;   //cache_line;
-		PERC_DEPTH[2] = 4096;  	//page_addr;
-		PERC_DEPTH[3] = 4096;   //confidence ^ page_addr;
-		PERC_DEPTH[4] = 1024;	//curr_sig ^ sig_delta;
-		PERC_DEPTH[5] = 4096; 	//ip_1 ^ ip_2 ^ ip_3;		
-		PERC_DEPTH[6] = 1024; 	//ip ^ depth;
-		PERC_DEPTH[7] = 2048;   //ip ^ sig_delta;
-		PERC_DEPTH[8] = 128;   	//confidence;
-
-		for (int i = 0; i < PERC_ENTRIES; i++) {
-			for (int j = 0;j < PERC_FEATURES; j++) {
-				perc_weights[i][j] = 0;
-				perc_touched[i][j] = 0;
-			}
+		for (int i = 0; i < PERC_FEATURES; i++) {
+			PERC_DEPTH[i] = geometry.perc_depth[i];
+			PERC_OFFSET[i] = entries;
+			entries += PERC_DEPTH[i];
 		}
+
+		perc_weights = arena.carve<int8_t>(entries);
+		perc_touched = arena.carve<bool>(entries);
 	}
 
+	void init() {
+		cout << "\nInitialize PERCEPTRON" << endl;
+		cout << "PERC_ENTRIES: " << (PERC_OFFSET[PERC_FEATURES - 1] + PERC_DEPTH[PERC_FEATURES - 1]) << endl;
+		cout << "PERC_FEATURES: " << PERC_FEATURES << endl;
+		// The weights come zero-filled from the arena
+	}
+
+	void	 get_perc_index(uint64_t base_addr, uint64_t ip, uint64_t ip_1, uint64_t ip_2, uint64_t ip_3, int32_t cur_delta, uint32_t last_sig, uint32_t curr_sig, uint32_t confidence, uint32_t depth, uint64_t perc_set[PERC_FEATURES]);
 	void	 perc_update(uint64_t check_addr, uint64_t ip, uint64_t ip_1, uint64_t ip_2, uint64_t ip_3, int32_t cur_delta, uint32_t last_sig, uint32_t curr_sig, uint32_t confidence, uint32_t depth, bool direction, int32_t perc_sum);
 	int32_t	perc_predict(uint64_t check_addr, uint64_t ip, uint64_t ip_1, uint64_t ip_2, uint64_t ip_3, int32_t cur_delta, uint32_t last_sig, uint32_t curr_sig, uint32_t confidence, uint32_t depth);
+	// Sums of count candidates sharing the same address, IPs and depth
+	void	 perc_predict(uint64_t check_addr, uint64_t ip, uint64_t ip_1, uint64_t ip_2, uint64_t ip_3, const int32_t *cur_delta, uint32_t last_sig, uint32_t curr_sig, const uint32_t *confidence, uint32_t depth, uint32_t count, int32_t *perc_sum);
 };
 
 
@@ -289,6 +384,8 @@ class GLOBAL_REGISTER {
 		perc_reject = 0;
 		reject_update = 0;
 
+        for (uint32_t i = 0; i < PAGES_TRACKED; i++) page_tracker[i] = 0;
+
         for (uint32_t i = 0; i < MAX_GHR_ENTRY; i++) {
             valid[i] = 0;
             sig[i] = 0;
@@ -302,11 +399,5 @@ class GLOBAL_REGISTER {
     uint32_t check_entry(uint32_t page_offset);
 };
 
-static SIGNATURE_TABLE ST;
-static PATTERN_TABLE   PT;
-static PREFETCH_FILTER FILTER;
-static GLOBAL_REGISTER GHR;
-static PERCEPTRON PERC;
-
 
 #endif
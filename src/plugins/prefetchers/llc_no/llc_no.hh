@@ -15,7 +15,7 @@ namespace champsim {
         /**
          * @brief An implementation of a LLC prefetcher that does nothing.
          */
-		class llc_no_prefetcher : public iprefetcher {
+		class llc_no_prefetcher final : public iprefetcher {
 		public:
 			virtual ~llc_no_prefetcher ();
 
@@ -35,7 +35,6 @@ namespace champsim {
 }
 
 // Exporting the symbol used for module loading.
-BOOST_DLL_ALIAS(
-	champsim::prefetchers::llc_no_prefetcher::create_prefetcher,
-	create_prefetcher
+CHAMPSIM_PREFETCHER_ALIAS(
+	champsim::prefetchers::llc_no_prefetcher::create_prefetcher
 )
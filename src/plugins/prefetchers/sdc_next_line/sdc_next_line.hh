@@ -15,7 +15,7 @@ namespace champsim {
         /**
          * @brief An implementation of a next line SDC prefetcher.
          */
-		class sdc_next_line_prefetcher : public iprefetcher {
+		class sdc_next_line_prefetcher final : public iprefetcher {
 		public:
 			virtual ~sdc_next_line_prefetcher ();
 
@@ -35,7 +35,6 @@ namespace champsim {
 }
 
 // Exporting the symbol used for module loading.
-BOOST_DLL_ALIAS(
-	champsim::prefetchers::sdc_next_line_prefetcher::create_prefetcher,
-	create_prefetcher
+CHAMPSIM_PREFETCHER_ALIAS(
+	champsim::prefetchers::sdc_next_line_prefetcher::create_prefetcher
 )
@@ -16,7 +16,7 @@ namespace champsim {
 	/**
      * @brief An implementation of a L1D prefetcher that does nothing.
      */
-    class l1d_lru_replacement_policy : public ireplacementpolicy {
+    class l1d_lru_replacement_policy final : public ireplacementpolicy {
 		public:
 			l1d_lru_replacement_policy ();
 			virtual ~l1d_lru_replacement_policy ();
@@ -38,9 +38,8 @@ namespace champsim {
 		};
 
     // Exporting the symbol used for module loading.
-		BOOST_DLL_ALIAS(
-			champsim::replacements::l1d_lru_replacement_policy::create_replacementpolicy,
-			create_replacementpolicy
+		CHAMPSIM_REPLACEMENTPOLICY_ALIAS(
+			champsim::replacements::l1d_lru_replacement_policy::create_replacementpolicy
 		)
 	}
 }
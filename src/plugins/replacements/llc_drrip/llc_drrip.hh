@@ -16,7 +16,7 @@ namespace champsim {
 	/**
      * @brief An implementation of a L1D prefetcher that does nothing.
      */
-    class llc_drrip_replacement_policy : public ireplacementpolicy {
+    class llc_drrip_replacement_policy final : public ireplacementpolicy {
 		public:
 			llc_drrip_replacement_policy ();
 			virtual ~llc_drrip_replacement_policy ();
@@ -34,9 +34,8 @@ namespace champsim {
 		};
 
     // Exporting the symbol used for module loading.
-		BOOST_DLL_ALIAS(
-			champsim::replacements::llc_drrip_replacement_policy::create_replacementpolicy,
-			create_replacementpolicy
+		CHAMPSIM_REPLACEMENTPOLICY_ALIAS(
+			champsim::replacements::llc_drrip_replacement_policy::create_replacementpolicy
 		)
 	}
 }
@@ -21,7 +21,7 @@ namespace champsim {
 	/**
      * @brief An implementation of a L1D prefetcher that does nothing.
      */
-    	class llc_topt_replacement_policy : public ireplacementpolicy {
+    	class llc_topt_replacement_policy final : public ireplacementpolicy {
 		public:
 			using reuse_distance_pair = std::pair<uint64_t, uint64_t>;
 			using reuse_distance_vector = std::vector<reuse_distance_pair>;
@@ -57,9 +57,8 @@ namespace champsim {
 		};
 
 		// Exporting the symbol used for module loading.
-		BOOST_DLL_ALIAS(
-			champsim::replacements::llc_topt_replacement_policy::create_replacementpolicy,
-			create_replacementpolicy
+		CHAMPSIM_REPLACEMENTPOLICY_ALIAS(
+			champsim::replacements::llc_topt_replacement_policy::create_replacementpolicy
 		)
 	}
 }
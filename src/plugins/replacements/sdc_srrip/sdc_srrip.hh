@@ -16,7 +16,7 @@ namespace champsim {
 	/**
      * @brief An implementation of a L1D prefetcher that does nothing.
      */
-    class sdc_srrip_replacement_policy : public ireplacementpolicy {
+    class sdc_srrip_replacement_policy final : public ireplacementpolicy {
 		public:
 			sdc_srrip_replacement_policy ();
 			virtual ~sdc_srrip_replacement_policy ();
@@ -38,9 +38,8 @@ namespace champsim {
 		};
 
     // Exporting the symbol used for module loading.
-		BOOST_DLL_ALIAS(
-			champsim::replacements::sdc_srrip_replacement_policy::create_replacementpolicy,
-			create_replacementpolicy
+		CHAMPSIM_REPLACEMENTPOLICY_ALIAS(
+			champsim::replacements::sdc_srrip_replacement_policy::create_replacementpolicy
 		)
 	}
 }
@@ -6,6 +6,7 @@
 
 #include <fstream>
 #
+#include <internals/host_profiler.hh>
 #include <internals/simulator.hh>
 #
 #include <internals/components/sectored_cache.hh>
@@ -198,7 +199,7 @@ void print_branch_stats() {
 void print_dram_stats() {
     cout << endl;
     cout << "DRAM Statistics" << endl;
-    for (uint32_t i = 0; i < DRAM_CHANNELS; i++) {
+    for (uint32_t i = 0; i < uncore.DRAM.channels; i++) {
         cout << " CHANNEL " << i << endl;
         cout << " RQ ROW_BUFFER_HIT: " << setw(10)
              << uncore.DRAM.RQ[i].ROW_BUFFER_HIT
@@ -211,11 +212,34 @@ void print_dram_stats() {
              << "  ROW_BUFFER_MISS: " << setw(10)
              << uncore.DRAM.WQ[i].ROW_BUFFER_MISS;
         cout << "  FULL: " << setw(10) << uncore.DRAM.WQ[i].FULL << endl;
+        if (uncore.DRAM.desc.detailed_timing)
+            cout << " REFRESHES: " << setw(10) << uncore.DRAM.refreshes[i]
+                 << endl;
+
+        // per-bank queue depth seen by arriving requests, as depth:count
+        for (uint32_t r = 0; r < uncore.DRAM.desc.ranks; r++) {
+            for (uint32_t b = 0; b < uncore.DRAM.desc.banks; b++) {
+                cout << " RANK " << r << " BANK " << setw(2) << b
+                     << " RQ DEPTH:";
+                for (uint32_t d = 0; d <= uncore.DRAM.RQ_banks[i].size; d++) {
+                    if (uncore.DRAM.RQ_banks[i].depth(r, b, d))
+                        cout << " " << d << ":"
+                             << uncore.DRAM.RQ_banks[i].depth(r, b, d);
+                }
+                cout << "  WQ DEPTH:";
+                for (uint32_t d = 0; d <= uncore.DRAM.WQ_banks[i].size; d++) {
+                    if (uncore.DRAM.WQ_banks[i].depth(r, b, d))
+                        cout << " " << d << ":"
+                             << uncore.DRAM.WQ_banks[i].depth(r, b, d);
+                }
+                cout << endl;
+            }
+        }
         cout << endl;
     }
 
     uint64_t total_congested_cycle = 0;
-    for (uint32_t i = 0; i < DRAM_CHANNELS; i++)
+    for (uint32_t i = 0; i < uncore.DRAM.channels; i++)
         total_congested_cycle += uncore.DRAM.dbus_cycle_congested[i];
     if (uncore.DRAM.dbus_congested[NUM_TYPES][NUM_TYPES])
         cout << " AVG_CONGESTED_CYCLE: "
@@ -248,26 +272,34 @@ void finish_warmup() {
     for (int i = 0; i < simulator->descriptor().cpus.size(); i++) {
         O3_CPU* curr_cpu = simulator->modeled_cpu(i);
 
-        curr_cpu->STLB.pte_usages.clear();
-        curr_cpu->STLB.stlb_prediction_accurate.clear();
+        if (curr_cpu->STLB) {
+            curr_cpu->STLB->pte_usages.clear();
+            curr_cpu->STLB->stlb_prediction_accurate.clear();
 
-        curr_cpu->STLB.doa = 0;
-        curr_cpu->STLB.no_doa = 0;
+            curr_cpu->STLB->doa = 0;
+            curr_cpu->STLB->no_doa = 0;
 
-        curr_cpu->STLB.pte_used_onchip = 0;
-        curr_cpu->STLB.pte_used_offchip = 0;
-        curr_cpu->STLB.pte_unused_offchip = 0;
-        curr_cpu->STLB.pte_unused_onchip = 0;
+            curr_cpu->STLB->pte_used_onchip = 0;
+            curr_cpu->STLB->pte_used_offchip = 0;
+            curr_cpu->STLB->pte_unused_offchip = 0;
+            curr_cpu->STLB->pte_unused_onchip = 0;
+        }
 
         curr_cpu->offchip_pred->reset_stats();
+
+        if (curr_cpu->tlb) curr_cpu->tlb->reset_stats();
+
         curr_cpu->_mm.pbp().clear_stats();
 
         // reset DRAM stats
-        for (uint32_t i = 0; i < DRAM_CHANNELS; i++) {
+        for (uint32_t i = 0; i < uncore.DRAM.channels; i++) {
             uncore.DRAM.RQ[i].ROW_BUFFER_HIT = 0;
             uncore.DRAM.RQ[i].ROW_BUFFER_MISS = 0;
             uncore.DRAM.WQ[i].ROW_BUFFER_HIT = 0;
             uncore.DRAM.WQ[i].ROW_BUFFER_MISS = 0;
+            uncore.DRAM.RQ_banks[i].reset_stats();
+            uncore.DRAM.WQ_banks[i].reset_stats();
+            uncore.DRAM.refreshes[i] = 0;
         }
     }
 
@@ -367,28 +399,15 @@ int main(int argc, char** argv) {
     // endl;
     cout << "Number of CPUs: " << NUM_CPUS << endl;
 
-    if (helper::knob_low_bandwidth)
-        DRAM_MTPS = DRAM_IO_FREQ / 4;
-    else
-        DRAM_MTPS = DRAM_IO_FREQ;
-
-    // DRAM access latency
-    tRP = (uint32_t)((1.0 * tRP_DRAM_NANOSECONDS * CPU_FREQ) / 1000);
-    tRCD = (uint32_t)((1.0 * tRCD_DRAM_NANOSECONDS * CPU_FREQ) / 1000);
-    tCAS = (uint32_t)((1.0 * tCAS_DRAM_NANOSECONDS * CPU_FREQ) / 1000);
-
-    // default: 16 = (64 / 8) * (3200 / 1600)
-    // it takes 16 CPU cycles to tranfser 64B cache block on a 8B (64-bit) bus
-    // note that dram burst length = BLOCK_SIZE/DRAM_CHANNEL_WIDTH
-    DRAM_DBUS_RETURN_TIME =
-        (uint32_t)std::ceil((float)(BLOCK_SIZE / DRAM_CHANNEL_WIDTH) *
-                            ((float)CPU_FREQ / (float)DRAM_MTPS));
+    // DRAM organization, timing and bus rate
+    uncore.DRAM.configure(simulator->descriptor().dram);
 
     std::cout
         << (boost::format(
                 "Off-chip DRAM Size: %u MB, Channels: %u, "
                 "Width %u-bits, Data Rate: %u MT/s, Return time: %u cycles") %
-            DRAM_SIZE % DRAM_CHANNELS % (8 * DRAM_CHANNEL_WIDTH) % DRAM_MTPS %
+            uncore.DRAM.desc.size_mb() % uncore.DRAM.channels %
+            (8 * uncore.DRAM.channel_width) % DRAM_MTPS %
             DRAM_DBUS_RETURN_TIME)
         << std::endl;
 
@@ -498,27 +517,29 @@ int main(int argc, char** argv) {
         curr_cpu->initialize_branch_predictor();
 
         // TLBs
-        curr_cpu->ITLB.cpu = i;
-        curr_cpu->ITLB.cache_type = IS_ITLB;
-        curr_cpu->ITLB.MAX_READ = 2;
-        curr_cpu->ITLB.fill_level = FILL_L1;
-        curr_cpu->ITLB.lower_level = &curr_cpu->STLB;
-        curr_cpu->ITLB.LATENCY = ITLB_LATENCY;
-
-        curr_cpu->DTLB.cpu = i;
-        curr_cpu->DTLB.cache_type = IS_DTLB;
-        curr_cpu->DTLB.MAX_READ = 2;
-        curr_cpu->DTLB.fill_level = FILL_L1;
-        curr_cpu->DTLB.lower_level = &curr_cpu->STLB;
-        curr_cpu->DTLB.LATENCY = DTLB_LATENCY;
-
-        curr_cpu->STLB.cpu = i;
-        curr_cpu->STLB.cache_type = IS_STLB;
-        curr_cpu->STLB.MAX_READ = 1;
-        curr_cpu->STLB.fill_level = FILL_L2;
-        curr_cpu->STLB.upper_level_icache[i] = &curr_cpu->ITLB;
-        curr_cpu->STLB.upper_level_dcache[i] = &curr_cpu->DTLB;
-        curr_cpu->STLB.LATENCY = STLB_LATENCY;
+        if (curr_cpu->ITLB) {
+            curr_cpu->ITLB->cpu = i;
+            curr_cpu->ITLB->cache_type = IS_ITLB;
+            curr_cpu->ITLB->MAX_READ = 2;
+            curr_cpu->ITLB->fill_level = FILL_L1;
+            curr_cpu->ITLB->lower_level = curr_cpu->STLB.get();
+            curr_cpu->ITLB->LATENCY = ITLB_LATENCY;
+
+            curr_cpu->DTLB->cpu = i;
+            curr_cpu->DTLB->cache_type = IS_DTLB;
+            curr_cpu->DTLB->MAX_READ = 2;
+            curr_cpu->DTLB->fill_level = FILL_L1;
+            curr_cpu->DTLB->lower_level = curr_cpu->STLB.get();
+            curr_cpu->DTLB->LATENCY = DTLB_LATENCY;
+
+            curr_cpu->STLB->cpu = i;
+            curr_cpu->STLB->cache_type = IS_STLB;
+            curr_cpu->STLB->MAX_READ = 1;
+            curr_cpu->STLB->fill_level = FILL_L2;
+            curr_cpu->STLB->upper_level_icache[i] = curr_cpu->ITLB.get();
+            curr_cpu->STLB->upper_level_dcache[i] = curr_cpu->DTLB.get();
+            curr_cpu->STLB->LATENCY = STLB_LATENCY;
+        }
 
         curr_cpu->warmup_complete() = false;
         // all_warmup_complete = NUM_CPUS;
@@ -614,10 +635,6 @@ int main(int argc, char** argv) {
         uncore.DRAM._upper_level_dcache_new[i] = uncore.llc;
         uncore.DRAM._sdc = curr_cpu->sdc;
         uncore.DRAM.fill_level = FILL_DRAM;
-        for (uint32_t i = 0; i < DRAM_CHANNELS; i++) {
-            uncore.DRAM.RQ[i].is_RQ = 1;
-            uncore.DRAM.WQ[i].is_WQ = 1;
-        }
 
         // Setting the fill path policies.
         curr_cpu->fill_path_policy = new cpol::conservative_fill_path_policy(i);
@@ -635,6 +652,8 @@ int main(int argc, char** argv) {
     while (run_simulation) {
         for (int i = 0; i < simulator->descriptor().cpus.size(); i++) {
             O3_CPU* curr_cpu = simulator->modeled_cpu(i);
+            champsim::host_profiler::scope core_scope(
+                champsim::host_profiler::core);
 
             // proceed one cycle
             curr_cpu->inc_current_core_cycle();
@@ -749,9 +768,17 @@ int main(int argc, char** argv) {
                 run_simulation = 0;
         }
 
-        uncore.DRAM.operate();
+        {
+            champsim::host_profiler::scope dram_scope(
+                champsim::host_profiler::dram);
+            uncore.DRAM.operate();
+        }
         // uncore.dram->operate ();
-        uncore.llc->operate();
+        {
+            champsim::host_profiler::scope llc_scope(
+                champsim::host_profiler::llc);
+            uncore.llc->operate();
+        }
     }
 
     // uint64_t elapsed_second = (uint64_t)(time(NULL) - start_time),
@@ -761,6 +788,24 @@ int main(int argc, char** argv) {
     // elapsed_second -= (elapsed_hour*3600 + elapsed_minute*60);
 
     cout << endl << "ChampSim completed all CPUs" << endl;
+
+    if (champsim::host_profiler::enabled()) {
+        uint64_t retired = 0;
+
+        for (int i = 0; i < simulator->descriptor().cpus.size(); i++) {
+            retired += simulator->modeled_cpu(i)->num_retired;
+        }
+
+        champsim::host_profiler::dump(std::cout, retired);
+
+        std::cout << (boost::format("Host DRAM channel operates: %u skipped: %u "
+                                    "(%.1f%%)") %
+                      uncore.DRAM.channel_operates %
+                      uncore.DRAM.skipped_channel_operates %
+                      (100.0 * uncore.DRAM.skipped_channel_operates /
+                       std::max<uint64_t>(uncore.DRAM.channel_operates, 1)))
+                  << std::endl;
+    }
     if (simulator->descriptor().cpus.size() > 1) {
         cout << endl
              << "Total Simulation Statistics (not including warmup)" << endl;
@@ -810,40 +855,43 @@ int main(int argc, char** argv) {
         curr_cpu->l2c->report(std::cout, i);
         curr_cpu->sdc->report(std::cout, i);
 
-        record_roi_stats(i, &curr_cpu->ITLB);
-        record_roi_stats(i, &curr_cpu->DTLB);
-        record_roi_stats(i, &curr_cpu->STLB);
-
-        print_roi_stats(i, &curr_cpu->ITLB);
-        print_roi_stats(i, &curr_cpu->DTLB);
-        print_roi_stats(i, &curr_cpu->STLB);
-
-        uint64_t irreg_doa = std::count_if(
-                     curr_cpu->STLB.pte_usages.begin(),
-                     curr_cpu->STLB.pte_usages.end(),
-                     [](const auto& e) { return (!e.first && e.second); }),
-                 irreg_alive = std::count_if(
-                     curr_cpu->STLB.pte_usages.begin(),
-                     curr_cpu->STLB.pte_usages.end(),
-                     [](const auto& e) { return (e.first && e.second); }),
-                 reg_doa = std::count_if(
-                     curr_cpu->STLB.pte_usages.begin(),
-                     curr_cpu->STLB.pte_usages.end(),
-                     [](const auto& e) { return (!e.first && !e.second); }),
-                 reg_alive = std::count_if(
-                     curr_cpu->STLB.pte_usages.begin(),
-                     curr_cpu->STLB.pte_usages.end(),
-                     [](const auto& e) { return (e.first && !e.second); });
-
-        std::cout << "pte_used/onchip_pred: " << curr_cpu->STLB.pte_used_onchip
-                  << std::endl
-                  << "pte_used/offchip_pred: "
-                  << curr_cpu->STLB.pte_used_offchip << std::endl
-                  << "pte_unused/onchip_pred: "
-                  << curr_cpu->STLB.pte_unused_onchip << std::endl
-                  << "pte_unused/offchip_pred: "
-                  << curr_cpu->STLB.pte_unused_offchip << std::endl
-                  << std::endl;
+        if (curr_cpu->tlb) {
+            curr_cpu->tlb->dump_stats(std::cout);
+            std::cout << std::endl;
+        } else {
+            CACHE& stlb = *curr_cpu->STLB;
+
+            record_roi_stats(i, curr_cpu->ITLB.get());
+            record_roi_stats(i, curr_cpu->DTLB.get());
+            record_roi_stats(i, curr_cpu->STLB.get());
+
+            print_roi_stats(i, curr_cpu->ITLB.get());
+            print_roi_stats(i, curr_cpu->DTLB.get());
+            print_roi_stats(i, curr_cpu->STLB.get());
+
+            uint64_t irreg_doa = std::count_if(
+                         stlb.pte_usages.begin(), stlb.pte_usages.end(),
+                         [](const auto& e) { return (!e.first && e.second); }),
+                     irreg_alive = std::count_if(
+                         stlb.pte_usages.begin(), stlb.pte_usages.end(),
+                         [](const auto& e) { return (e.first && e.second); }),
+                     reg_doa = std::count_if(
+                         stlb.pte_usages.begin(), stlb.pte_usages.end(),
+                         [](const auto& e) { return (!e.first && !e.second); }),
+                     reg_alive = std::count_if(
+                         stlb.pte_usages.begin(), stlb.pte_usages.end(),
+                         [](const auto& e) { return (e.first && !e.second); });
+
+            std::cout << "pte_used/onchip_pred: " << stlb.pte_used_onchip
+                      << std::endl
+                      << "pte_used/offchip_pred: " << stlb.pte_used_offchip
+                      << std::endl
+                      << "pte_unused/onchip_pred: " << stlb.pte_unused_onchip
+                      << std::endl
+                      << "pte_unused/offchip_pred: "
+                      << stlb.pte_unused_offchip << std::endl
+                      << std::endl;
+        }
 
         curr_cpu->offchip_pred->dump_stats();
         curr_cpu->_mm.pbp().dump_stats();
@@ -860,6 +908,9 @@ int main(int argc, char** argv) {
     print_dram_stats();
     print_branch_stats();
 
+    // Flushing the records still buffered for the DRAM memory trace.
+    uncore.DRAM._memory_trace.close();
+
     champsim::simulator::destroy();
 
     return 0;
@@ -0,0 +1,100 @@
+#include <cstdint>
+#
+#include <iostream>
+#include <map>
+#include <string>
+#
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#
+#include <internals/dram_trace.hh>
+
+namespace po = boost::program_options;
+using boost::format;
+using champsim::dram_trace_record;
+
+static std::string dram_trace;
+static bool summary = false;
+
+void initialize_program_options (po::options_description& desc) {
+	desc.add_options ()
+		("help", "Produce an help message and quit.")
+		("in_trace", po::value<std::string> (&dram_trace), "The DRAM memory trace to decode (.memorytrace or .memorytrace.zst).")
+		("summary", po::bool_switch (&summary), "Only print aggregated statistics on the trace.");
+}
+
+void parse_program_options (const po::options_description& desc, int argc, const char** argv) {
+	po::variables_map vm;
+
+	po::store (po::parse_command_line (argc, argv, desc), vm);
+	po::notify (vm);
+
+	if (vm.count ("help")) {
+		std::cout << desc << std::endl;
+		std::exit (0);
+	}
+
+	if (!vm.count ("in_trace")) {
+		throw std::runtime_error ("[ERROR] No input trace provided.");
+	}
+}
+
+void print_record (const dram_trace_record& rec) {
+	std::cout << format ("%#x %c cycle: %d cpu: %d type: %d fill_level: %d offchip_pred: %d l1d_offchip_pred_used: %d pf_offchip_pred: %d pf_offchip: %d")
+		% rec.address
+		% ((rec.flags & dram_trace_record::write) ? 'W' : 'R')
+		% rec.cycle
+		% (uint32_t) rec.cpu
+		% (uint32_t) rec.type
+		% (int32_t) (int8_t) rec.fill_level
+		% ((rec.flags & dram_trace_record::went_offchip_pred) != 0)
+		% ((rec.flags & dram_trace_record::l1d_offchip_pred_used) != 0)
+		% ((rec.flags & dram_trace_record::pf_went_offchip_pred) != 0)
+		% ((rec.flags & dram_trace_record::pf_went_offchip) != 0)
+		<< std::endl;
+}
+
+int main (int argc, const char** argv) {
+	po::options_description prog_opt;
+	std::map<std::pair<uint32_t, uint32_t>, uint64_t> type_counts;
+	uint64_t records = 0,
+			 writes = 0,
+			 offchip_pred = 0,
+			 first_cycle = UINT64_MAX,
+			 last_cycle = 0;
+	dram_trace_record rec;
+
+	initialize_program_options (prog_opt);
+	parse_program_options (prog_opt, argc, argv);
+
+	champsim::dram_trace_reader reader (dram_trace);
+
+	while (reader.next (rec)) {
+		if (!summary) {
+			print_record (rec);
+			continue;
+		}
+
+		records++;
+		writes += ((rec.flags & dram_trace_record::write) != 0);
+		offchip_pred += ((rec.flags & dram_trace_record::went_offchip_pred) != 0);
+		type_counts[{rec.cpu, rec.type}]++;
+
+		first_cycle = std::min (first_cycle, rec.cycle);
+		last_cycle = std::max (last_cycle, rec.cycle);
+	}
+
+	if (summary) {
+		std::cout << format ("records: %d reads: %d writes: %d offchip_pred: %d") % records % (records - writes) % writes % offchip_pred << std::endl;
+
+		if (records) {
+			std::cout << format ("cycles: %d-%d") % first_cycle % last_cycle << std::endl;
+		}
+
+		for (const auto& e : type_counts) {
+			std::cout << format ("cpu: %d type: %d count: %d") % e.first.first % e.first.second % e.second << std::endl;
+		}
+	}
+
+	return 0;
+}